@@ -0,0 +1,140 @@
+#pragma once
+
+////////////////////////////////////////////////////////////////////////////////
+// The MIT License (MIT)
+//
+// Copyright (c) 2022 Nicholas Frechette
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+////////////////////////////////////////////////////////////////////////////////
+
+#include "acl-sjson/metadata.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace acl_sjson
+{
+	enum class compression_level_t
+	{
+		lowest,
+		low,
+		medium,
+		high,
+		highest,
+		automatic,
+	};
+
+	const char* to_string(compression_level_t level);
+
+	enum class error_metric_t
+	{
+		// Measures the error on the rotation/translation/scale of every transform
+		qvv,
+
+		// Measures the error on the 3x4 matrix of every transform
+		matrix3x4,
+	};
+
+	const char* to_string(error_metric_t metric);
+
+	//////////////////////////////////////////////////////////////////////////
+	// How keyframes are split between the importance tiers of a database.
+	// The high importance tier remains in the compressed clips, the medium and low importance
+	// tiers live in the database bulk data and can be streamed in and out independently.
+	struct database_settings_t
+	{
+		// The proportion of the movable keyframes moved to each tier, in [0.0, 1.0] with a sum of 1.0 at most
+		float medium_importance_tier_proportion = 0.5F;
+		float low_importance_tier_proportion = 0.25F;
+
+		// The largest unit of bulk data streamed at once, in bytes
+		uint32_t max_chunk_size = 1024 * 1024;
+	};
+
+	//////////////////////////////////////////////////////////////////////////
+	// Settings used to compress a clip with ACL, read from a *.config.sjson file.
+	struct compression_settings_t
+	{
+		// The name of the config file without its extension
+		std::string name;
+
+		compression_level_t level = compression_level_t::medium;
+
+		rotation_format_t rotation_format = rotation_format_t::quatf_drop_w_variable;
+		vector_format_t translation_format = vector_format_t::vector3f_variable;
+		vector_format_t scale_format = vector_format_t::vector3f_variable;
+
+		error_metric_t error_metric = error_metric_t::qvv;
+
+		// Whether the config streams part of the clip from a database
+		bool enable_database = false;
+		database_settings_t database;
+	};
+
+	//////////////////////////////////////////////////////////////////////////
+	// Reads compression settings from a *.config.sjson file.
+	// Keys are read in the order ACL config files use: version, algorithm_name, level, rotation_format,
+	// translation_format, scale_format, error_metric, enable_database_support, database, and
+	// regression_error_threshold. Keys that are missing keep their default value.
+	bool read_compression_settings(const char* filename, compression_settings_t& out_settings);
+
+	//////////////////////////////////////////////////////////////////////////
+	// Measurements gathered while compressing a clip.
+	struct compression_stats_t
+	{
+		size_t compressed_size = 0;
+
+		double compression_time_ms = 0.0;
+
+		// The time to decompress every sample of the clip once
+		double decompression_time_ms = 0.0;
+
+		// The largest error measured with the error metric of the settings
+		float max_error = 0.0F;
+		uint32_t max_error_track_index = 0;
+		float max_error_sample_time = 0.0F;
+	};
+
+	//////////////////////////////////////////////////////////////////////////
+	// Measurements gathered while building a database from a set of clips.
+	struct database_stats_t
+	{
+		size_t num_clips = 0;
+
+		// The compressed clips retain the high importance tier and are always resident
+		size_t clips_size = 0;
+
+		// The database without its bulk data, always resident once loaded
+		size_t database_size = 0;
+
+		// The bulk data of each tier, only resident once streamed in
+		size_t medium_tier_size = 0;
+		size_t low_tier_size = 0;
+
+		double compression_time_ms = 0.0;
+
+		// The largest error of every clip measured with the error metric of the settings
+		// as tiers are streamed out, least important first
+		float max_error_with_every_tier = 0.0F;
+		float max_error_without_low_tier = 0.0F;
+		float max_error_with_high_tier_only = 0.0F;
+	};
+}
@@ -0,0 +1,61 @@
+#pragma once
+
+////////////////////////////////////////////////////////////////////////////////
+// The MIT License (MIT)
+//
+// Copyright (c) 2022 Nicholas Frechette
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+////////////////////////////////////////////////////////////////////////////////
+
+#include <cstdint>
+
+namespace acl_sjson
+{
+	//////////////////////////////////////////////////////////////////////////
+	// The instruction sets the SIMD kernels are built for, from the least to the most capable.
+	enum class cpu_isa : uint32_t
+	{
+		// Portable C++, available everywhere
+		scalar,
+
+		sse2,
+		avx2,
+
+		// AVX-512 foundation instructions
+		avx512,
+	};
+
+	const char* to_string(cpu_isa isa);
+
+	//////////////////////////////////////////////////////////////////////////
+	// Returns the most capable instruction set supported by both the CPU and this build.
+	// The CPU is queried with CPUID once, an instruction set also requires the OS to save its registers.
+	cpu_isa get_supported_cpu_isa();
+
+	//////////////////////////////////////////////////////////////////////////
+	// Returns the instruction set used by the SIMD kernels, the supported one unless forced.
+	cpu_isa get_cpu_isa();
+
+	//////////////////////////////////////////////////////////////////////////
+	// Forces the SIMD kernels to use a specific instruction set, e.g. to compare them in benchmarks.
+	// Returns false if the instruction set isn't supported, the current one is retained.
+	// Kernels are selected when a loop starts, change it before starting work.
+	bool set_cpu_isa(cpu_isa isa);
+}
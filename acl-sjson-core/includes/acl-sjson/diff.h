@@ -0,0 +1,103 @@
+#pragma once
+
+////////////////////////////////////////////////////////////////////////////////
+// The MIT License (MIT)
+//
+// Copyright (c) 2022 Nicholas Frechette
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+////////////////////////////////////////////////////////////////////////////////
+
+#include "acl-sjson/sample.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace acl_sjson
+{
+	class track_array;
+
+	//////////////////////////////////////////////////////////////////////////
+	// Settings used to compare two clips.
+	struct diff_settings
+	{
+		// Values match when their absolute difference is within this tolerance
+		float absolute_tolerance = 0.0F;
+
+		// Values also match when their difference is within this tolerance scaled by their largest magnitude
+		float relative_tolerance = 0.0F;
+
+		// Stops at the first mismatch, useful when only a yes/no answer is needed
+		bool stop_on_first_mismatch = false;
+
+		// The maximum number of mismatching frames retained per track for reporting
+		uint32_t max_reported_frames = 16;
+	};
+
+	enum class track_diff_reason
+	{
+		// Some samples are not within tolerance
+		samples,
+
+		// The tracks have a different sample type and cannot be compared
+		sample_type,
+	};
+
+	//////////////////////////////////////////////////////////////////////////
+	// The differences found in a single track.
+	struct track_diff
+	{
+		uint32_t track_index = 0;
+		track_diff_reason reason = track_diff_reason::samples;
+
+		// The sample types of both tracks
+		sample_type lhs_type = sample_type::unknown;
+		sample_type rhs_type = sample_type::unknown;
+
+		// The number of frames where the samples are not within tolerance
+		uint32_t num_mismatched_frames = 0;
+
+		// The largest absolute difference between two values of the track
+		float max_error = 0.0F;
+
+		// The first mismatching frames, up to diff_settings::max_reported_frames
+		std::vector<uint32_t> frames;
+	};
+
+	//////////////////////////////////////////////////////////////////////////
+	// The differences found between two clips.
+	struct clip_diff
+	{
+		// Set when the clips cannot be compared track by track (e.g. different number of tracks)
+		std::string structure_mismatch;
+
+		// Every track that differs, sorted by track index
+		// With stop_on_first_mismatch, only the first mismatch found is retained
+		std::vector<track_diff> tracks;
+
+		bool is_equal() const { return structure_mismatch.empty() && tracks.empty(); }
+	};
+
+	//////////////////////////////////////////////////////////////////////////
+	// Compares the sample data of two clips track by track.
+	// Only samples are compared, track names and descriptions are ignored.
+	// Tracks are compared in parallel.
+	void diff_tracks(const track_array& lhs, const track_array& rhs, const diff_settings& settings, clip_diff& out_diff);
+}
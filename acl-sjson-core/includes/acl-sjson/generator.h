@@ -0,0 +1,63 @@
+#pragma once
+
+////////////////////////////////////////////////////////////////////////////////
+// The MIT License (MIT)
+//
+// Copyright (c) 2022 Nicholas Frechette
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+////////////////////////////////////////////////////////////////////////////////
+
+#include <cstdint>
+
+namespace acl_sjson
+{
+	class track_array;
+
+	//////////////////////////////////////////////////////////////////////////
+	// Settings used to generate a synthetic transform clip.
+	struct generator_settings
+	{
+		// The seed of the random number generator, the same seed always generates the same clip
+		uint64_t seed = 1;
+
+		// The number of bones (transform tracks) in the clip
+		uint32_t num_bones = 64;
+
+		// The maximum depth of the hierarchy, a depth of 1 has every bone at the root
+		uint32_t hierarchy_depth = 8;
+
+		// The number of samples per track
+		uint32_t num_samples = 300;
+
+		// The sample rate of every track
+		float sample_rate = 30.0F;
+
+		// The ratio of bones in [0.0, 1.0] that have every sample identical
+		float constant_bone_ratio = 0.25F;
+	};
+
+	//////////////////////////////////////////////////////////////////////////
+	// Generates a deterministic synthetic transform clip from the provided settings.
+	// Animated bones follow smooth periodic curves with random amplitudes, frequencies and phases.
+	// The output is identical on every platform with IEEE 754 float and double arithmetic for a given
+	// set of settings, trigonometry does not rely on the standard library.
+	// Returns false if the settings are invalid.
+	bool generate_clip(const generator_settings& settings, track_array& out_tracks);
+}
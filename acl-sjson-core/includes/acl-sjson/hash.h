@@ -0,0 +1,73 @@
+#pragma once
+
+////////////////////////////////////////////////////////////////////////////////
+// The MIT License (MIT)
+//
+// Copyright (c) 2022 Nicholas Frechette
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+////////////////////////////////////////////////////////////////////////////////
+
+#include <cstddef>
+#include <cstdint>
+
+namespace acl_sjson
+{
+	class track_array;
+
+	//////////////////////////////////////////////////////////////////////////
+	// A streaming 64 bit hasher that implements the XXH64 algorithm.
+	// Data can be provided in any number of chunks, the digest only depends on the byte stream.
+	// Multi-byte values are read in little endian order.
+	class hasher64
+	{
+	public:
+		explicit hasher64(uint64_t seed = 0);
+
+		// Appends data to the byte stream
+		void update(const void* data, size_t size);
+
+		// Returns the hash of every byte provided so far, more data can still be appended afterwards
+		uint64_t digest() const;
+
+	private:
+		uint64_t	m_accumulators[4];
+		uint64_t	m_seed;
+		uint64_t	m_total_size;
+
+		// Bytes that do not yet form a complete 32 byte stripe
+		uint8_t		m_buffer[32];
+		uint32_t	m_buffer_size;
+	};
+
+	//////////////////////////////////////////////////////////////////////////
+	// Returns the XXH64 hash of a buffer.
+	uint64_t hash64(const void* data, size_t size, uint64_t seed = 0);
+
+	//////////////////////////////////////////////////////////////////////////
+	// Returns a hash of the canonical content of a clip, independent of the container it came from.
+	// The same animation hashes the same whether it was read from SJSON or from a binary file of any version:
+	//    - Tracks are visited in output order and stripped tracks are skipped
+	//    - Parent indices are remapped to output indices
+	//    - Sample types, sample rate, and samples are included
+	//    - Names and track descriptions are excluded: readers reset some of them (e.g. ACL 2.0 has no default values)
+	//      and binary files without metadata keep default settings
+	// Tracks are hashed in parallel.
+	uint64_t hash_tracks(const track_array& tracks);
+}
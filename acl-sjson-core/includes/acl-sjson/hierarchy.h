@@ -0,0 +1,60 @@
+#pragma once
+
+////////////////////////////////////////////////////////////////////////////////
+// The MIT License (MIT)
+//
+// Copyright (c) 2022 Nicholas Frechette
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+////////////////////////////////////////////////////////////////////////////////
+
+#include <cstdint>
+#include <vector>
+
+namespace acl_sjson
+{
+	class track_array;
+
+	//////////////////////////////////////////////////////////////////////////
+	// How transform tracks are ordered so that every parent comes before its children.
+	// Children always retain their relative order.
+	enum class hierarchy_order
+	{
+		// From the roots down one depth at a time, siblings are next to each other
+		breadth_first,
+
+		// Every sub-tree is contiguous, children follow their parent
+		depth_first,
+	};
+
+	const char* to_string(hierarchy_order order);
+
+	//////////////////////////////////////////////////////////////////////////
+	// Returns the track indices sorted so that every parent comes before its children.
+	// Roots retain their relative order, tracks without a hierarchy retain the track order.
+	// Returns false if a parent index is invalid or if the hierarchy has a cycle.
+	bool get_topological_order(const track_array& tracks, hierarchy_order order, std::vector<uint32_t>& out_order);
+
+	//////////////////////////////////////////////////////////////////////////
+	// Reorders transform tracks so that every parent comes before its children.
+	// Parent indices are remapped to the new track order while output indices are retained:
+	// the order of the runtime output does not change. Scalar tracks are left untouched.
+	// Returns false if a parent index is invalid or if the hierarchy has a cycle, the tracks are then left untouched.
+	bool reorder_hierarchy(track_array& tracks, hierarchy_order order);
+}
@@ -25,17 +25,28 @@
 ////////////////////////////////////////////////////////////////////////////////
 
 #include <cstddef>
+#include <string>
+#include <vector>
 
 namespace acl_sjson
 {
 	// Reads a file and returns its content and size
 	// Memory is allocated with malloc and is aligned to 64 bytes
+	// Allocations are recorded by the memory tracker in the phase active on the calling thread
 	// Use free_file_memory(..) to free the allocated memory
 	bool read_file(const char* input_filename, char*& out_buffer, size_t& out_file_size);
 
 	// Frees memory allocated from read_file(..)
 	void free_file_memory(char* buffer);
 
+	// Lists the files within a directory, sub-directories are visited when recursive
+	// Symbolic links to directories are not followed, they could form a cycle
+	// Returned paths start with the directory path and are sorted
+	bool list_files(const char* directory, bool recursive, std::vector<std::string>& out_filenames);
+
+	// Creates a directory along with its missing parents, succeeds if it already exists
+	bool create_directory(const char* directory);
+
 	// Returns whether or not the filename refers to a binary ACL file
 	bool is_acl_bin_file(const char* filename);
 
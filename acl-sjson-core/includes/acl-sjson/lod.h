@@ -0,0 +1,67 @@
+#pragma once
+
+////////////////////////////////////////////////////////////////////////////////
+// The MIT License (MIT)
+//
+// Copyright (c) 2022 Nicholas Frechette
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+////////////////////////////////////////////////////////////////////////////////
+
+#include "acl-sjson/track_description.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace acl_sjson
+{
+	class track_array;
+
+	//////////////////////////////////////////////////////////////////////////
+	// A level of detail variant of a clip where some tracks are stripped from the compressed output.
+	// Stripped tracks are retained in the raw data, only their output index changes.
+	struct lod_variant_t
+	{
+		// Identifies the variant, appended to the clip name for its output
+		std::string name;
+
+		// Transform tracks deeper than this are stripped, roots have a depth of 0
+		uint32_t max_depth = k_invalid_track_index;
+
+		// Tracks with a name that matches one of these patterns are stripped
+		// '*' matches any sequence of characters and '?' matches a single character
+		std::vector<std::string> stripped_name_patterns;
+
+		// Tracks with one of these names are stripped, every name must match a track
+		std::vector<std::string> stripped_track_names;
+	};
+
+	//////////////////////////////////////////////////////////////////////////
+	// Reads a SJSON file with a 'variants' array, each variant is an object with these keys:
+	// name (required), max_depth, strip_patterns, and strip_tracks. Keys are expected in this order.
+	bool read_lod_variants(const char* filename, std::vector<lod_variant_t>& out_variants);
+
+	//////////////////////////////////////////////////////////////////////////
+	// Copies the tracks and strips those selected by the variant from the output.
+	// Descendants of a stripped transform track are stripped as well, they cannot be posed without it.
+	// The remaining output indices are compacted to stay contiguous while retaining their relative order.
+	// Returns false if the hierarchy is invalid or if a stripped track name doesn't match a track.
+	bool make_lod_variant(const track_array& tracks, const lod_variant_t& variant, track_array& out_variant);
+}
@@ -0,0 +1,117 @@
+#pragma once
+
+////////////////////////////////////////////////////////////////////////////////
+// The MIT License (MIT)
+//
+// Copyright (c) 2022 Nicholas Frechette
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+////////////////////////////////////////////////////////////////////////////////
+
+#include <cstddef>
+#include <cstdint>
+
+namespace acl_sjson
+{
+	//////////////////////////////////////////////////////////////////////////
+	// Allocations are attributed to the phase active on the calling thread.
+	enum class memory_phase : uint32_t
+	{
+		// Anything outside of a known phase
+		other,
+
+		// Reading and parsing input files
+		read,
+
+		// Converting tracks between the ACL and acl-sjson representations
+		convert,
+
+		// Compressing tracks
+		compress,
+
+		// Writing output files
+		write,
+
+		// Not a phase, the number of phases
+		count,
+	};
+
+	const char* to_string(memory_phase phase);
+
+	//////////////////////////////////////////////////////////////////////////
+	// Allocation sizes are bucketed by powers of two: bucket N holds sizes in [2^N, 2^(N+1)).
+	// The last bucket holds every larger size.
+	static constexpr uint32_t k_num_allocation_size_buckets = 32;
+
+	//////////////////////////////////////////////////////////////////////////
+	// Memory usage statistics for a phase or for the whole process.
+	struct memory_stats
+	{
+		// Bytes currently allocated and not yet freed
+		uint64_t live_bytes = 0;
+
+		// The largest value live_bytes ever reached
+		uint64_t peak_live_bytes = 0;
+
+		// Number of allocations and their total size
+		uint64_t num_allocations = 0;
+		uint64_t total_allocated_bytes = 0;
+
+		// Number of allocations per size bucket
+		uint64_t allocation_size_histogram[k_num_allocation_size_buckets] = { 0 };
+	};
+
+	//////////////////////////////////////////////////////////////////////////
+	// Returns the memory phase active on the calling thread.
+	memory_phase get_memory_phase();
+
+	//////////////////////////////////////////////////////////////////////////
+	// Sets the memory phase of the calling thread until it goes out of scope.
+	class scoped_memory_phase
+	{
+	public:
+		explicit scoped_memory_phase(memory_phase phase);
+		~scoped_memory_phase();
+
+		scoped_memory_phase(const scoped_memory_phase&) = delete;
+		scoped_memory_phase& operator=(const scoped_memory_phase&) = delete;
+
+	private:
+		memory_phase m_previous_phase;
+	};
+
+	//////////////////////////////////////////////////////////////////////////
+	// Records an allocation and returns the phase it is attributed to.
+	// Allocators must retain the phase to provide it when the memory is freed.
+	// Thread safe.
+	memory_phase track_allocation(size_t size);
+
+	//////////////////////////////////////////////////////////////////////////
+	// Records the release of an allocation attributed to the provided phase.
+	// Thread safe.
+	void track_deallocation(memory_phase phase, size_t size);
+
+	//////////////////////////////////////////////////////////////////////////
+	// Returns the memory statistics of allocations attributed to a phase.
+	memory_stats get_memory_stats(memory_phase phase);
+
+	//////////////////////////////////////////////////////////////////////////
+	// Returns the memory statistics of every allocation.
+	memory_stats get_total_memory_stats();
+}
@@ -0,0 +1,96 @@
+#pragma once
+
+////////////////////////////////////////////////////////////////////////////////
+// The MIT License (MIT)
+//
+// Copyright (c) 2022 Nicholas Frechette
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+////////////////////////////////////////////////////////////////////////////////
+
+#include "acl-sjson/sample.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace acl_sjson
+{
+	class track_array;
+
+	//////////////////////////////////////////////////////////////////////////
+	// The components of a qvv transform, in the order object_space_transforms stores them.
+	enum class qvv_component
+	{
+		rotation_x,
+		rotation_y,
+		rotation_z,
+		rotation_w,
+		translation_x,
+		translation_y,
+		translation_z,
+		scale_x,
+		scale_y,
+		scale_z,
+	};
+
+	static constexpr uint32_t k_num_qvv_components = 10;
+
+	//////////////////////////////////////////////////////////////////////////
+	// Transforms for every track and sample, stored as a structure of arrays.
+	// Each component has its own array where the samples of a track are contiguous:
+	// the value of a track at a sample is at [track_index * num_samples + sample_index].
+	class object_space_transforms
+	{
+	public:
+		object_space_transforms();
+
+		void resize(size_t num_transforms, size_t num_samples);
+
+		size_t get_num_transforms() const;
+		size_t get_num_samples() const;
+
+		// Returns the values of a component for every sample of a transform
+		float* get_component(qvv_component component, size_t transform_index);
+		const float* get_component(qvv_component component, size_t transform_index) const;
+
+		// Gathers a single transform
+		qvv get_transform(size_t transform_index, size_t sample_index) const;
+
+	private:
+		std::vector<float>	m_components[k_num_qvv_components];
+		size_t				m_num_transforms;
+		size_t				m_num_samples;
+	};
+
+	//////////////////////////////////////////////////////////////////////////
+	// Computes the object space transforms of every sample of a qvv track array.
+	// Local transforms are composed with their parent in topological order, four samples at a time.
+	// Scale is composed per component, negative scale does not go through a matrix like ACL does.
+	// Samples are processed in parallel.
+	// Returns false if the tracks are not qvv tracks or if the hierarchy is invalid.
+	bool compute_object_space(const track_array& tracks, object_space_transforms& out_transforms);
+
+	//////////////////////////////////////////////////////////////////////////
+	// Computes the object space transforms of a single pose with a local space sample per track (e.g. from
+	// track_array::sample_pose_at(..)). Tracks at the same depth are composed four at a time.
+	// The output holds a single sample per track.
+	// Returns false if the tracks are not qvv tracks or if the hierarchy is invalid.
+	bool compute_object_space(const track_array& tracks, const sample* local_pose, object_space_transforms& out_transforms);
+}
@@ -0,0 +1,51 @@
+#pragma once
+
+////////////////////////////////////////////////////////////////////////////////
+// The MIT License (MIT)
+//
+// Copyright (c) 2022 Nicholas Frechette
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+////////////////////////////////////////////////////////////////////////////////
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+
+namespace acl_sjson
+{
+	//////////////////////////////////////////////////////////////////////////
+	// Sets the maximum number of threads used by parallel loops, including the calling thread.
+	// A value of 0 uses every hardware thread available, this is the default.
+	void set_max_num_threads(uint32_t num_threads);
+
+	//////////////////////////////////////////////////////////////////////////
+	// Returns the maximum number of threads used by parallel loops, including the calling thread.
+	uint32_t get_max_num_threads();
+
+	//////////////////////////////////////////////////////////////////////////
+	// Calls the provided function for every index in [0, num_items).
+	// The work is only spread over multiple threads when it is large enough to benefit:
+	// work_per_item is a rough estimate of the cost of a single item in bytes touched.
+	// Items are processed in no particular order, to keep results deterministic
+	// the function should only write to the output slot matching its index.
+	// The function returns once every item has been processed.
+	// Loops nested within a parallel loop run serially on the calling thread.
+	void parallel_for(size_t num_items, size_t work_per_item, const std::function<void(size_t)>& func);
+}
@@ -0,0 +1,77 @@
+#pragma once
+
+////////////////////////////////////////////////////////////////////////////////
+// The MIT License (MIT)
+//
+// Copyright (c) 2022 Nicholas Frechette
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+////////////////////////////////////////////////////////////////////////////////
+
+#include <cstdint>
+
+namespace acl_sjson
+{
+	class track_array;
+
+	//////////////////////////////////////////////////////////////////////////
+	// Settings used to clean up tracks before they are compressed.
+	// Every pass retains the animation, cleaner input compresses smaller and faster.
+	struct preprocess_settings
+	{
+		// Denormal values are flushed to zero, retaining their sign
+		bool flush_denormals = true;
+
+		// Rotations further than 'rotation_length_tolerance' from unit length are normalized
+		bool normalize_rotations = true;
+
+		// Rotations are negated when needed so that consecutive samples are in the same hemisphere
+		bool make_rotations_continuous = true;
+
+		// Rotation, translation, and scale sub-tracks are set to an exact constant when every sample is within
+		// the constant threshold of the track description, the default value is used when it is within it too
+		bool snap_constant_sub_tracks = true;
+
+		// Rotations are normalized when their squared length is further than this from 1.0
+		// Smaller deviations are rounding noise that normalizing would only move around
+		float rotation_length_tolerance = 0.000001F;
+	};
+
+	//////////////////////////////////////////////////////////////////////////
+	// What preprocessing changed, samples of collapsed tracks count once per sample they repeat.
+	struct preprocess_stats
+	{
+		uint32_t num_flushed_denormals = 0;
+		uint32_t num_normalized_rotations = 0;
+		uint32_t num_flipped_rotations = 0;
+
+		// Sub-tracks snapped to a constant, either the center of their range or their default value
+		uint32_t num_constant_sub_tracks = 0;
+		uint32_t num_default_sub_tracks = 0;
+
+		// Tracks that became bit for bit constant and were collapsed
+		uint32_t num_collapsed_tracks = 0;
+	};
+
+	//////////////////////////////////////////////////////////////////////////
+	// Cleans up every track in place before compression, tracks are processed in parallel.
+	// Denormals are flushed in every track while the other passes only apply to transform tracks.
+	// Tracks with NaN or infinite values are only flushed, validation reports them as they are.
+	void preprocess_tracks(track_array& tracks, const preprocess_settings& settings, preprocess_stats& out_stats);
+}
@@ -0,0 +1,57 @@
+#pragma once
+
+////////////////////////////////////////////////////////////////////////////////
+// The MIT License (MIT)
+//
+// Copyright (c) 2022 Nicholas Frechette
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+////////////////////////////////////////////////////////////////////////////////
+
+#include "acl-sjson/sample_interpolation.h"
+
+#include <cstdint>
+
+namespace acl_sjson
+{
+	class track_array;
+
+	//////////////////////////////////////////////////////////////////////////
+	// Resamples every track to a new sample rate.
+	// New samples are interpolated from the two nearest original samples: rotations
+	// use the provided interpolation while every other value is linearly interpolated.
+	// The clip duration is retained, rounded down to a whole number of new samples.
+	// Returns false if the sample rate is invalid.
+	bool resample(track_array& tracks, float new_sample_rate, rotation_interpolation interpolation = rotation_interpolation::nlerp);
+
+	//////////////////////////////////////////////////////////////////////////
+	// The minimum number of changing frames find_native_sample_rate(..) needs to detect duplication.
+	static constexpr uint32_t k_min_native_rate_changes = 4;
+
+	//////////////////////////////////////////////////////////////////////////
+	// Detects duplicated frames and returns the native sample rate of the clip.
+	// For example, a 120 FPS capture where every frame is repeated 4 times has a native
+	// sample rate of 30 FPS. Resampling at the native rate keeps the first frame of every block
+	// of duplicates: a factor is only retained when every frame that changes starts a block and
+	// when every frame is within the absolute tolerance of the first frame of its block.
+	// A clip needs at least 'k_min_native_rate_changes' changing frames to tell duplication
+	// apart from a mostly static clip.
+	// Returns the current sample rate if no consistent duplication is found.
+	float find_native_sample_rate(const track_array& tracks, float tolerance = 0.0F);
+}
@@ -24,6 +24,8 @@
 // SOFTWARE.
 ////////////////////////////////////////////////////////////////////////////////
 
+#include <cstddef>
+
 namespace acl_sjson
 {
 	struct quat
@@ -89,6 +91,17 @@ namespace acl_sjson
 
 	const char* to_string(sample_type type);
 
+	// Returns the size in bytes of a sample of the provided type or 0 if the type is unknown
+	size_t get_sample_size(sample_type type);
+
+	// Returns whether the sample type is a transform (quat or qvv) as opposed to a scalar type
+	// Transform tracks use the transform track description, scalar tracks use the scalar one
+	bool is_transform(sample_type type);
+
+	// Returns a mask with a bit set for every sample component that holds a value, in memory order
+	// The w component of qvv translations and scales is padding and is excluded
+	int get_component_mask(sample_type type);
+
 	union sample
 	{
 		float1 f1;
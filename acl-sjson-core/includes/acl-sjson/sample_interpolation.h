@@ -0,0 +1,52 @@
+#pragma once
+
+////////////////////////////////////////////////////////////////////////////////
+// The MIT License (MIT)
+//
+// Copyright (c) 2022 Nicholas Frechette
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+////////////////////////////////////////////////////////////////////////////////
+
+namespace acl_sjson
+{
+	enum class rotation_interpolation
+	{
+		// Normalized linear interpolation, fast and accurate when samples are close together
+		nlerp,
+
+		// Spherical linear interpolation, constant angular velocity
+		slerp,
+	};
+
+	//////////////////////////////////////////////////////////////////////////
+	// How sample times outside of [0, duration] are handled.
+	enum class sample_wrap_policy
+	{
+		// Times are clamped to the first and last samples
+		clamp,
+
+		// The clip repeats every duration, the last sample must match the first (e.g. 81_18_looping)
+		loop,
+
+		// The clip repeats every num_samples / sample_rate, the last sample interpolates back to the first
+		// This matches how ACL wraps looping clips that do not repeat their first sample
+		wrap,
+	};
+}
@@ -0,0 +1,51 @@
+#pragma once
+
+////////////////////////////////////////////////////////////////////////////////
+// The MIT License (MIT)
+//
+// Copyright (c) 2022 Nicholas Frechette
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+////////////////////////////////////////////////////////////////////////////////
+
+#include <cstddef>
+
+namespace acl_sjson
+{
+	class track_array;
+
+	//////////////////////////////////////////////////////////////////////////
+	// A contiguous range of samples.
+	struct sample_range
+	{
+		size_t first_sample_index = 0;
+		size_t num_samples = 0;
+	};
+
+	//////////////////////////////////////////////////////////////////////////
+	// Computes the range of samples that lie within [start_time, end_time] in seconds.
+	// Returns false if the time range is invalid or if it contains no samples.
+	bool get_sample_range(float sample_rate, size_t num_samples, float start_time, float end_time, sample_range& out_range);
+
+	//////////////////////////////////////////////////////////////////////////
+	// Retains only the samples that lie within [start_time, end_time] in seconds.
+	// Samples are not interpolated, the sub-clip starts on the first sample in the range.
+	// Returns false if the range contains no samples, the tracks are left unchanged.
+	bool extract_range(track_array& tracks, float start_time, float end_time);
+}
@@ -0,0 +1,140 @@
+#pragma once
+
+////////////////////////////////////////////////////////////////////////////////
+// The MIT License (MIT)
+//
+// Copyright (c) 2022 Nicholas Frechette
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+////////////////////////////////////////////////////////////////////////////////
+
+#include "acl-sjson/sample.h"
+
+#include <cstddef>
+#include <cstdint>
+
+namespace acl_sjson
+{
+	//////////////////////////////////////////////////////////////////////////
+	// Compile time properties of every sample type.
+	// Code that needs to specialize per sample type should use visit_sample_type(..)
+	// instead of switching on the sample type.
+	template<sample_type type>
+	struct sample_traits;
+
+	template<>
+	struct sample_traits<sample_type::unknown>
+	{
+		static constexpr sample_type k_type = sample_type::unknown;
+		static constexpr size_t k_size = 0;
+		static constexpr uint32_t k_num_components = 0;
+	};
+
+	template<>
+	struct sample_traits<sample_type::float1>
+	{
+		using value_type = float1;
+
+		static constexpr sample_type k_type = sample_type::float1;
+		static constexpr size_t k_size = sizeof(value_type);
+		static constexpr uint32_t k_num_components = 1;
+	};
+
+	template<>
+	struct sample_traits<sample_type::float2>
+	{
+		using value_type = float2;
+
+		static constexpr sample_type k_type = sample_type::float2;
+		static constexpr size_t k_size = sizeof(value_type);
+		static constexpr uint32_t k_num_components = 2;
+	};
+
+	template<>
+	struct sample_traits<sample_type::float3>
+	{
+		using value_type = float3;
+
+		static constexpr sample_type k_type = sample_type::float3;
+		static constexpr size_t k_size = sizeof(value_type);
+		static constexpr uint32_t k_num_components = 3;
+	};
+
+	template<>
+	struct sample_traits<sample_type::float4>
+	{
+		using value_type = float4;
+
+		static constexpr sample_type k_type = sample_type::float4;
+		static constexpr size_t k_size = sizeof(value_type);
+		static constexpr uint32_t k_num_components = 4;
+	};
+
+	template<>
+	struct sample_traits<sample_type::vector4>
+	{
+		using value_type = vector4;
+
+		static constexpr sample_type k_type = sample_type::vector4;
+		static constexpr size_t k_size = sizeof(value_type);
+		static constexpr uint32_t k_num_components = 4;
+	};
+
+	template<>
+	struct sample_traits<sample_type::quat>
+	{
+		using value_type = quat;
+
+		static constexpr sample_type k_type = sample_type::quat;
+		static constexpr size_t k_size = sizeof(value_type);
+		static constexpr uint32_t k_num_components = 4;
+	};
+
+	template<>
+	struct sample_traits<sample_type::qvv>
+	{
+		using value_type = qvv;
+
+		// Rotation, translation, and scale are each stored with 4 components
+		static constexpr sample_type k_type = sample_type::qvv;
+		static constexpr size_t k_size = sizeof(value_type);
+		static constexpr uint32_t k_num_components = 12;
+	};
+
+	//////////////////////////////////////////////////////////////////////////
+	// Calls the functor with the sample_traits instance that matches the provided sample type
+	// and returns its result. The functor must handle every sample type, including unknown.
+	// Typically, a templated call operator handles supported types while non-templated
+	// overloads handle special cases.
+	template<typename functor_type>
+	inline auto visit_sample_type(sample_type type, functor_type&& functor) -> decltype(functor(sample_traits<sample_type::unknown>()))
+	{
+		switch (type)
+		{
+		case sample_type::float1:	return functor(sample_traits<sample_type::float1>());
+		case sample_type::float2:	return functor(sample_traits<sample_type::float2>());
+		case sample_type::float3:	return functor(sample_traits<sample_type::float3>());
+		case sample_type::float4:	return functor(sample_traits<sample_type::float4>());
+		case sample_type::vector4:	return functor(sample_traits<sample_type::vector4>());
+		case sample_type::quat:		return functor(sample_traits<sample_type::quat>());
+		case sample_type::qvv:		return functor(sample_traits<sample_type::qvv>());
+		default:					return functor(sample_traits<sample_type::unknown>());
+		}
+	}
+}
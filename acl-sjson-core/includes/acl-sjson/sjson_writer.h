@@ -0,0 +1,54 @@
+#pragma once
+
+////////////////////////////////////////////////////////////////////////////////
+// The MIT License (MIT)
+//
+// Copyright (c) 2022 Nicholas Frechette
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+////////////////////////////////////////////////////////////////////////////////
+
+#include "acl-sjson/acl_version.h"
+
+#include <cstddef>
+
+namespace acl_sjson
+{
+	class track_array;
+
+	//////////////////////////////////////////////////////////////////////////
+	// Formats a float with the fewest significant digits that read back to the
+	// exact same value. Returns the number of characters written, excluding the
+	// null terminator, or 0 if the buffer is too small or the value isn't finite.
+	// A buffer of 32 characters fits every finite value.
+	size_t format_shortest_float(float value, char* buffer, size_t buffer_size);
+
+	//////////////////////////////////////////////////////////////////////////
+	// Returns whether every sample is finite and can be written as a decimal.
+	bool can_write_sjson_decimal(const track_array& tracks);
+
+	//////////////////////////////////////////////////////////////////////////
+	// Writes the tracks as a SJSON track list, see regression_tests/format_reference.acl.sjson.
+	// Floats are written as the shortest decimal that reads back to the same value, which
+	// is lossless without the size of binary exact hexadecimal values.
+	// Track descriptions are written as the requested ACL version reads them: the
+	// constant thresholds for ACL 2.0 and the bind pose for ACL 2.1.
+	// Fails if a sample isn't finite, see can_write_sjson_decimal(..).
+	bool write_sjson_tracks(const char* filename, const track_array& tracks, acl_version version);
+}
@@ -0,0 +1,78 @@
+#pragma once
+
+////////////////////////////////////////////////////////////////////////////////
+// The MIT License (MIT)
+//
+// Copyright (c) 2022 Nicholas Frechette
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+////////////////////////////////////////////////////////////////////////////////
+
+#include <cstddef>
+#include <memory>
+#include <unordered_set>
+#include <vector>
+
+namespace acl_sjson
+{
+	//////////////////////////////////////////////////////////////////////////
+	// Hashes the content of a null terminated string.
+	struct string_hasher
+	{
+		size_t operator()(const char* str) const;
+	};
+
+	//////////////////////////////////////////////////////////////////////////
+	// Compares the content of two null terminated strings.
+	struct string_equal
+	{
+		bool operator()(const char* lhs, const char* rhs) const;
+	};
+
+	//////////////////////////////////////////////////////////////////////////
+	// A string pool stores a single copy of every unique string interned.
+	// Interned strings are allocated in large blocks and their address remains stable
+	// until the pool is cleared or destroyed, even when the pool is moved.
+	class string_pool
+	{
+	public:
+		string_pool();
+
+		string_pool(const string_pool&) = delete;
+		string_pool(string_pool&& other);
+		string_pool& operator=(const string_pool&) = delete;
+		string_pool& operator=(string_pool&& other);
+
+		size_t get_num_strings() const;
+
+		// Returns the interned copy of the provided string, adding it if it isn't present
+		const char* intern(const char* str);
+
+		// Returns the interned copy of the provided string or nullptr if it isn't present
+		const char* find(const char* str) const;
+
+		void clear();
+
+	private:
+		std::vector<std::unique_ptr<char[]>>						m_blocks;
+		std::unordered_set<const char*, string_hasher, string_equal>	m_strings;
+		char*														m_block_cursor;
+		size_t														m_block_remaining;
+	};
+}
@@ -25,6 +25,7 @@
 ////////////////////////////////////////////////////////////////////////////////
 
 #include "acl-sjson/sample.h"
+#include "acl-sjson/sample_interpolation.h"
 #include "acl-sjson/track_description.h"
 
 #include <cstddef>
@@ -33,6 +34,12 @@
 
 namespace acl_sjson
 {
+	//////////////////////////////////////////////////////////////////////////
+	// A track holds a list of samples of a single type.
+	// Tracks where every sample is bit for bit identical are collapsed as they are built:
+	// a single sample is stored along with the number of times it repeats. Samples are read
+	// as if every sample was stored, writing a distinct sample expands the track first.
+	// Once added to a track_array, the track name is interned in the array string pool.
 	class track
 	{
 	public:
@@ -50,17 +57,61 @@ namespace acl_sjson
 
 		void emplace_back(sample&& item);
 
+		// Reserves storage for the provided number of samples
+		// Storage is only allocated once the track holds distinct samples, constant tracks remain collapsed
+		void reserve(size_t num_samples);
+
+		// Returns whether or not the track is collapsed into a single repeating sample
+		bool is_collapsed() const;
+
+		// Expands a collapsed track to store every sample individually
+		void expand();
+
+		// Collapses the track into a single repeating sample when every sample is bit for bit identical
+		// Returns whether or not the track is collapsed
+		bool collapse();
+
+		// Returns the sample at the provided time in seconds, interpolated from the two nearest samples
+		// Rotations use the provided interpolation while every other value is linearly interpolated
+		// Exact keys are returned bit for bit, tracks without samples return a zeroed sample
+		sample sample_at(float time, rotation_interpolation interpolation = rotation_interpolation::nlerp, sample_wrap_policy wrap_policy = sample_wrap_policy::clamp) const;
+
 		track_description& get_description();
 		const track_description& get_description() const;
 
+		// The output index from the transform or scalar description, based on the sample type
+		uint32_t get_output_index() const;
+		void set_output_index(uint32_t output_index);
+
+		// Replaces the sample at the provided index
+		// Collapsed tracks are only expanded when the new sample differs from the repeating one
+		void set_sample(size_t index, const sample& item);
+
+		// Replaces every sample with the provided one, the track is left collapsed
+		// The repeating sample of a collapsed track is replaced in place without expanding it
+		void set_constant_sample(const sample& item);
+
+		// Returns every sample for in place writes, collapsed tracks are expanded first
+		sample* get_mutable_samples();
+
+		// Returns the sample at the provided index for in place writes, collapsed tracks are expanded first
+		// Reads through a const track and set_sample(..) leave collapsed tracks untouched
 		sample& operator[](size_t index);
 		const sample& operator[](size_t index) const;
 
 	private:
+		// Interned names are owned by the track_array string pool
+		void set_interned_name(const char* name);
+
 		std::vector<sample> m_samples;
 		std::string			m_name;
+		const char*			m_interned_name;
 		track_description   m_desc;
+		size_t				m_num_samples;
+		size_t				m_num_reserved_samples;
 		sample_type         m_type;
 		float               m_sample_rate;
+
+		friend class track_array;
 	};
 }
@@ -26,14 +26,23 @@
 
 #include "acl-sjson/metadata.h"
 #include "acl-sjson/sample.h"
+#include "acl-sjson/sample_interpolation.h"
+#include "acl-sjson/string_pool.h"
 #include "acl-sjson/track.h"
 
+#include <atomic>
 #include <cstddef>
+#include <cstdint>
+#include <mutex>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 namespace acl_sjson
 {
+	//////////////////////////////////////////////////////////////////////////
+	// A track array holds a list of tracks that share the same sample type and sample rate.
+	// Track names are interned in a string pool owned by the array.
 	class track_array
 	{
 	public:
@@ -41,9 +50,9 @@ namespace acl_sjson
 		explicit track_array(const char* name, const metadata_t& metadata);
 
 		track_array(const track_array&) = delete;
-		track_array(track_array&&) = default;
+		track_array(track_array&& other);
 		track_array& operator=(const track_array&) = delete;
-		track_array& operator=(track_array&&) = default;
+		track_array& operator=(track_array&& other);
 
 		sample_type get_type() const;
 		size_t get_num_tracks() const;
@@ -58,12 +67,30 @@ namespace acl_sjson
 
 		void clear();
 
+		// Returns the index of the first track with the provided name or k_invalid_track_index if none match
+		// The name index is built lazily on first use and it is then shared by every caller until
+		// the array is modified. It is safe to call concurrently.
+		uint32_t find(const char* name) const;
+
+		// Samples every track at the provided time in seconds, see track::sample_at(..)
+		// The pose receives a sample per track in track order, the interpolation keys are found once for every track
+		// Returns false if the pose cannot hold a sample per track
+		bool sample_pose_at(float time, sample* out_pose, size_t pose_size, rotation_interpolation interpolation = rotation_interpolation::nlerp, sample_wrap_policy wrap_policy = sample_wrap_policy::clamp) const;
+
 		track& operator[](size_t index);
 		const track& operator[](size_t index) const;
 
 	private:
+		void invalidate_name_index();
+
 		std::vector<track>  m_tracks;
 		std::string			m_name;
 		metadata_t          m_metadata;
+		string_pool			m_names;
+
+		// Maps interned names to their track index
+		mutable std::unordered_map<const char*, uint32_t, string_hasher, string_equal>	m_name_index;
+		mutable std::mutex																m_name_index_lock;
+		mutable std::atomic<bool>														m_is_name_index_built;
 	};
 }
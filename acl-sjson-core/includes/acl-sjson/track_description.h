@@ -30,6 +30,10 @@
 
 namespace acl_sjson
 {
+	//////////////////////////////////////////////////////////////////////////
+	// An invalid track index, used for output and parent indices.
+	static constexpr uint32_t k_invalid_track_index = 0xFFFFFFFFU;
+
 	//////////////////////////////////////////////////////////////////////////
 	// This structure describes the various settings for floating point scalar tracks.
 	// Used by: float1f, float2f, float3f, float4f, vector4f
@@ -0,0 +1,109 @@
+#pragma once
+
+////////////////////////////////////////////////////////////////////////////////
+// The MIT License (MIT)
+//
+// Copyright (c) 2022 Nicholas Frechette
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+////////////////////////////////////////////////////////////////////////////////
+
+#include "acl-sjson/metadata.h"
+#include "acl-sjson/sample.h"
+#include "acl-sjson/track_array.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace acl_sjson
+{
+	//////////////////////////////////////////////////////////////////////////
+	// A track store holds a set of clips where every unique track is stored only once.
+	// Two tracks are considered identical when their sample type, sample rate, description,
+	// and samples match bit for bit. Track names are not part of the track identity, they
+	// are stored alongside each clip track reference.
+	// Clips are rebuilt from their track references with make_clip(..).
+	class track_store
+	{
+	public:
+		track_store();
+
+		track_store(const track_store&) = delete;
+		track_store(track_store&&) = default;
+		track_store& operator=(const track_store&) = delete;
+		track_store& operator=(track_store&&) = default;
+
+		size_t get_num_clips() const;
+		size_t get_num_unique_tracks() const;
+		size_t get_num_track_references() const;
+
+		// Returns the name the clip was added with (e.g. its filename)
+		const char* get_clip_name(size_t clip_index) const;
+
+		// Adds a clip to the store, its tracks are deduplicated against every track already present
+		void add_clip(const char* name, const track_array& tracks);
+
+		// Rebuilds the track array of a clip from its track references
+		// Returns false if a referenced track is truncated or has an invalid sample type
+		bool make_clip(size_t clip_index, track_array& out_tracks) const;
+
+		void clear();
+
+		// Writes the store in binary form to the provided file
+		bool write(const char* filename) const;
+
+		// Reads a store previously written with write(..), the current content is replaced
+		bool read(const char* filename);
+
+	private:
+		struct track_entry
+		{
+			// Serialized description followed by the packed samples
+			std::vector<uint8_t>	data;
+
+			uint64_t				hash;
+			sample_type				type;
+			float					sample_rate;
+			uint32_t				num_samples;
+		};
+
+		struct track_reference
+		{
+			std::string				name;
+			uint32_t				entry_index;
+		};
+
+		struct clip_entry
+		{
+			std::string						name;
+			std::string						array_name;
+			metadata_t						metadata;
+			std::vector<track_reference>	tracks;
+		};
+
+		uint32_t find_or_add_entry(track_entry&& entry);
+
+		std::vector<track_entry>						m_entries;
+		std::vector<clip_entry>							m_clips;
+		std::unordered_multimap<uint64_t, uint32_t>		m_entry_map;
+	};
+}
@@ -0,0 +1,141 @@
+#pragma once
+
+////////////////////////////////////////////////////////////////////////////////
+// The MIT License (MIT)
+//
+// Copyright (c) 2022 Nicholas Frechette
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+////////////////////////////////////////////////////////////////////////////////
+
+#include "acl-sjson/sample.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace acl_sjson
+{
+	class track_array;
+
+	//////////////////////////////////////////////////////////////////////////
+	// Settings used to validate a clip before it is compressed.
+	struct validation_settings
+	{
+		// Rotations are normalized when their squared length is within this tolerance of 1.0
+		// Matches the threshold ACL uses when it asserts that rotations are normalized
+		float rotation_length_tolerance = 0.00001F;
+
+		// Stops at the first error, useful when only a yes/no answer is needed
+		// Warnings found before the first error are retained
+		bool stop_on_first_error = false;
+	};
+
+	enum class validation_severity
+	{
+		// The clip can be compressed but the result might not be what is expected
+		warning,
+
+		// The clip cannot be compressed reliably
+		error,
+	};
+
+	enum class validation_issue_type
+	{
+		// A value is NaN or infinite
+		non_finite_value,
+
+		// A value is denormal, it might be flushed to zero and it is slow to process on some hardware
+		denormal_value,
+
+		// A value is so large that its square overflows, error metrics measure an infinite error
+		overflowing_value,
+
+		// A rotation isn't normalized
+		non_normalized_rotation,
+
+		// A scale component is zero, the transform cannot be inverted
+		zero_scale,
+
+		// A scale component is negative
+		negative_scale,
+
+		// A parent index refers to the track itself or to a track that doesn't exist
+		invalid_parent_index,
+
+		// Following the parent indices leads back to the track
+		parent_cycle,
+
+		// An output index is not smaller than the number of tracks that are not stripped
+		invalid_output_index,
+
+		// An output index is used by more than one track
+		duplicate_output_index,
+	};
+
+	const char* to_string(validation_severity severity);
+	const char* to_string(validation_issue_type type);
+
+	// Returns the severity of every issue of the provided type
+	validation_severity get_severity(validation_issue_type type);
+
+	// Returns the name of a sample component (e.g. "x" or "rotation.x")
+	const char* get_component_name(sample_type type, uint32_t component_index);
+
+	//////////////////////////////////////////////////////////////////////////
+	// An issue found in a single track.
+	// Sample issues are reported once per track and type, with the first offending sample.
+	struct validation_issue
+	{
+		validation_issue_type type = validation_issue_type::non_finite_value;
+		uint32_t track_index = 0;
+
+		// The first offending sample and component, k_invalid_track_index for description issues
+		uint32_t sample_index = 0;
+		uint32_t component_index = 0;
+
+		// The number of offending samples in the track
+		uint32_t num_samples = 0;
+
+		// The first offending value, the squared length for rotations
+		float value = 0.0F;
+
+		// The offending parent or output index for description issues
+		uint32_t index = 0;
+	};
+
+	//////////////////////////////////////////////////////////////////////////
+	// The issues found in a clip.
+	struct clip_validation
+	{
+		// Every issue found, sorted by track index and issue type
+		// With stop_on_first_error, only the issues found up to the first error are retained
+		std::vector<validation_issue> issues;
+
+		uint32_t num_errors = 0;
+		uint32_t num_warnings = 0;
+
+		bool has_errors() const { return num_errors != 0; }
+	};
+
+	//////////////////////////////////////////////////////////////////////////
+	// Validates the descriptions and samples of every track in a single pass over the samples.
+	// Samples are checked 4 components at a time, collapsed tracks only check their single sample.
+	// Tracks are validated in parallel.
+	void validate_tracks(const track_array& tracks, const validation_settings& settings, clip_validation& out_validation);
+}
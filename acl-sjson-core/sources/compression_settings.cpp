@@ -0,0 +1,252 @@
+////////////////////////////////////////////////////////////////////////////////
+// The MIT License (MIT)
+//
+// Copyright (c) 2022 Nicholas Frechette
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+////////////////////////////////////////////////////////////////////////////////
+
+#include "acl-sjson/compression_settings.h"
+
+#include "sjson_reader.h"
+
+#include <sjson/parser.h>
+
+#include <cctype>
+#include <cstdio>
+#include <utility>
+
+namespace acl_sjson
+{
+	namespace
+	{
+		// Config files spell formats in various ways across ACL versions (e.g. QuatDropW_Variable, quatf_drop_w_variable)
+		// We only retain lowercase letters and digits to compare them
+		static std::string normalize(const std::string& value)
+		{
+			std::string result;
+			for (const char c : value)
+			{
+				if (std::isalnum(static_cast<unsigned char>(c)))
+					result += static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+			}
+
+			return result;
+		}
+
+		static bool contains(const std::string& value, const char* pattern)
+		{
+			return value.find(pattern) != std::string::npos;
+		}
+
+		static std::string to_string(const sjson::StringView& value)
+		{
+			return std::string(value.c_str(), value.size());
+		}
+
+		static bool parse_database_settings(const char* filename, sjson::Parser& parser, database_settings_t& out_settings)
+		{
+			// Tier proportions and the chunk size are optional, missing keys keep their default value
+			double medium_proportion = out_settings.medium_importance_tier_proportion;
+			double low_proportion = out_settings.low_importance_tier_proportion;
+			double max_chunk_size = out_settings.max_chunk_size;
+			parser.try_read("medium_importance_tier_proportion", medium_proportion, medium_proportion);
+			parser.try_read("low_importance_tier_proportion", low_proportion, low_proportion);
+			parser.try_read("max_chunk_size", max_chunk_size, max_chunk_size);
+
+			if (!parser.object_ends())
+				return false;
+
+			if (!(medium_proportion >= 0.0) || medium_proportion > 1.0 || !(low_proportion >= 0.0) || low_proportion > 1.0)
+			{
+				printf("Database tier proportions must be in [0.0, 1.0] in %s\n", filename);
+				return false;
+			}
+
+			if (!(max_chunk_size >= 0.0) || max_chunk_size > double(0xFFFFFFFFU))
+			{
+				printf("Invalid database chunk size in %s\n", filename);
+				return false;
+			}
+
+			out_settings.medium_importance_tier_proportion = static_cast<float>(medium_proportion);
+			out_settings.low_importance_tier_proportion = static_cast<float>(low_proportion);
+			out_settings.max_chunk_size = static_cast<uint32_t>(max_chunk_size);
+
+			if (out_settings.medium_importance_tier_proportion + out_settings.low_importance_tier_proportion > 1.0F)
+			{
+				printf("Database tier proportions cannot exceed 1.0 in %s\n", filename);
+				return false;
+			}
+
+			return true;
+		}
+
+		static bool parse_level(const std::string& value, compression_level_t& out_level)
+		{
+			const std::string level = normalize(value);
+			if (level == "lowest")
+				out_level = compression_level_t::lowest;
+			else if (level == "low")
+				out_level = compression_level_t::low;
+			else if (level == "medium")
+				out_level = compression_level_t::medium;
+			else if (level == "high")
+				out_level = compression_level_t::high;
+			else if (level == "highest")
+				out_level = compression_level_t::highest;
+			else if (level == "automatic")
+				out_level = compression_level_t::automatic;
+			else
+				return false;
+
+			return true;
+		}
+
+		static bool parse_rotation_format(const std::string& value, rotation_format_t& out_format)
+		{
+			const std::string format = normalize(value);
+			if (format.compare(0, 4, "quat") != 0)
+				return false;
+
+			if (!contains(format, "dropw"))
+				out_format = rotation_format_t::quatf_full;
+			else if (contains(format, "variable"))
+				out_format = rotation_format_t::quatf_drop_w_variable;
+			else
+				out_format = rotation_format_t::quatf_drop_w_full;
+
+			return true;
+		}
+
+		static bool parse_vector_format(const std::string& value, vector_format_t& out_format)
+		{
+			const std::string format = normalize(value);
+			if (format.compare(0, 7, "vector3") != 0)
+				return false;
+
+			out_format = contains(format, "variable") ? vector_format_t::vector3f_variable : vector_format_t::vector3f_full;
+			return true;
+		}
+	}
+
+	const char* to_string(compression_level_t level)
+	{
+		switch (level)
+		{
+		case compression_level_t::lowest:		return "lowest";
+		case compression_level_t::low:			return "low";
+		case compression_level_t::medium:		return "medium";
+		case compression_level_t::high:			return "high";
+		case compression_level_t::highest:		return "highest";
+		case compression_level_t::automatic:	return "automatic";
+		default:								return "unknown";
+		}
+	}
+
+	const char* to_string(error_metric_t metric)
+	{
+		switch (metric)
+		{
+		case error_metric_t::qvv:			return "qvv";
+		case error_metric_t::matrix3x4:		return "matrix3x4";
+		default:							return "unknown";
+		}
+	}
+
+	bool read_compression_settings(const char* filename, compression_settings_t& out_settings)
+	{
+		compression_settings_t settings;
+
+		// The name is the filename without its directory and extensions
+		const char* name = filename;
+		for (const char* ptr = filename; *ptr != '\0'; ++ptr)
+		{
+			if (*ptr == '/' || *ptr == '\\')
+				name = ptr + 1;
+		}
+
+		settings.name = name;
+		settings.name = settings.name.substr(0, settings.name.find('.'));
+
+		const auto parse_root = [filename, &settings](sjson::Parser& parser)
+		{
+			// Keys are read in the order ACL config files use, the version and algorithm name are not needed
+			double version = 0.0;
+			sjson::StringView algorithm_name;
+			parser.try_read("version", version, 0.0);
+			parser.try_read("algorithm_name", algorithm_name, "");
+
+			sjson::StringView level;
+			if (parser.try_read("level", level, "") && !parse_level(to_string(level), settings.level))
+			{
+				printf("Unknown compression level '%s' in %s\n", to_string(level).c_str(), filename);
+				return false;
+			}
+
+			sjson::StringView rotation_format;
+			if (parser.try_read("rotation_format", rotation_format, "") && !parse_rotation_format(to_string(rotation_format), settings.rotation_format))
+			{
+				printf("Unknown rotation format '%s' in %s\n", to_string(rotation_format).c_str(), filename);
+				return false;
+			}
+
+			sjson::StringView translation_format;
+			if (parser.try_read("translation_format", translation_format, "") && !parse_vector_format(to_string(translation_format), settings.translation_format))
+			{
+				printf("Unknown translation format '%s' in %s\n", to_string(translation_format).c_str(), filename);
+				return false;
+			}
+
+			sjson::StringView scale_format;
+			if (parser.try_read("scale_format", scale_format, "") && !parse_vector_format(to_string(scale_format), settings.scale_format))
+			{
+				printf("Unknown scale format '%s' in %s\n", to_string(scale_format).c_str(), filename);
+				return false;
+			}
+
+			sjson::StringView error_metric;
+			if (parser.try_read("error_metric", error_metric, ""))
+			{
+				const std::string metric = normalize(to_string(error_metric));
+				settings.error_metric = contains(metric, "matrix") || contains(metric, "mtx") ? error_metric_t::matrix3x4 : error_metric_t::qvv;
+			}
+
+			// Database settings live in their own object or behind a flag depending on the ACL version
+			parser.try_read("enable_database_support", settings.enable_database, false);
+			if (parser.try_object_begins("database"))
+			{
+				settings.enable_database = true;
+				if (!parse_database_settings(filename, parser, settings.database))
+					return false;
+			}
+
+			double regression_error_threshold = 0.0;
+			parser.try_read("regression_error_threshold", regression_error_threshold, 0.0);
+
+			return parser.is_valid();
+		};
+
+		if (!parse_sjson_file(filename, parse_root))
+			return false;
+
+		out_settings = std::move(settings);
+		return true;
+	}
+}
@@ -0,0 +1,192 @@
+////////////////////////////////////////////////////////////////////////////////
+// The MIT License (MIT)
+//
+// Copyright (c) 2022 Nicholas Frechette
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+////////////////////////////////////////////////////////////////////////////////
+
+#include "acl-sjson/cpu_dispatch.h"
+
+#include "simd_kernels.h"
+
+#include <atomic>
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+	#define ACL_SJSON_X86_CPUID
+	#if defined(_MSC_VER)
+		#include <intrin.h>
+	#else
+		#include <cpuid.h>
+	#endif
+#endif
+
+namespace acl_sjson
+{
+	namespace
+	{
+#if defined(ACL_SJSON_X86_CPUID)
+		// Registers are returned as [eax, ebx, ecx, edx]
+		static void query_cpuid(uint32_t leaf, uint32_t sub_leaf, uint32_t* out_registers)
+		{
+#if defined(_MSC_VER)
+			int registers[4];
+			__cpuidex(registers, static_cast<int>(leaf), static_cast<int>(sub_leaf));
+			for (int register_index = 0; register_index < 4; ++register_index)
+				out_registers[register_index] = static_cast<uint32_t>(registers[register_index]);
+#else
+			__cpuid_count(leaf, sub_leaf, out_registers[0], out_registers[1], out_registers[2], out_registers[3]);
+#endif
+		}
+
+		// The extended control register lists the register states the OS saves on context switches
+		static uint64_t read_xcr0()
+		{
+#if defined(_MSC_VER)
+			return _xgetbv(0);
+#else
+			uint32_t eax;
+			uint32_t edx;
+			__asm__ volatile("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+			return (uint64_t(edx) << 32) | eax;
+#endif
+		}
+
+		static cpu_isa detect_cpu_isa()
+		{
+			uint32_t registers[4];
+			query_cpuid(0, 0, registers);
+			const uint32_t max_leaf = registers[0];
+
+			query_cpuid(1, 0, registers);
+			const bool has_sse2 = (registers[3] & (1U << 26)) != 0;
+			const bool has_osxsave = (registers[2] & (1U << 27)) != 0;
+			const bool has_avx = (registers[2] & (1U << 28)) != 0;
+
+			if (!has_sse2)
+				return cpu_isa::scalar;
+
+			// YMM registers need the SSE and AVX states, ZMM registers also need the opmask and upper ZMM states
+			const uint64_t xcr0 = has_osxsave ? read_xcr0() : 0;
+			const bool has_ymm_state = (xcr0 & 0x06) == 0x06;
+			const bool has_zmm_state = (xcr0 & 0xE6) == 0xE6;
+
+			if (max_leaf < 7 || !has_avx || !has_ymm_state)
+				return cpu_isa::sse2;
+
+			query_cpuid(7, 0, registers);
+			const bool has_avx2 = (registers[1] & (1U << 5)) != 0;
+			const bool has_avx512f = (registers[1] & (1U << 16)) != 0;
+
+			if (!has_avx2)
+				return cpu_isa::sse2;
+
+			if (has_avx512f && has_zmm_state)
+				return cpu_isa::avx512;
+
+			return cpu_isa::avx2;
+		}
+#else
+		static cpu_isa detect_cpu_isa()
+		{
+			return cpu_isa::scalar;
+		}
+#endif
+
+		static const simd_kernels* get_kernels(cpu_isa isa)
+		{
+			switch (isa)
+			{
+			case cpu_isa::scalar:	return get_scalar_kernels();
+			case cpu_isa::sse2:		return get_sse2_kernels();
+			case cpu_isa::avx2:		return get_avx2_kernels();
+			case cpu_isa::avx512:	return get_avx512_kernels();
+			default:				return nullptr;
+			}
+		}
+
+		static cpu_isa find_supported_cpu_isa()
+		{
+			// The build may lack the kernels of an instruction set the CPU supports
+			cpu_isa isa = detect_cpu_isa();
+			while (isa != cpu_isa::scalar && get_kernels(isa) == nullptr)
+				isa = static_cast<cpu_isa>(static_cast<uint32_t>(isa) - 1);
+
+			return isa;
+		}
+
+		// Set once the kernels are first used or when forced
+		static std::atomic<const simd_kernels*> s_kernels(nullptr);
+		static std::atomic<uint32_t> s_cpu_isa(0);
+	}
+
+	const char* to_string(cpu_isa isa)
+	{
+		switch (isa)
+		{
+		case cpu_isa::scalar:	return "scalar";
+		case cpu_isa::sse2:		return "sse2";
+		case cpu_isa::avx2:		return "avx2";
+		case cpu_isa::avx512:	return "avx512";
+		default:				return "unknown";
+		}
+	}
+
+	cpu_isa get_supported_cpu_isa()
+	{
+		static const cpu_isa supported_isa = find_supported_cpu_isa();
+		return supported_isa;
+	}
+
+	cpu_isa get_cpu_isa()
+	{
+		// Make sure the kernels are selected
+		get_simd_kernels();
+		return static_cast<cpu_isa>(s_cpu_isa.load(std::memory_order_acquire));
+	}
+
+	bool set_cpu_isa(cpu_isa isa)
+	{
+		if (static_cast<uint32_t>(isa) > static_cast<uint32_t>(get_supported_cpu_isa()))
+			return false;
+
+		const simd_kernels* kernels = get_kernels(isa);
+		if (kernels == nullptr)
+			return false;
+
+		s_cpu_isa.store(static_cast<uint32_t>(isa), std::memory_order_relaxed);
+		s_kernels.store(kernels, std::memory_order_release);
+		return true;
+	}
+
+	const simd_kernels& get_simd_kernels()
+	{
+		const simd_kernels* kernels = s_kernels.load(std::memory_order_acquire);
+		if (kernels != nullptr)
+			return *kernels;
+
+		// Concurrent first calls select the same kernels
+		const cpu_isa isa = get_supported_cpu_isa();
+		kernels = get_kernels(isa);
+
+		s_cpu_isa.store(static_cast<uint32_t>(isa), std::memory_order_relaxed);
+		s_kernels.store(kernels, std::memory_order_release);
+		return *kernels;
+	}
+}
@@ -0,0 +1,173 @@
+////////////////////////////////////////////////////////////////////////////////
+// The MIT License (MIT)
+//
+// Copyright (c) 2022 Nicholas Frechette
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+////////////////////////////////////////////////////////////////////////////////
+
+#include "acl-sjson/diff.h"
+#include "acl-sjson/parallel.h"
+#include "acl-sjson/track.h"
+#include "acl-sjson/track_array.h"
+
+#include "simd_kernels.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+
+namespace acl_sjson
+{
+	namespace
+	{
+		// The number of samples compared at once, small enough for the results to stay on the stack
+		static constexpr uint32_t k_num_block_samples = 64;
+
+		static bool diff_track(const track& lhs, const track& rhs, uint32_t track_index, const diff_settings& settings, const std::atomic<bool>& is_done, track_diff& out_diff)
+		{
+			out_diff.track_index = track_index;
+			out_diff.lhs_type = lhs.get_type();
+			out_diff.rhs_type = rhs.get_type();
+
+			if (lhs.get_type() != rhs.get_type())
+			{
+				out_diff.reason = track_diff_reason::sample_type;
+				return false;
+			}
+
+			// Padding is not compared, readers do not agree on its content
+			const uint32_t component_mask = static_cast<uint32_t>(get_component_mask(lhs.get_type()));
+			const uint32_t num_samples = static_cast<uint32_t>(lhs.get_num_samples());
+
+			// Samples are compared in blocks by the kernels of the current instruction set
+			const simd_kernels& kernels = get_simd_kernels();
+			float block_errors[k_num_block_samples];
+			uint8_t block_is_match[k_num_block_samples];
+
+			// Collapsed tracks repeat a single sample, compare it once
+			if (lhs.is_collapsed() && rhs.is_collapsed())
+			{
+				kernels.compare_samples(&lhs[0], 0, &rhs[0], 0, 1, component_mask, settings.absolute_tolerance, settings.relative_tolerance, block_errors, block_is_match);
+				if (block_is_match[0] != 0)
+					return true;
+
+				out_diff.num_mismatched_frames = num_samples;
+				out_diff.max_error = block_errors[0];
+
+				const uint32_t num_reported_frames = std::min(num_samples, settings.max_reported_frames);
+				for (uint32_t sample_index = 0; sample_index < num_reported_frames; ++sample_index)
+					out_diff.frames.push_back(sample_index);
+
+				return false;
+			}
+
+			// A collapsed track repeats its first sample against every sample of the other
+			const size_t lhs_stride = lhs.is_collapsed() ? 0 : 1;
+			const size_t rhs_stride = rhs.is_collapsed() ? 0 : 1;
+
+			for (uint32_t block_start = 0; block_start < num_samples; block_start += k_num_block_samples)
+			{
+				// Another track already found a mismatch, the answer is known
+				if (settings.stop_on_first_mismatch && is_done.load(std::memory_order_relaxed))
+					break;
+
+				const uint32_t num_block_samples = std::min(k_num_block_samples, num_samples - block_start);
+				kernels.compare_samples(&lhs[block_start * lhs_stride], lhs_stride, &rhs[block_start * rhs_stride], rhs_stride, num_block_samples, component_mask,
+					settings.absolute_tolerance, settings.relative_tolerance, block_errors, block_is_match);
+
+				for (uint32_t block_index = 0; block_index < num_block_samples; ++block_index)
+				{
+					if (block_is_match[block_index] != 0)
+						continue;
+
+					++out_diff.num_mismatched_frames;
+					out_diff.max_error = std::max(out_diff.max_error, block_errors[block_index]);
+
+					if (out_diff.frames.size() < settings.max_reported_frames)
+						out_diff.frames.push_back(block_start + block_index);
+
+					if (settings.stop_on_first_mismatch)
+						return false;
+				}
+			}
+
+			return out_diff.num_mismatched_frames == 0;
+		}
+	}
+
+	void diff_tracks(const track_array& lhs, const track_array& rhs, const diff_settings& settings, clip_diff& out_diff)
+	{
+		out_diff = clip_diff();
+
+		char message[256];
+		if (lhs.get_num_tracks() != rhs.get_num_tracks())
+		{
+			snprintf(message, sizeof(message), "Number of tracks differ: %u vs %u", static_cast<uint32_t>(lhs.get_num_tracks()), static_cast<uint32_t>(rhs.get_num_tracks()));
+			out_diff.structure_mismatch = message;
+			return;
+		}
+
+		if (lhs.get_num_samples_per_track() != rhs.get_num_samples_per_track())
+		{
+			snprintf(message, sizeof(message), "Number of samples per track differ: %u vs %u", static_cast<uint32_t>(lhs.get_num_samples_per_track()), static_cast<uint32_t>(rhs.get_num_samples_per_track()));
+			out_diff.structure_mismatch = message;
+			return;
+		}
+
+		if (lhs.get_sample_rate() != rhs.get_sample_rate())
+		{
+			snprintf(message, sizeof(message), "Sample rates differ: %.2f FPS vs %.2f FPS", lhs.get_sample_rate(), rhs.get_sample_rate());
+			out_diff.structure_mismatch = message;
+			return;
+		}
+
+		const size_t num_tracks = lhs.get_num_tracks();
+
+		// Each track writes its own slot, they are gathered in order once done
+		std::vector<track_diff> track_diffs(num_tracks);
+		std::vector<char> is_track_equal(num_tracks, 1);
+		std::atomic<bool> is_done(false);
+
+		const bool stop_on_first_mismatch = settings.stop_on_first_mismatch;
+		const size_t work_per_track = lhs.get_num_samples_per_track() * sizeof(sample) * 2;
+		parallel_for(num_tracks, work_per_track, [&](size_t track_index)
+			{
+				if (stop_on_first_mismatch && is_done.load(std::memory_order_relaxed))
+					return;
+
+				const bool is_equal = diff_track(lhs[track_index], rhs[track_index], static_cast<uint32_t>(track_index), settings, is_done, track_diffs[track_index]);
+				is_track_equal[track_index] = is_equal;
+
+				if (!is_equal && stop_on_first_mismatch)
+					is_done.store(true, std::memory_order_relaxed);
+			});
+
+		for (size_t track_index = 0; track_index < num_tracks; ++track_index)
+		{
+			if (is_track_equal[track_index] != 0)
+				continue;
+
+			out_diff.tracks.push_back(std::move(track_diffs[track_index]));
+
+			if (stop_on_first_mismatch)
+				break;
+		}
+	}
+}
@@ -0,0 +1,302 @@
+////////////////////////////////////////////////////////////////////////////////
+// The MIT License (MIT)
+//
+// Copyright (c) 2022 Nicholas Frechette
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+////////////////////////////////////////////////////////////////////////////////
+
+#include "acl-sjson/generator.h"
+#include "acl-sjson/metadata.h"
+#include "acl-sjson/track.h"
+#include "acl-sjson/track_array.h"
+
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+namespace acl_sjson
+{
+	namespace
+	{
+		// SplitMix64, small and fast with well defined output on every platform
+		// unlike the standard library distributions
+		class random_generator
+		{
+		public:
+			explicit random_generator(uint64_t seed) : m_state(seed) {}
+
+			uint64_t next()
+			{
+				uint64_t value = (m_state += 0x9E3779B97F4A7C15ULL);
+				value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ULL;
+				value = (value ^ (value >> 27)) * 0x94D049BB133111EBULL;
+				return value ^ (value >> 31);
+			}
+
+			// Returns a value in [0.0, 1.0)
+			float next_float()
+			{
+				return float(next() >> 40) * (1.0F / float(1 << 24));
+			}
+
+			// Returns a value in [min_value, max_value)
+			float next_float(float min_value, float max_value)
+			{
+				return min_value + ((max_value - min_value) * next_float());
+			}
+
+			// Returns a value in [0, max_value)
+			uint32_t next_index(uint32_t max_value)
+			{
+				return static_cast<uint32_t>(next() % max_value);
+			}
+
+		private:
+			uint64_t m_state;
+		};
+
+		// The standard library sin and cos are not correctly rounded and their results differ across platforms
+		// These only rely on IEEE 754 arithmetic, which gives the same results everywhere
+		// The angle is reduced to [-pi/4, pi/4] and evaluated in double precision with Taylor polynomials accurate well below the float precision
+		static void sin_cos(float angle, float& out_sin, float& out_cos)
+		{
+			// pi/2 split in two parts, the product of the first part with any quadrant we use is exact
+			static constexpr double k_half_pi_high = 1.5707963267341256;
+			static constexpr double k_half_pi_low = 6.077100506506192e-11;
+			static constexpr double k_two_over_pi = 0.63661977236758134;
+
+			const double quadrant = std::floor((double(angle) * k_two_over_pi) + 0.5);
+			const double x = (double(angle) - (quadrant * k_half_pi_high)) - (quadrant * k_half_pi_low);
+			const double x2 = x * x;
+
+			const double sin_x = x * (1.0 + x2 * (-1.0 / 6.0 + x2 * (1.0 / 120.0 + x2 * (-1.0 / 5040.0 + x2 * (1.0 / 362880.0 + x2 * (-1.0 / 39916800.0 + x2 * (1.0 / 6227020800.0)))))));
+			const double cos_x = 1.0 + x2 * (-1.0 / 2.0 + x2 * (1.0 / 24.0 + x2 * (-1.0 / 720.0 + x2 * (1.0 / 40320.0 + x2 * (-1.0 / 3628800.0 + x2 * (1.0 / 479001600.0))))));
+
+			// sin(x + n * pi/2) cycles through sin(x), cos(x), -sin(x), -cos(x)
+			switch (static_cast<int64_t>(quadrant) & 3)
+			{
+			case 0:		out_sin = float(sin_x);		out_cos = float(cos_x);		break;
+			case 1:		out_sin = float(cos_x);		out_cos = float(-sin_x);	break;
+			case 2:		out_sin = float(-sin_x);	out_cos = float(-cos_x);	break;
+			default:	out_sin = float(-cos_x);	out_cos = float(sin_x);		break;
+			}
+		}
+
+		struct curve
+		{
+			float amplitude;
+			float frequency;
+			float phase;
+
+			float evaluate(float sample_time) const
+			{
+				float sin_value;
+				float cos_value;
+				sin_cos((frequency * sample_time) + phase, sin_value, cos_value);
+				return amplitude * sin_value;
+			}
+		};
+
+		// The animation of a single bone, a constant bone has zero amplitudes
+		struct bone_animation
+		{
+			vector4 rotation_axis;
+			float rotation_angle;
+			curve rotation_curve;
+
+			vector4 translation;
+			curve translation_curves[3];
+
+			curve scale_curve;
+		};
+
+		static constexpr float k_pi = 3.14159265358979323846F;
+
+		static curve make_curve(random_generator& rng, float max_amplitude)
+		{
+			curve result;
+			result.amplitude = rng.next_float(0.0F, max_amplitude);
+			result.frequency = rng.next_float(0.25F, 4.0F) * 2.0F * k_pi;
+			result.phase = rng.next_float(0.0F, 2.0F * k_pi);
+			return result;
+		}
+
+		static vector4 make_unit_vector(random_generator& rng)
+		{
+			for (;;)
+			{
+				const float x = rng.next_float(-1.0F, 1.0F);
+				const float y = rng.next_float(-1.0F, 1.0F);
+				const float z = rng.next_float(-1.0F, 1.0F);
+				const float length_squared = (x * x) + (y * y) + (z * z);
+
+				// Reject samples outside the unit sphere to keep the distribution uniform
+				if (length_squared > 1.0E-4F && length_squared <= 1.0F)
+				{
+					const float inv_length = 1.0F / std::sqrt(length_squared);
+					return vector4{ x * inv_length, y * inv_length, z * inv_length, 0.0F };
+				}
+			}
+		}
+
+		static bone_animation make_bone_animation(random_generator& rng, bool is_constant)
+		{
+			bone_animation anim;
+			anim.rotation_axis = make_unit_vector(rng);
+			anim.rotation_angle = rng.next_float(-k_pi, k_pi);
+			anim.rotation_curve = make_curve(rng, 0.5F * k_pi);
+
+			const vector4 direction = make_unit_vector(rng);
+			const float bone_length = rng.next_float(1.0F, 50.0F);
+			anim.translation = vector4{ direction.x * bone_length, direction.y * bone_length, direction.z * bone_length, 0.0F };
+
+			for (curve& translation_curve : anim.translation_curves)
+				translation_curve = make_curve(rng, 0.25F * bone_length);
+
+			// A quarter of animated bones have animated scale
+			anim.scale_curve = make_curve(rng, 0.5F);
+			if (rng.next_float() >= 0.25F)
+				anim.scale_curve.amplitude = 0.0F;
+
+			if (is_constant)
+			{
+				anim.rotation_curve.amplitude = 0.0F;
+				for (curve& translation_curve : anim.translation_curves)
+					translation_curve.amplitude = 0.0F;
+				anim.scale_curve.amplitude = 0.0F;
+			}
+
+			return anim;
+		}
+
+		static qvv sample_bone(const bone_animation& anim, float sample_time)
+		{
+			const float half_angle = 0.5F * (anim.rotation_angle + anim.rotation_curve.evaluate(sample_time));
+			float sin_half_angle;
+			float cos_half_angle;
+			sin_cos(half_angle, sin_half_angle, cos_half_angle);
+
+			const float scale = 1.0F + anim.scale_curve.evaluate(sample_time);
+
+			qvv transform;
+			transform.rotation = quat{ anim.rotation_axis.x * sin_half_angle, anim.rotation_axis.y * sin_half_angle, anim.rotation_axis.z * sin_half_angle, cos_half_angle };
+			transform.translation.x = anim.translation.x + anim.translation_curves[0].evaluate(sample_time);
+			transform.translation.y = anim.translation.y + anim.translation_curves[1].evaluate(sample_time);
+			transform.translation.z = anim.translation.z + anim.translation_curves[2].evaluate(sample_time);
+			transform.translation.w = 0.0F;
+			transform.scale = vector4{ scale, scale, scale, 0.0F };
+			return transform;
+		}
+
+		// Builds a random hierarchy where parents always come before their children
+		static std::vector<uint32_t> make_hierarchy(random_generator& rng, uint32_t num_bones, uint32_t hierarchy_depth)
+		{
+			std::vector<uint32_t> parent_indices(num_bones, k_invalid_track_index);
+			std::vector<uint32_t> bone_depths(num_bones, 0);
+
+			// Bones that can still have children without exceeding the maximum depth
+			std::vector<uint32_t> candidate_parents;
+
+			for (uint32_t bone_index = 0; bone_index < num_bones; ++bone_index)
+			{
+				uint32_t parent_index = k_invalid_track_index;
+				if (bone_index != 0 && bone_index < hierarchy_depth)
+					parent_index = bone_index - 1;	// The first bones form a chain that reaches the maximum depth
+				else if (bone_index != 0 && !candidate_parents.empty())
+					parent_index = candidate_parents[rng.next_index(static_cast<uint32_t>(candidate_parents.size()))];
+
+				const uint32_t depth = parent_index != k_invalid_track_index ? (bone_depths[parent_index] + 1) : 0;
+				parent_indices[bone_index] = parent_index;
+				bone_depths[bone_index] = depth;
+
+				if (depth + 1 < hierarchy_depth)
+					candidate_parents.push_back(bone_index);
+			}
+
+			return parent_indices;
+		}
+	}
+
+	bool generate_clip(const generator_settings& settings, track_array& out_tracks)
+	{
+		if (settings.num_bones == 0 || settings.num_samples == 0 || settings.hierarchy_depth == 0)
+			return false;
+
+		if (!(settings.sample_rate > 0.0F) || !(settings.constant_bone_ratio >= 0.0F) || settings.constant_bone_ratio > 1.0F)
+			return false;
+
+		random_generator rng(settings.seed);
+
+		char clip_name[128];
+		snprintf(clip_name, sizeof(clip_name), "synthetic_%ub_%ud_%us_%llu", settings.num_bones, settings.hierarchy_depth, settings.num_samples, static_cast<unsigned long long>(settings.seed));
+
+		metadata_t metadata;
+		metadata.version = acl_version::v02_01_00;
+		metadata.name = clip_name;
+		metadata.track_variant = track_variant_t::transform;
+		metadata.variant.transform = transform_metadata_t();
+		metadata.variant.transform.rotation_format = rotation_format_t::quatf_full;
+		metadata.variant.transform.translation_format = vector_format_t::vector3f_full;
+		metadata.variant.transform.scale_format = vector_format_t::vector3f_full;
+
+		track_array output_tracks(clip_name, metadata);
+
+		const std::vector<uint32_t> parent_indices = make_hierarchy(rng, settings.num_bones, settings.hierarchy_depth);
+
+		for (uint32_t bone_index = 0; bone_index < settings.num_bones; ++bone_index)
+		{
+			// The root always moves, it keeps the clip from being entirely constant
+			const bool is_constant = bone_index != 0 && rng.next_float() < settings.constant_bone_ratio;
+			const bone_animation anim = make_bone_animation(rng, is_constant);
+
+			char bone_name[32];
+			snprintf(bone_name, sizeof(bone_name), "bone_%u", bone_index);
+
+			track bone_track(sample_type::qvv, settings.sample_rate, bone_name);
+
+			transform_track_description& desc = bone_track.get_description().transform;
+			desc.default_value.rotation = quat{ 0.0F, 0.0F, 0.0F, 1.0F };
+			desc.default_value.translation = vector4{ 0.0F, 0.0F, 0.0F, 0.0F };
+			desc.default_value.scale = vector4{ 1.0F, 1.0F, 1.0F, 0.0F };
+			desc.output_index = bone_index;
+			desc.parent_index = parent_indices[bone_index];
+			desc.precision = 0.01F;
+			desc.shell_distance = 3.0F;
+			desc.constant_rotation_threshold_angle = 0.00284714461F;
+			desc.constant_translation_threshold = 0.001F;
+			desc.constant_scale_threshold = 0.00001F;
+			desc.padding = 0;
+
+			for (uint32_t sample_index = 0; sample_index < settings.num_samples; ++sample_index)
+			{
+				const float sample_time = float(sample_index) / settings.sample_rate;
+
+				sample smpl;
+				smpl.transform = sample_bone(anim, sample_time);
+				bone_track.emplace_back(std::move(smpl));
+			}
+
+			output_tracks.emplace_back(std::move(bone_track));
+		}
+
+		out_tracks = std::move(output_tracks);
+		return true;
+	}
+}
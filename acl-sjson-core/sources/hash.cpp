@@ -0,0 +1,285 @@
+////////////////////////////////////////////////////////////////////////////////
+// The MIT License (MIT)
+//
+// Copyright (c) 2022 Nicholas Frechette
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+////////////////////////////////////////////////////////////////////////////////
+
+#include "acl-sjson/hash.h"
+#include "acl-sjson/parallel.h"
+#include "acl-sjson/track.h"
+#include "acl-sjson/track_array.h"
+
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+namespace acl_sjson
+{
+	namespace
+	{
+		static constexpr uint64_t k_prime1 = 0x9E3779B185EBCA87ULL;
+		static constexpr uint64_t k_prime2 = 0xC2B2AE3D27D4EB4FULL;
+		static constexpr uint64_t k_prime3 = 0x165667B19E3779F9ULL;
+		static constexpr uint64_t k_prime4 = 0x85EBCA77C2B2AE63ULL;
+		static constexpr uint64_t k_prime5 = 0x27D4EB2F165667C5ULL;
+
+		static constexpr uint32_t k_stripe_size = 32;
+
+		inline uint64_t rotate_left(uint64_t value, uint32_t shift)
+		{
+			return (value << shift) | (value >> (64 - shift));
+		}
+
+		inline uint64_t read_u64(const uint8_t* data)
+		{
+			uint64_t value;
+			std::memcpy(&value, data, sizeof(value));
+			return value;
+		}
+
+		inline uint32_t read_u32(const uint8_t* data)
+		{
+			uint32_t value;
+			std::memcpy(&value, data, sizeof(value));
+			return value;
+		}
+
+		inline uint64_t round(uint64_t accumulator, uint64_t input)
+		{
+			accumulator += input * k_prime2;
+			accumulator = rotate_left(accumulator, 31);
+			return accumulator * k_prime1;
+		}
+
+		inline uint64_t merge_round(uint64_t hash, uint64_t accumulator)
+		{
+			hash ^= round(0, accumulator);
+			return (hash * k_prime1) + k_prime4;
+		}
+
+		// The four accumulators are independent which lets the CPU process them in parallel
+		inline void consume_stripe(uint64_t* accumulators, const uint8_t* data)
+		{
+			accumulators[0] = round(accumulators[0], read_u64(data + 0));
+			accumulators[1] = round(accumulators[1], read_u64(data + 8));
+			accumulators[2] = round(accumulators[2], read_u64(data + 16));
+			accumulators[3] = round(accumulators[3], read_u64(data + 24));
+		}
+
+		// Maps every track output index to its track index, stripped tracks are skipped
+		static std::vector<uint32_t> get_output_track_order(const track_array& tracks)
+		{
+			const uint32_t num_tracks = static_cast<uint32_t>(tracks.get_num_tracks());
+
+			std::vector<uint32_t> output_order;
+			output_order.reserve(num_tracks);
+
+			for (uint32_t track_index = 0; track_index < num_tracks; ++track_index)
+			{
+				if (tracks[track_index].get_output_index() != k_invalid_track_index)
+					output_order.push_back(track_index);
+			}
+
+			// Tracks are stored in output order in binary files
+			std::stable_sort(output_order.begin(), output_order.end(),
+				[&tracks](uint32_t lhs, uint32_t rhs) { return tracks[lhs].get_output_index() < tracks[rhs].get_output_index(); });
+
+			return output_order;
+		}
+
+		static uint64_t hash_track(const track_array& tracks, uint32_t track_index)
+		{
+			const track& track_ = tracks[track_index];
+			const sample_type type = track_.get_type();
+
+			hasher64 hasher;
+
+			const uint32_t type_value = static_cast<uint32_t>(type);
+			hasher.update(&type_value, sizeof(type_value));
+
+			const uint64_t num_samples = track_.get_num_samples();
+			hasher.update(&num_samples, sizeof(num_samples));
+
+			if (is_transform(type))
+			{
+				const transform_track_description& desc = track_.get_description().transform;
+
+				// Parent indices refer to track indices, use the output index of the parent instead
+				uint32_t parent_output_index = k_invalid_track_index;
+				if (desc.parent_index != k_invalid_track_index && desc.parent_index < tracks.get_num_tracks())
+					parent_output_index = tracks[desc.parent_index].get_description().transform.output_index;
+
+				hasher.update(&parent_output_index, sizeof(parent_output_index));
+			}
+
+			// Only components that hold a value are hashed, readers do not agree on the content of padding
+			const int component_mask = get_component_mask(type);
+			const bool is_packed = (component_mask & (component_mask + 1)) == 0;
+			const size_t sample_size = get_sample_size(type);
+
+			// Collapsed tracks hash every repeated sample, they must match their expanded equivalent
+			for (size_t sample_index = 0; sample_index < num_samples; ++sample_index)
+			{
+				if (is_packed)
+				{
+					hasher.update(&track_[sample_index], sample_size);
+					continue;
+				}
+
+				const uint8_t* components = reinterpret_cast<const uint8_t*>(&track_[sample_index]);
+				uint8_t values[sizeof(sample)];
+				size_t values_size = 0;
+
+				for (uint32_t component_index = 0; component_index * sizeof(float) < sample_size; ++component_index)
+				{
+					if ((component_mask & (1 << component_index)) != 0)
+					{
+						std::memcpy(values + values_size, components + component_index * sizeof(float), sizeof(float));
+						values_size += sizeof(float);
+					}
+				}
+
+				hasher.update(values, values_size);
+			}
+
+			return hasher.digest();
+		}
+	}
+
+	hasher64::hasher64(uint64_t seed)
+		: m_accumulators{ seed + k_prime1 + k_prime2, seed + k_prime2, seed, seed - k_prime1 }
+		, m_seed(seed)
+		, m_total_size(0)
+		, m_buffer()
+		, m_buffer_size(0)
+	{
+	}
+
+	void hasher64::update(const void* data, size_t size)
+	{
+		const uint8_t* data_u8 = static_cast<const uint8_t*>(data);
+		m_total_size += size;
+
+		// Complete a partial stripe first
+		if (m_buffer_size != 0)
+		{
+			const size_t num_bytes = std::min<size_t>(size, k_stripe_size - m_buffer_size);
+			std::memcpy(m_buffer + m_buffer_size, data_u8, num_bytes);
+			m_buffer_size += static_cast<uint32_t>(num_bytes);
+			data_u8 += num_bytes;
+			size -= num_bytes;
+
+			if (m_buffer_size < k_stripe_size)
+				return;
+
+			consume_stripe(m_accumulators, m_buffer);
+			m_buffer_size = 0;
+		}
+
+		for (; size >= k_stripe_size; data_u8 += k_stripe_size, size -= k_stripe_size)
+			consume_stripe(m_accumulators, data_u8);
+
+		if (size != 0)
+		{
+			std::memcpy(m_buffer, data_u8, size);
+			m_buffer_size = static_cast<uint32_t>(size);
+		}
+	}
+
+	uint64_t hasher64::digest() const
+	{
+		uint64_t hash;
+		if (m_total_size >= k_stripe_size)
+		{
+			hash = rotate_left(m_accumulators[0], 1) + rotate_left(m_accumulators[1], 7) + rotate_left(m_accumulators[2], 12) + rotate_left(m_accumulators[3], 18);
+			hash = merge_round(hash, m_accumulators[0]);
+			hash = merge_round(hash, m_accumulators[1]);
+			hash = merge_round(hash, m_accumulators[2]);
+			hash = merge_round(hash, m_accumulators[3]);
+		}
+		else
+			hash = m_seed + k_prime5;
+
+		hash += m_total_size;
+
+		const uint8_t* data = m_buffer;
+		uint32_t size = m_buffer_size;
+
+		for (; size >= 8; data += 8, size -= 8)
+		{
+			hash ^= round(0, read_u64(data));
+			hash = (rotate_left(hash, 27) * k_prime1) + k_prime4;
+		}
+
+		if (size >= 4)
+		{
+			hash ^= uint64_t(read_u32(data)) * k_prime1;
+			hash = (rotate_left(hash, 23) * k_prime2) + k_prime3;
+			data += 4;
+			size -= 4;
+		}
+
+		for (; size != 0; ++data, --size)
+		{
+			hash ^= uint64_t(*data) * k_prime5;
+			hash = rotate_left(hash, 11) * k_prime1;
+		}
+
+		// Final avalanche
+		hash ^= hash >> 33;
+		hash *= k_prime2;
+		hash ^= hash >> 29;
+		hash *= k_prime3;
+		hash ^= hash >> 32;
+		return hash;
+	}
+
+	uint64_t hash64(const void* data, size_t size, uint64_t seed)
+	{
+		hasher64 hasher(seed);
+		hasher.update(data, size);
+		return hasher.digest();
+	}
+
+	uint64_t hash_tracks(const track_array& tracks)
+	{
+		const std::vector<uint32_t> output_order = get_output_track_order(tracks);
+		const size_t num_output_tracks = output_order.size();
+
+		// Every track is hashed independently, their hashes are then combined in output order
+		std::vector<uint64_t> track_hashes(num_output_tracks);
+		const size_t work_per_track = tracks.get_num_samples_per_track() * sizeof(sample);
+		parallel_for(num_output_tracks, work_per_track, [&](size_t output_index)
+			{
+				track_hashes[output_index] = hash_track(tracks, output_order[output_index]);
+			});
+
+		hasher64 hasher;
+
+		const float sample_rate = tracks.get_sample_rate();
+		const uint64_t num_tracks = num_output_tracks;
+		hasher.update(&sample_rate, sizeof(sample_rate));
+		hasher.update(&num_tracks, sizeof(num_tracks));
+		hasher.update(track_hashes.data(), track_hashes.size() * sizeof(uint64_t));
+
+		return hasher.digest();
+	}
+}
@@ -0,0 +1,166 @@
+////////////////////////////////////////////////////////////////////////////////
+// The MIT License (MIT)
+//
+// Copyright (c) 2022 Nicholas Frechette
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+////////////////////////////////////////////////////////////////////////////////
+
+#include "acl-sjson/hierarchy.h"
+#include "acl-sjson/track.h"
+#include "acl-sjson/track_array.h"
+
+#include <utility>
+
+namespace acl_sjson
+{
+	namespace
+	{
+		// The children of every track in track order, stored contiguously per parent
+		struct hierarchy_children
+		{
+			std::vector<uint32_t> roots;
+			std::vector<uint32_t> children;
+
+			// The children of a track are within [first_child[track_index], first_child[track_index + 1])
+			std::vector<uint32_t> first_child;
+		};
+
+		static bool build_children(const track_array& tracks, hierarchy_children& out_children)
+		{
+			const uint32_t num_tracks = static_cast<uint32_t>(tracks.get_num_tracks());
+			const bool has_hierarchy = is_transform(tracks.get_type());
+
+			const auto get_parent_index = [&](uint32_t track_index) { return has_hierarchy ? tracks[track_index].get_description().transform.parent_index : k_invalid_track_index; };
+
+			std::vector<uint32_t> first_child(num_tracks + 1, 0);
+			for (uint32_t track_index = 0; track_index < num_tracks; ++track_index)
+			{
+				const uint32_t parent_index = get_parent_index(track_index);
+				if (parent_index == k_invalid_track_index)
+					out_children.roots.push_back(track_index);
+				else if (parent_index >= num_tracks || parent_index == track_index)
+					return false;
+				else
+					++first_child[parent_index + 1];
+			}
+
+			for (uint32_t track_index = 0; track_index < num_tracks; ++track_index)
+				first_child[track_index + 1] += first_child[track_index];
+
+			std::vector<uint32_t> children(first_child[num_tracks]);
+			std::vector<uint32_t> num_children(num_tracks, 0);
+			for (uint32_t track_index = 0; track_index < num_tracks; ++track_index)
+			{
+				const uint32_t parent_index = get_parent_index(track_index);
+				if (parent_index != k_invalid_track_index)
+					children[first_child[parent_index] + num_children[parent_index]++] = track_index;
+			}
+
+			out_children.children = std::move(children);
+			out_children.first_child = std::move(first_child);
+			return true;
+		}
+	}
+
+	const char* to_string(hierarchy_order order)
+	{
+		switch (order)
+		{
+		case hierarchy_order::breadth_first:	return "breadth first";
+		case hierarchy_order::depth_first:		return "depth first";
+		default:								return "unknown";
+		}
+	}
+
+	bool get_topological_order(const track_array& tracks, hierarchy_order order, std::vector<uint32_t>& out_order)
+	{
+		hierarchy_children hierarchy;
+		if (!build_children(tracks, hierarchy))
+			return false;
+
+		const std::vector<uint32_t>& children = hierarchy.children;
+		const std::vector<uint32_t>& first_child = hierarchy.first_child;
+
+		std::vector<uint32_t> result;
+		result.reserve(tracks.get_num_tracks());
+
+		if (order == hierarchy_order::depth_first)
+		{
+			// Children are pushed in reverse to be visited in track order
+			std::vector<uint32_t> pending(hierarchy.roots.rbegin(), hierarchy.roots.rend());
+			while (!pending.empty())
+			{
+				const uint32_t track_index = pending.back();
+				pending.pop_back();
+
+				result.push_back(track_index);
+				pending.insert(pending.end(), children.rbegin() + (children.size() - first_child[track_index + 1]), children.rbegin() + (children.size() - first_child[track_index]));
+			}
+		}
+		else
+		{
+			// Every root at once, the result doubles as our queue
+			result = hierarchy.roots;
+			for (size_t result_index = 0; result_index < result.size(); ++result_index)
+			{
+				const uint32_t track_index = result[result_index];
+				result.insert(result.end(), children.begin() + first_child[track_index], children.begin() + first_child[track_index + 1]);
+			}
+		}
+
+		// Tracks on a cycle are never reached from a root
+		if (result.size() != tracks.get_num_tracks())
+			return false;
+
+		out_order = std::move(result);
+		return true;
+	}
+
+	bool reorder_hierarchy(track_array& tracks, hierarchy_order order)
+	{
+		if (!is_transform(tracks.get_type()))
+			return true;
+
+		std::vector<uint32_t> new_order;
+		if (!get_topological_order(tracks, order, new_order))
+			return false;
+
+		const uint32_t num_tracks = static_cast<uint32_t>(tracks.get_num_tracks());
+
+		std::vector<uint32_t> new_indices(num_tracks);
+		for (uint32_t new_index = 0; new_index < num_tracks; ++new_index)
+			new_indices[new_order[new_index]] = new_index;
+
+		track_array output_tracks(tracks.get_name(), tracks.get_metadata());
+		for (const uint32_t track_index : new_order)
+		{
+			track& track_ = tracks[track_index];
+
+			uint32_t& parent_index = track_.get_description().transform.parent_index;
+			if (parent_index != k_invalid_track_index)
+				parent_index = new_indices[parent_index];
+
+			output_tracks.emplace_back(std::move(track_));
+		}
+
+		tracks = std::move(output_tracks);
+		return true;
+	}
+}
@@ -0,0 +1,157 @@
+#pragma once
+
+////////////////////////////////////////////////////////////////////////////////
+// The MIT License (MIT)
+//
+// Copyright (c) 2022 Nicholas Frechette
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+////////////////////////////////////////////////////////////////////////////////
+
+#include "acl-sjson/sample.h"
+#include "acl-sjson/sample_interpolation.h"
+#include "acl-sjson/sample_traits.h"
+#include "acl-sjson/track.h"
+
+#include "sample_math.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstring>
+
+// Internal sampling helpers shared by track, track_array, and resample
+namespace acl_sjson
+{
+	// The two samples surrounding a position and how far the position is between them
+	struct interpolation_keys
+	{
+		size_t key0;
+		size_t key1;
+		float alpha;
+	};
+
+	// Finds the samples surrounding a position expressed in samples (time * sample_rate)
+	// Positions within rounding error of a sample snap to it, the sample is then retained bit for bit
+	inline interpolation_keys find_interpolation_keys(size_t num_samples, float position, sample_wrap_policy wrap_policy)
+	{
+		interpolation_keys keys = { 0, 0, 0.0F };
+		if (num_samples <= 1)
+			return keys;
+
+		const size_t last_sample_index = num_samples - 1;
+
+		if (wrap_policy == sample_wrap_policy::clamp)
+		{
+			// NaN fails both comparisons and lands on the first sample
+			position = position > 0.0F ? std::min(position, float(last_sample_index)) : 0.0F;
+		}
+		else
+		{
+			// Looping clips repeat their first sample at the end, the period is one sample shorter
+			const float period = float(wrap_policy == sample_wrap_policy::loop ? last_sample_index : num_samples);
+
+			position = std::isfinite(position) ? std::fmod(position, period) : 0.0F;
+			if (position < 0.0F)
+				position += period;
+		}
+
+		const float nearest_position = std::round(position);
+		if (std::fabs(position - nearest_position) < 1.0E-4F)
+			position = nearest_position;
+
+		if (wrap_policy == sample_wrap_policy::wrap)
+		{
+			// The last sample interpolates back to the first
+			keys.key0 = static_cast<size_t>(position) % num_samples;
+			keys.key1 = (keys.key0 + 1) % num_samples;
+			keys.alpha = position - std::floor(position);
+		}
+		else
+		{
+			keys.key0 = std::min<size_t>(static_cast<size_t>(position), last_sample_index);
+			keys.key1 = std::min<size_t>(keys.key0 + 1, last_sample_index);
+			keys.alpha = std::min(position - float(keys.key0), 1.0F);
+		}
+
+		return keys;
+	}
+
+	// Interpolates two samples, every value is linearly interpolated
+	template<sample_type type>
+	inline sample interpolate_sample(const sample& start, const sample& end, float alpha, rotation_interpolation interpolation)
+	{
+		static_assert(sample_traits<type>::k_num_components <= 4, "Scalar samples are interpolated 4 components at a time");
+		(void)interpolation;
+
+		sample result;
+		math::lerp4(&start.f4.x, &end.f4.x, alpha, &result.f4.x);
+		return result;
+	}
+
+	template<>
+	inline sample interpolate_sample<sample_type::quat>(const sample& start, const sample& end, float alpha, rotation_interpolation interpolation)
+	{
+		sample result;
+		result.q = interpolation == rotation_interpolation::slerp ? math::quat_slerp(start.q, end.q, alpha) : math::quat_nlerp(start.q, end.q, alpha);
+		return result;
+	}
+
+	template<>
+	inline sample interpolate_sample<sample_type::qvv>(const sample& start, const sample& end, float alpha, rotation_interpolation interpolation)
+	{
+		sample result;
+		result.transform.rotation = interpolation == rotation_interpolation::slerp ? math::quat_slerp(start.transform.rotation, end.transform.rotation, alpha) : math::quat_nlerp(start.transform.rotation, end.transform.rotation, alpha);
+		result.transform.translation = math::vector_lerp(start.transform.translation, end.transform.translation, alpha);
+		result.transform.scale = math::vector_lerp(start.transform.scale, end.transform.scale, alpha);
+		return result;
+	}
+
+	// Samples a track with keys found by find_interpolation_keys(..)
+	// Exact keys and constant tracks are retained bit for bit
+	template<sample_type type>
+	inline sample sample_track(const track& track_, const interpolation_keys& keys, rotation_interpolation interpolation)
+	{
+		if (keys.alpha == 0.0F || keys.key0 == keys.key1 || track_.is_collapsed())
+			return track_[keys.key0];
+
+		return interpolate_sample<type>(track_[keys.key0], track_[keys.key1], keys.alpha, interpolation);
+	}
+
+	// Samples a track once its sample type is known, see visit_sample_type(..)
+	struct sample_track_functor
+	{
+		const track& track_;
+		const interpolation_keys& keys;
+		rotation_interpolation interpolation;
+
+		sample operator()(sample_traits<sample_type::unknown>) const
+		{
+			sample result;
+			std::memset(&result, 0, sizeof(result));
+			return result;
+		}
+
+		template<typename traits_type>
+		sample operator()(traits_type) const
+		{
+			return sample_track<traits_type::k_type>(track_, keys, interpolation);
+		}
+	};
+}
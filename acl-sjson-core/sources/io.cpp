@@ -23,12 +23,23 @@
 ////////////////////////////////////////////////////////////////////////////////
 
 #include "acl-sjson/io.h"
+#include "acl-sjson/memory_tracker.h"
 
+#include <algorithm>
+#include <cerrno>
 #include <cstdint>
 #include <cstdio>
 #include <cstdlib>
 #include <cstring>
 
+#ifdef _WIN32
+	#define WIN32_LEAN_AND_MEAN
+	#include <windows.h>
+#else
+	#include <dirent.h>
+	#include <sys/stat.h>
+#endif
+
 namespace acl_sjson
 {
 	static char* align_to(char* value, std::size_t alignment)
@@ -89,12 +100,20 @@ namespace acl_sjson
 
 		// Allocate an extra 128 bytes
 		// We'll align to 64 bytes and store the padding at the start of the allocation in the preceding 4 bytes
-		char* buffer = static_cast<char*>(malloc(out_file_size + 128));
+		// The memory phase is stored in the 4 bytes before it and the allocation size in the 8 bytes before that
+		const std::size_t allocation_size = out_file_size + 128;
+		char* buffer = static_cast<char*>(malloc(allocation_size));
 		out_buffer = align_to(buffer + 64, 64);
 
 		uint32_t* allocation_padding = reinterpret_cast<uint32_t*>(out_buffer - sizeof(uint32_t));
 		*allocation_padding = static_cast<uint32_t>(out_buffer - buffer);
 
+		uint32_t* allocation_phase = reinterpret_cast<uint32_t*>(out_buffer - (2 * sizeof(uint32_t)));
+		*allocation_phase = static_cast<uint32_t>(track_allocation(allocation_size));
+
+		uint64_t* allocation_size_ptr = reinterpret_cast<uint64_t*>(out_buffer - (2 * sizeof(uint32_t)) - sizeof(uint64_t));
+		*allocation_size_ptr = allocation_size;
+
 		const std::size_t result = fread(out_buffer, 1, out_file_size, file);
 		fclose(file);
 
@@ -114,10 +133,148 @@ namespace acl_sjson
 			return; // Nothing to do
 
 		const uint32_t* allocation_padding = reinterpret_cast<const uint32_t*>(buffer - sizeof(uint32_t));
+		const uint32_t* allocation_phase = reinterpret_cast<const uint32_t*>(buffer - (2 * sizeof(uint32_t)));
+		const uint64_t* allocation_size = reinterpret_cast<const uint64_t*>(buffer - (2 * sizeof(uint32_t)) - sizeof(uint64_t));
+		track_deallocation(static_cast<memory_phase>(*allocation_phase), static_cast<std::size_t>(*allocation_size));
+
 		char* ptr = buffer - *allocation_padding;
 		free(ptr);
 	}
 
+	static bool list_files_impl(const std::string& directory, bool recursive, std::vector<std::string>& out_filenames)
+	{
+#ifdef _WIN32
+		const std::string pattern = directory + "\\*";
+
+		WIN32_FIND_DATAA find_data;
+		HANDLE find_handle = FindFirstFileA(pattern.c_str(), &find_data);
+		if (find_handle == INVALID_HANDLE_VALUE)
+		{
+			printf("Failed to open directory: %s\n", directory.c_str());
+			return false;
+		}
+
+		bool success = true;
+		do
+		{
+			if (std::strcmp(find_data.cFileName, ".") == 0 || std::strcmp(find_data.cFileName, "..") == 0)
+				continue;
+
+			const std::string path = directory + "\\" + find_data.cFileName;
+			if ((find_data.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) != 0)
+			{
+				// Junctions and symbolic links to directories can form cycles, they are not followed
+				if (recursive && (find_data.dwFileAttributes & FILE_ATTRIBUTE_REPARSE_POINT) == 0)
+					success &= list_files_impl(path, recursive, out_filenames);
+			}
+			else
+				out_filenames.push_back(path);
+		} while (FindNextFileA(find_handle, &find_data) != 0);
+
+		FindClose(find_handle);
+		return success;
+#else
+		DIR* dir = opendir(directory.c_str());
+		if (dir == nullptr)
+		{
+			printf("Failed to open directory: %s\n", directory.c_str());
+			return false;
+		}
+
+		bool success = true;
+		for (const dirent* entry = readdir(dir); entry != nullptr; entry = readdir(dir))
+		{
+			if (std::strcmp(entry->d_name, ".") == 0 || std::strcmp(entry->d_name, "..") == 0)
+				continue;
+
+			const std::string path = directory + "/" + entry->d_name;
+
+			// Not every file system provides the entry type, fall back to lstat
+			struct stat path_stat;
+			if (lstat(path.c_str(), &path_stat) != 0)
+				continue;
+
+			// Symbolic links to files are listed but links to directories can form cycles, they are not followed
+			if (S_ISLNK(path_stat.st_mode) && (stat(path.c_str(), &path_stat) != 0 || S_ISDIR(path_stat.st_mode)))
+				continue;
+
+			if (S_ISDIR(path_stat.st_mode))
+			{
+				if (recursive)
+					success &= list_files_impl(path, recursive, out_filenames);
+			}
+			else if (S_ISREG(path_stat.st_mode))
+				out_filenames.push_back(path);
+		}
+
+		closedir(dir);
+		return success;
+#endif
+	}
+
+	bool list_files(const char* directory, bool recursive, std::vector<std::string>& out_filenames)
+	{
+		std::string directory_path = directory;
+
+		// Strip trailing separators, we add our own
+		while (directory_path.size() > 1 && (directory_path.back() == '/' || directory_path.back() == '\\'))
+			directory_path.pop_back();
+
+		std::vector<std::string> filenames;
+		if (!list_files_impl(directory_path, recursive, filenames))
+			return false;
+
+		// Directory iteration order is file system dependent
+		std::sort(filenames.begin(), filenames.end());
+
+		out_filenames = std::move(filenames);
+		return true;
+	}
+
+	bool create_directory(const char* directory)
+	{
+		const std::string directory_path = directory;
+
+		// Every parent is created in turn, a leading separator is the root and not a directory to create
+		for (size_t separator_offset = directory_path.find_first_of("/\\", 1); ; separator_offset = directory_path.find_first_of("/\\", separator_offset + 1))
+		{
+			const std::string path = directory_path.substr(0, separator_offset);
+
+#ifdef _WIN32
+			const bool is_created = CreateDirectoryA(path.c_str(), nullptr) != 0 || GetLastError() == ERROR_ALREADY_EXISTS;
+#else
+			const bool is_created = mkdir(path.c_str(), 0755) == 0 || errno == EEXIST;
+#endif
+
+			if (separator_offset == std::string::npos)
+			{
+				if (!is_created)
+				{
+					printf("Failed to create directory: %s\n", directory);
+					return false;
+				}
+
+				break;
+			}
+		}
+
+#ifdef _WIN32
+		const DWORD attributes = GetFileAttributesA(directory);
+		const bool is_directory = attributes != INVALID_FILE_ATTRIBUTES && (attributes & FILE_ATTRIBUTE_DIRECTORY) != 0;
+#else
+		struct stat path_stat;
+		const bool is_directory = stat(directory, &path_stat) == 0 && S_ISDIR(path_stat.st_mode);
+#endif
+
+		if (!is_directory)
+		{
+			printf("Output path is not a directory: %s\n", directory);
+			return false;
+		}
+
+		return true;
+	}
+
 	bool is_acl_bin_file(const char* filename)
 	{
 		const size_t filename_len = filename != nullptr ? std::strlen(filename) : 0;
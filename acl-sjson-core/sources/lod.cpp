@@ -0,0 +1,249 @@
+////////////////////////////////////////////////////////////////////////////////
+// The MIT License (MIT)
+//
+// Copyright (c) 2022 Nicholas Frechette
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+////////////////////////////////////////////////////////////////////////////////
+
+#include "acl-sjson/hierarchy.h"
+#include "acl-sjson/lod.h"
+#include "acl-sjson/track.h"
+#include "acl-sjson/track_array.h"
+
+#include "sjson_reader.h"
+
+#include <sjson/parser.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <utility>
+
+namespace acl_sjson
+{
+	namespace
+	{
+		static bool is_wildcard_match(const char* pattern, const char* value)
+		{
+			// On a mismatch, the last '*' absorbs one more character and matching resumes after it
+			const char* star_pattern = nullptr;
+			const char* star_value = nullptr;
+
+			while (*value != '\0')
+			{
+				if (*pattern == '*')
+				{
+					star_pattern = ++pattern;
+					star_value = value;
+				}
+				else if (*pattern == '?' || *pattern == *value)
+				{
+					++pattern;
+					++value;
+				}
+				else if (star_pattern != nullptr)
+				{
+					pattern = star_pattern;
+					value = ++star_value;
+				}
+				else
+					return false;
+			}
+
+			while (*pattern == '*')
+				++pattern;
+
+			return *pattern == '\0';
+		}
+
+		static void copy_track(const track& input_track, track& output_track)
+		{
+			output_track.get_description() = input_track.get_description();
+
+			// Collapsed tracks remain collapsed, their single sample is repeated
+			const size_t num_samples = input_track.get_num_samples();
+			output_track.reserve(num_samples);
+			for (size_t sample_index = 0; sample_index < num_samples; ++sample_index)
+			{
+				sample smpl = input_track[sample_index];
+				output_track.emplace_back(std::move(smpl));
+			}
+		}
+	}
+
+	bool read_lod_variants(const char* filename, std::vector<lod_variant_t>& out_variants)
+	{
+		std::vector<lod_variant_t> variants;
+		const auto parse_root = [filename, &variants](sjson::Parser& parser)
+		{
+			if (!parser.array_begins("variants"))
+				return false;
+
+			while (!parser.try_array_ends())
+			{
+				if (!parser.object_begins())
+					return false;
+
+				lod_variant_t variant;
+
+				sjson::StringView name;
+				if (!parser.read("name", name))
+					return false;
+
+				if (name.size() == 0)
+				{
+					printf("Every variant requires a name in %s\n", filename);
+					return false;
+				}
+
+				variant.name.assign(name.c_str(), name.size());
+
+				double max_depth = -1.0;
+				parser.try_read("max_depth", max_depth, -1.0);
+				if (!parser.is_valid())
+					return false;
+
+				if (max_depth != -1.0)
+				{
+					if (!(max_depth >= 0.0) || max_depth >= double(k_invalid_track_index))
+					{
+						printf("Invalid 'max_depth' for variant '%s' in %s\n", variant.name.c_str(), filename);
+						return false;
+					}
+
+					variant.max_depth = static_cast<uint32_t>(max_depth);
+				}
+
+				if (!read_strings(parser, "strip_patterns", false, variant.stripped_name_patterns))
+					return false;
+
+				if (!read_strings(parser, "strip_tracks", false, variant.stripped_track_names))
+					return false;
+
+				if (!parser.object_ends())
+					return false;
+
+				for (const lod_variant_t& other_variant : variants)
+				{
+					if (other_variant.name == variant.name)
+					{
+						printf("Variant '%s' is provided more than once in %s\n", variant.name.c_str(), filename);
+						return false;
+					}
+				}
+
+				variants.push_back(std::move(variant));
+			}
+
+			return parser.is_valid();
+		};
+
+		if (!parse_sjson_file(filename, parse_root))
+			return false;
+
+		out_variants = std::move(variants);
+		return true;
+	}
+
+	bool make_lod_variant(const track_array& tracks, const lod_variant_t& variant, track_array& out_variant)
+	{
+		const uint32_t num_tracks = static_cast<uint32_t>(tracks.get_num_tracks());
+		const bool has_hierarchy = is_transform(tracks.get_type());
+
+		std::vector<char> is_stripped(num_tracks, 0);
+
+		for (const std::string& track_name : variant.stripped_track_names)
+		{
+			const uint32_t track_index = tracks.find(track_name.c_str());
+			if (track_index == k_invalid_track_index)
+			{
+				printf("Track '%s' stripped by variant '%s' not found\n", track_name.c_str(), variant.name.c_str());
+				return false;
+			}
+
+			is_stripped[track_index] = 1;
+		}
+
+		for (uint32_t track_index = 0; track_index < num_tracks; ++track_index)
+		{
+			for (const std::string& pattern : variant.stripped_name_patterns)
+			{
+				if (is_wildcard_match(pattern.c_str(), tracks[track_index].get_name()))
+					is_stripped[track_index] = 1;
+			}
+		}
+
+		if (has_hierarchy)
+		{
+			// Parents are visited first, depths and stripping flow down to their descendants
+			std::vector<uint32_t> order;
+			if (!get_topological_order(tracks, hierarchy_order::breadth_first, order))
+			{
+				printf("Cannot strip tracks from variant '%s', the hierarchy is invalid\n", variant.name.c_str());
+				return false;
+			}
+
+			std::vector<uint32_t> depths(num_tracks, 0);
+			for (const uint32_t track_index : order)
+			{
+				const uint32_t parent_index = tracks[track_index].get_description().transform.parent_index;
+				if (parent_index != k_invalid_track_index)
+				{
+					depths[track_index] = depths[parent_index] + 1;
+					is_stripped[track_index] |= is_stripped[parent_index];
+				}
+
+				if (depths[track_index] > variant.max_depth)
+					is_stripped[track_index] = 1;
+			}
+		}
+
+		track_array output_tracks(tracks.get_name(), tracks.get_metadata());
+		for (uint32_t track_index = 0; track_index < num_tracks; ++track_index)
+		{
+			const track& input_track = tracks[track_index];
+
+			track output_track(input_track.get_type(), input_track.get_sample_rate(), input_track.get_name());
+			copy_track(input_track, output_track);
+
+			if (is_stripped[track_index] != 0)
+				output_track.set_output_index(k_invalid_track_index);
+
+			output_tracks.emplace_back(std::move(output_track));
+		}
+
+		// Remaining outputs retain their relative order, sorted by their original output index
+		std::vector<uint32_t> output_order;
+		for (uint32_t track_index = 0; track_index < num_tracks; ++track_index)
+		{
+			if (output_tracks[track_index].get_output_index() != k_invalid_track_index)
+				output_order.push_back(track_index);
+		}
+
+		std::stable_sort(output_order.begin(), output_order.end(),
+			[&output_tracks](uint32_t lhs, uint32_t rhs) { return output_tracks[lhs].get_output_index() < output_tracks[rhs].get_output_index(); });
+
+		for (uint32_t output_index = 0; output_index < output_order.size(); ++output_index)
+			output_tracks[output_order[output_index]].set_output_index(output_index);
+
+		out_variant = std::move(output_tracks);
+		return true;
+	}
+}
@@ -0,0 +1,145 @@
+////////////////////////////////////////////////////////////////////////////////
+// The MIT License (MIT)
+//
+// Copyright (c) 2022 Nicholas Frechette
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+////////////////////////////////////////////////////////////////////////////////
+
+#include "acl-sjson/memory_tracker.h"
+
+#include <atomic>
+
+namespace acl_sjson
+{
+	namespace
+	{
+		struct atomic_memory_stats
+		{
+			std::atomic<uint64_t> live_bytes;
+			std::atomic<uint64_t> peak_live_bytes;
+			std::atomic<uint64_t> num_allocations;
+			std::atomic<uint64_t> total_allocated_bytes;
+			std::atomic<uint64_t> allocation_size_histogram[k_num_allocation_size_buckets];
+		};
+
+		// Zero initialized before any code runs since they have static storage duration
+		static atomic_memory_stats s_phase_stats[static_cast<uint32_t>(memory_phase::count)];
+		static atomic_memory_stats s_total_stats;
+
+		static thread_local memory_phase s_current_phase = memory_phase::other;
+
+		static uint32_t get_size_bucket(size_t size)
+		{
+			uint32_t bucket = 0;
+			while (size > 1 && bucket + 1 < k_num_allocation_size_buckets)
+			{
+				size >>= 1;
+				++bucket;
+			}
+
+			return bucket;
+		}
+
+		static void record_allocation(atomic_memory_stats& stats, size_t size, uint32_t bucket)
+		{
+			const uint64_t live_bytes = stats.live_bytes.fetch_add(size, std::memory_order_relaxed) + size;
+
+			uint64_t peak_live_bytes = stats.peak_live_bytes.load(std::memory_order_relaxed);
+			while (live_bytes > peak_live_bytes && !stats.peak_live_bytes.compare_exchange_weak(peak_live_bytes, live_bytes, std::memory_order_relaxed))
+			{
+				// peak_live_bytes was updated with the latest value, try again
+			}
+
+			stats.num_allocations.fetch_add(1, std::memory_order_relaxed);
+			stats.total_allocated_bytes.fetch_add(size, std::memory_order_relaxed);
+			stats.allocation_size_histogram[bucket].fetch_add(1, std::memory_order_relaxed);
+		}
+
+		static memory_stats load_stats(const atomic_memory_stats& stats)
+		{
+			memory_stats result;
+			result.live_bytes = stats.live_bytes.load(std::memory_order_relaxed);
+			result.peak_live_bytes = stats.peak_live_bytes.load(std::memory_order_relaxed);
+			result.num_allocations = stats.num_allocations.load(std::memory_order_relaxed);
+			result.total_allocated_bytes = stats.total_allocated_bytes.load(std::memory_order_relaxed);
+
+			for (uint32_t bucket = 0; bucket < k_num_allocation_size_buckets; ++bucket)
+				result.allocation_size_histogram[bucket] = stats.allocation_size_histogram[bucket].load(std::memory_order_relaxed);
+
+			return result;
+		}
+	}
+
+	const char* to_string(memory_phase phase)
+	{
+		switch (phase)
+		{
+		case memory_phase::other:		return "other";
+		case memory_phase::read:		return "read";
+		case memory_phase::convert:		return "convert";
+		case memory_phase::compress:	return "compress";
+		case memory_phase::write:		return "write";
+		default:						return "<Invalid memory phase>";
+		}
+	}
+
+	memory_phase get_memory_phase()
+	{
+		return s_current_phase;
+	}
+
+	scoped_memory_phase::scoped_memory_phase(memory_phase phase)
+		: m_previous_phase(s_current_phase)
+	{
+		s_current_phase = phase;
+	}
+
+	scoped_memory_phase::~scoped_memory_phase()
+	{
+		s_current_phase = m_previous_phase;
+	}
+
+	memory_phase track_allocation(size_t size)
+	{
+		const memory_phase phase = s_current_phase;
+		const uint32_t bucket = get_size_bucket(size);
+
+		record_allocation(s_phase_stats[static_cast<uint32_t>(phase)], size, bucket);
+		record_allocation(s_total_stats, size, bucket);
+
+		return phase;
+	}
+
+	void track_deallocation(memory_phase phase, size_t size)
+	{
+		s_phase_stats[static_cast<uint32_t>(phase)].live_bytes.fetch_sub(size, std::memory_order_relaxed);
+		s_total_stats.live_bytes.fetch_sub(size, std::memory_order_relaxed);
+	}
+
+	memory_stats get_memory_stats(memory_phase phase)
+	{
+		return load_stats(s_phase_stats[static_cast<uint32_t>(phase)]);
+	}
+
+	memory_stats get_total_memory_stats()
+	{
+		return load_stats(s_total_stats);
+	}
+}
@@ -0,0 +1,302 @@
+////////////////////////////////////////////////////////////////////////////////
+// The MIT License (MIT)
+//
+// Copyright (c) 2022 Nicholas Frechette
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+////////////////////////////////////////////////////////////////////////////////
+
+#include "acl-sjson/hierarchy.h"
+#include "acl-sjson/object_space.h"
+#include "acl-sjson/parallel.h"
+#include "acl-sjson/track.h"
+#include "acl-sjson/track_array.h"
+
+#include "sample_math.h"
+
+#include <algorithm>
+#include <limits>
+
+namespace acl_sjson
+{
+	namespace
+	{
+		static constexpr size_t k_no_parent = std::numeric_limits<size_t>::max();
+
+		// The number of samples processed by a parallel work item, every transform is computed for them in turn
+		static constexpr size_t k_num_samples_per_block = 64;
+
+		// Up to 4 transforms composed together, one per lane
+		// Offsets index the component arrays of the output, see object_space_transforms
+		struct transform_batch
+		{
+			const qvv* locals[4];
+			size_t parent_offsets[4];
+			size_t output_offsets[4];
+			uint32_t num_lanes;
+		};
+
+		static void gather_local(const qvv& transform, uint32_t lane_index, float (&out_values)[k_num_qvv_components][4])
+		{
+			out_values[0][lane_index] = transform.rotation.x;
+			out_values[1][lane_index] = transform.rotation.y;
+			out_values[2][lane_index] = transform.rotation.z;
+			out_values[3][lane_index] = transform.rotation.w;
+			out_values[4][lane_index] = transform.translation.x;
+			out_values[5][lane_index] = transform.translation.y;
+			out_values[6][lane_index] = transform.translation.z;
+			out_values[7][lane_index] = transform.scale.x;
+			out_values[8][lane_index] = transform.scale.y;
+			out_values[9][lane_index] = transform.scale.z;
+		}
+
+		// Composes local transforms with their object space parent: the local transform applies first
+		// Matches rtm::qvv_mul(local, parent) when scale is positive
+		static void compose(const math::float4_lanes (&local)[k_num_qvv_components], const math::float4_lanes (&parent)[k_num_qvv_components], math::float4_lanes (&out_result)[k_num_qvv_components])
+		{
+			using namespace math;
+
+			const float4_lanes& lx = local[0];
+			const float4_lanes& ly = local[1];
+			const float4_lanes& lz = local[2];
+			const float4_lanes& lw = local[3];
+			const float4_lanes& px = parent[0];
+			const float4_lanes& py = parent[1];
+			const float4_lanes& pz = parent[2];
+			const float4_lanes& pw = parent[3];
+
+			// rotation = quat_mul(local, parent)
+			out_result[0] = lanes_sub(lanes_add(lanes_add(lanes_mul(pw, lx), lanes_mul(px, lw)), lanes_mul(py, lz)), lanes_mul(pz, ly));
+			out_result[1] = lanes_add(lanes_add(lanes_sub(lanes_mul(pw, ly), lanes_mul(px, lz)), lanes_mul(py, lw)), lanes_mul(pz, lx));
+			out_result[2] = lanes_add(lanes_sub(lanes_add(lanes_mul(pw, lz), lanes_mul(px, ly)), lanes_mul(py, lx)), lanes_mul(pz, lw));
+			out_result[3] = lanes_sub(lanes_sub(lanes_sub(lanes_mul(pw, lw), lanes_mul(px, lx)), lanes_mul(py, ly)), lanes_mul(pz, lz));
+
+			// translation = quat_mul_vector3(local translation * parent scale, parent rotation) + parent translation
+			const float4_lanes vx = lanes_mul(local[4], parent[7]);
+			const float4_lanes vy = lanes_mul(local[5], parent[8]);
+			const float4_lanes vz = lanes_mul(local[6], parent[9]);
+
+			// t = 2 * cross(q, v), v' = v + w * t + cross(q, t)
+			const float4_lanes two = lanes_set(2.0F);
+			const float4_lanes tx = lanes_mul(two, lanes_sub(lanes_mul(py, vz), lanes_mul(pz, vy)));
+			const float4_lanes ty = lanes_mul(two, lanes_sub(lanes_mul(pz, vx), lanes_mul(px, vz)));
+			const float4_lanes tz = lanes_mul(two, lanes_sub(lanes_mul(px, vy), lanes_mul(py, vx)));
+
+			out_result[4] = lanes_add(lanes_add(lanes_add(vx, lanes_mul(pw, tx)), lanes_sub(lanes_mul(py, tz), lanes_mul(pz, ty))), parent[4]);
+			out_result[5] = lanes_add(lanes_add(lanes_add(vy, lanes_mul(pw, ty)), lanes_sub(lanes_mul(pz, tx), lanes_mul(px, tz))), parent[5]);
+			out_result[6] = lanes_add(lanes_add(lanes_add(vz, lanes_mul(pw, tz)), lanes_sub(lanes_mul(px, ty), lanes_mul(py, tx))), parent[6]);
+
+			// scale = local scale * parent scale
+			out_result[7] = lanes_mul(local[7], parent[7]);
+			out_result[8] = lanes_mul(local[8], parent[8]);
+			out_result[9] = lanes_mul(local[9], parent[9]);
+		}
+
+		static void compose_batch(const transform_batch& batch, float* const (&components)[k_num_qvv_components])
+		{
+			// Roots are composed with the identity, it leaves them unchanged
+			static const float k_identity[k_num_qvv_components] = { 0.0F, 0.0F, 0.0F, 1.0F, 0.0F, 0.0F, 0.0F, 1.0F, 1.0F, 1.0F };
+
+			// Unused lanes repeat the first lane
+			float local_values[k_num_qvv_components][4];
+			float parent_values[k_num_qvv_components][4];
+			for (uint32_t lane_index = 0; lane_index < 4; ++lane_index)
+			{
+				const uint32_t source_lane_index = lane_index < batch.num_lanes ? lane_index : 0;
+				gather_local(*batch.locals[source_lane_index], lane_index, local_values);
+
+				const size_t parent_offset = batch.parent_offsets[source_lane_index];
+				for (uint32_t component_index = 0; component_index < k_num_qvv_components; ++component_index)
+					parent_values[component_index][lane_index] = parent_offset != k_no_parent ? components[component_index][parent_offset] : k_identity[component_index];
+			}
+
+			math::float4_lanes local[k_num_qvv_components];
+			math::float4_lanes parent[k_num_qvv_components];
+			for (uint32_t component_index = 0; component_index < k_num_qvv_components; ++component_index)
+			{
+				local[component_index] = math::lanes_load(local_values[component_index]);
+				parent[component_index] = math::lanes_load(parent_values[component_index]);
+			}
+
+			math::float4_lanes result[k_num_qvv_components];
+			compose(local, parent, result);
+
+			for (uint32_t component_index = 0; component_index < k_num_qvv_components; ++component_index)
+			{
+				float result_values[4];
+				math::lanes_store(result[component_index], result_values);
+
+				for (uint32_t lane_index = 0; lane_index < batch.num_lanes; ++lane_index)
+					components[component_index][batch.output_offsets[lane_index]] = result_values[lane_index];
+			}
+		}
+
+		static void get_component_arrays(object_space_transforms& transforms, float* (&out_components)[k_num_qvv_components])
+		{
+			for (uint32_t component_index = 0; component_index < k_num_qvv_components; ++component_index)
+				out_components[component_index] = transforms.get_component(static_cast<qvv_component>(component_index), 0);
+		}
+	}
+
+	object_space_transforms::object_space_transforms()
+		: m_num_transforms(0)
+		, m_num_samples(0)
+	{
+	}
+
+	void object_space_transforms::resize(size_t num_transforms, size_t num_samples)
+	{
+		for (std::vector<float>& component : m_components)
+			component.resize(num_transforms * num_samples);
+
+		m_num_transforms = num_transforms;
+		m_num_samples = num_samples;
+	}
+
+	size_t object_space_transforms::get_num_transforms() const
+	{
+		return m_num_transforms;
+	}
+
+	size_t object_space_transforms::get_num_samples() const
+	{
+		return m_num_samples;
+	}
+
+	float* object_space_transforms::get_component(qvv_component component, size_t transform_index)
+	{
+		return m_components[static_cast<uint32_t>(component)].data() + (transform_index * m_num_samples);
+	}
+
+	const float* object_space_transforms::get_component(qvv_component component, size_t transform_index) const
+	{
+		return m_components[static_cast<uint32_t>(component)].data() + (transform_index * m_num_samples);
+	}
+
+	qvv object_space_transforms::get_transform(size_t transform_index, size_t sample_index) const
+	{
+		const size_t offset = (transform_index * m_num_samples) + sample_index;
+
+		qvv result;
+		result.rotation = quat{ m_components[0][offset], m_components[1][offset], m_components[2][offset], m_components[3][offset] };
+		result.translation = vector4{ m_components[4][offset], m_components[5][offset], m_components[6][offset], 0.0F };
+		result.scale = vector4{ m_components[7][offset], m_components[8][offset], m_components[9][offset], 0.0F };
+		return result;
+	}
+
+	bool compute_object_space(const track_array& tracks, object_space_transforms& out_transforms)
+	{
+		if (tracks.get_type() != sample_type::qvv)
+			return false;
+
+		std::vector<uint32_t> order;
+		if (!get_topological_order(tracks, hierarchy_order::breadth_first, order))
+			return false;
+
+		const size_t num_samples = tracks.get_num_samples_per_track();
+		out_transforms.resize(tracks.get_num_tracks(), num_samples);
+
+		float* components[k_num_qvv_components];
+		get_component_arrays(out_transforms, components);
+
+		// Samples are independent, each block computes every transform for its samples
+		// Parents are computed before their children within a block
+		const size_t num_blocks = (num_samples + k_num_samples_per_block - 1) / k_num_samples_per_block;
+		const size_t work_per_block = tracks.get_num_tracks() * k_num_samples_per_block * sizeof(qvv) * 2;
+		parallel_for(num_blocks, work_per_block, [&](size_t block_index)
+			{
+				const size_t start_sample_index = block_index * k_num_samples_per_block;
+				const size_t end_sample_index = std::min(start_sample_index + k_num_samples_per_block, num_samples);
+
+				for (const uint32_t track_index : order)
+				{
+					const track& track_ = tracks[track_index];
+					const uint32_t parent_index = track_.get_description().transform.parent_index;
+
+					for (size_t sample_index = start_sample_index; sample_index < end_sample_index; sample_index += 4)
+					{
+						transform_batch batch;
+						batch.num_lanes = static_cast<uint32_t>(std::min<size_t>(4, end_sample_index - sample_index));
+
+						for (uint32_t lane_index = 0; lane_index < batch.num_lanes; ++lane_index)
+						{
+							batch.locals[lane_index] = &track_[sample_index + lane_index].transform;
+							batch.parent_offsets[lane_index] = parent_index != k_invalid_track_index ? ((parent_index * num_samples) + sample_index + lane_index) : k_no_parent;
+							batch.output_offsets[lane_index] = (track_index * num_samples) + sample_index + lane_index;
+						}
+
+						compose_batch(batch, components);
+					}
+				}
+			});
+
+		return true;
+	}
+
+	bool compute_object_space(const track_array& tracks, const sample* local_pose, object_space_transforms& out_transforms)
+	{
+		if (tracks.get_type() != sample_type::qvv)
+			return false;
+
+		std::vector<uint32_t> order;
+		if (!get_topological_order(tracks, hierarchy_order::breadth_first, order))
+			return false;
+
+		const uint32_t num_tracks = static_cast<uint32_t>(tracks.get_num_tracks());
+		out_transforms.resize(num_tracks, 1);
+
+		float* components[k_num_qvv_components];
+		get_component_arrays(out_transforms, components);
+
+		std::vector<uint32_t> depths(num_tracks, 0);
+
+		// The order goes down one depth at a time, tracks at the same depth are independent
+		size_t order_index = 0;
+		while (order_index < num_tracks)
+		{
+			transform_batch batch;
+			batch.num_lanes = 0;
+
+			uint32_t batch_depth = 0;
+			while (order_index < num_tracks && batch.num_lanes < 4)
+			{
+				const uint32_t track_index = order[order_index];
+				const uint32_t parent_index = tracks[track_index].get_description().transform.parent_index;
+				const uint32_t depth = parent_index != k_invalid_track_index ? (depths[parent_index] + 1) : 0;
+
+				// A child cannot be composed in the same batch as its parent
+				if (batch.num_lanes != 0 && depth != batch_depth)
+					break;
+
+				depths[track_index] = depth;
+				batch_depth = depth;
+
+				batch.locals[batch.num_lanes] = &local_pose[track_index].transform;
+				batch.parent_offsets[batch.num_lanes] = parent_index != k_invalid_track_index ? parent_index : k_no_parent;
+				batch.output_offsets[batch.num_lanes] = track_index;
+				++batch.num_lanes;
+				++order_index;
+			}
+
+			compose_batch(batch, components);
+		}
+
+		return true;
+	}
+}
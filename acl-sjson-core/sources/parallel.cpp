@@ -0,0 +1,105 @@
+////////////////////////////////////////////////////////////////////////////////
+// The MIT License (MIT)
+//
+// Copyright (c) 2022 Nicholas Frechette
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+////////////////////////////////////////////////////////////////////////////////
+
+#include "acl-sjson/memory_tracker.h"
+#include "acl-sjson/parallel.h"
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+namespace acl_sjson
+{
+	namespace
+	{
+		// Spawning a thread costs in the order of tens of microseconds, each thread
+		// needs enough work to amortize it
+		static constexpr size_t k_min_work_per_thread = 256 * 1024;
+
+		static std::atomic<uint32_t> s_max_num_threads(0);
+
+		// Set on every worker, nested loops run serially since the outer loop already uses every thread
+		static thread_local bool s_is_worker_thread = false;
+	}
+
+	void set_max_num_threads(uint32_t num_threads)
+	{
+		s_max_num_threads = num_threads;
+	}
+
+	uint32_t get_max_num_threads()
+	{
+		const uint32_t num_threads = s_max_num_threads;
+		if (num_threads != 0)
+			return num_threads;
+
+		const uint32_t num_hardware_threads = std::thread::hardware_concurrency();
+		return num_hardware_threads != 0 ? num_hardware_threads : 1;
+	}
+
+	void parallel_for(size_t num_items, size_t work_per_item, const std::function<void(size_t)>& func)
+	{
+		const size_t total_work = num_items * std::max<size_t>(work_per_item, 1);
+		const size_t max_num_threads = std::min<size_t>(get_max_num_threads(), num_items);
+		const size_t num_threads = std::min<size_t>(max_num_threads, total_work / k_min_work_per_thread);
+
+		if (num_threads <= 1 || s_is_worker_thread)
+		{
+			for (size_t item_index = 0; item_index < num_items; ++item_index)
+				func(item_index);
+
+			return;
+		}
+
+		// Workers inherit the memory phase of the calling thread
+		const memory_phase phase = get_memory_phase();
+
+		// Items are handed out one at a time, their cost can vary a lot
+		std::atomic<size_t> next_item_index(0);
+		const auto worker = [&]()
+		{
+			scoped_memory_phase worker_phase(phase);
+
+			const bool was_worker_thread = s_is_worker_thread;
+			s_is_worker_thread = true;
+
+			for (size_t item_index = next_item_index++; item_index < num_items; item_index = next_item_index++)
+				func(item_index);
+
+			s_is_worker_thread = was_worker_thread;
+		};
+
+		// The calling thread is one of the workers
+		std::vector<std::thread> threads;
+		threads.reserve(num_threads - 1);
+		for (size_t thread_index = 1; thread_index < num_threads; ++thread_index)
+			threads.emplace_back(worker);
+
+		worker();
+
+		for (std::thread& thread : threads)
+			thread.join();
+	}
+}
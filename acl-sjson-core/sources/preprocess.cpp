@@ -0,0 +1,381 @@
+////////////////////////////////////////////////////////////////////////////////
+// The MIT License (MIT)
+//
+// Copyright (c) 2022 Nicholas Frechette
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+////////////////////////////////////////////////////////////////////////////////
+
+#include "acl-sjson/parallel.h"
+#include "acl-sjson/preprocess.h"
+#include "acl-sjson/track.h"
+#include "acl-sjson/track_array.h"
+
+#include "sample_math.h"
+#include "simd_kernels.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <vector>
+
+namespace acl_sjson
+{
+	namespace
+	{
+		// The number of samples classified at once, small enough for the classes to stay on the stack
+		static constexpr uint32_t k_num_block_samples = 64;
+
+		// Loads the rotations of up to 4 samples, one per row, missing samples repeat the last one
+		static void load_rotations4(const sample* samples, size_t num_samples, math::float4_lanes* out_rows)
+		{
+			for (size_t row_index = 0; row_index < 4; ++row_index)
+				out_rows[row_index] = math::lanes_load(&samples[std::min(row_index, num_samples - 1)].q.x);
+		}
+
+		// The dot products of 4 pairs of rotations transposed into x, y, z, and w lanes
+		static math::float4_lanes dot_lanes(const math::float4_lanes* lhs, const math::float4_lanes* rhs)
+		{
+			return math::lanes_add(math::lanes_add(math::lanes_mul(lhs[0], rhs[0]), math::lanes_mul(lhs[1], rhs[1])), math::lanes_add(math::lanes_mul(lhs[2], rhs[2]), math::lanes_mul(lhs[3], rhs[3])));
+		}
+
+		// Flushes denormals to zero and returns whether the samples have values that aren't finite
+		static bool flush_denormals(sample* samples, size_t num_samples, int component_mask, bool flush, uint32_t& out_num_flushed)
+		{
+			// Samples are classified in blocks by the kernels of the current instruction set
+			const simd_kernels& kernels = get_simd_kernels();
+			sample_classes block_classes[k_num_block_samples];
+
+			bool has_non_finite = false;
+			for (size_t block_start = 0; block_start < num_samples; block_start += k_num_block_samples)
+			{
+				const size_t num_block_samples = std::min<size_t>(k_num_block_samples, num_samples - block_start);
+				kernels.classify_samples(samples + block_start, num_block_samples, block_classes);
+
+				for (size_t block_index = 0; block_index < num_block_samples; ++block_index)
+				{
+					if ((block_classes[block_index].non_finite_mask & component_mask) != 0)
+						has_non_finite = true;
+
+					const int denormal_mask = block_classes[block_index].denormal_mask & component_mask;
+					if (!flush || denormal_mask == 0)
+						continue;
+
+					float* values = &samples[block_start + block_index].f1.x;
+					for (uint32_t component_index = 0; component_index < 12; ++component_index)
+					{
+						if ((denormal_mask & (1 << component_index)) == 0)
+							continue;
+
+						values[component_index] = std::copysign(0.0F, values[component_index]);
+						++out_num_flushed;
+					}
+				}
+			}
+
+			return has_non_finite;
+		}
+
+		static void normalize_rotations(sample* samples, size_t num_samples, float tolerance, uint32_t& out_num_normalized)
+		{
+			const math::float4_lanes one = math::lanes_set(1.0F);
+			const math::float4_lanes tolerance_ = math::lanes_set(tolerance);
+
+			// Squared lengths are measured 4 samples at a time, the rare rotations off by more are normalized one at a time
+			for (size_t block_start = 0; block_start < num_samples; block_start += 4)
+			{
+				const size_t num_block_samples = std::min<size_t>(4, num_samples - block_start);
+
+				math::float4_lanes rotations[4];
+				load_rotations4(samples + block_start, num_block_samples, rotations);
+				math::lanes_transpose(rotations[0], rotations[1], rotations[2], rotations[3]);
+
+				const math::float4_lanes deviation = math::lanes_abs(math::lanes_sub(dot_lanes(rotations, rotations), one));
+				const int is_off_mask = math::lanes_less_mask(tolerance_, deviation) & ((1 << num_block_samples) - 1);
+				if (is_off_mask == 0)
+					continue;
+
+				for (size_t block_index = 0; block_index < num_block_samples; ++block_index)
+				{
+					if ((is_off_mask & (1 << block_index)) == 0)
+						continue;
+
+					// A zero rotation has no direction to retain, validation reports it
+					quat& rotation = samples[block_start + block_index].q;
+					if (math::dot4(&rotation.x, &rotation.x) == 0.0F)
+						continue;
+
+					rotation = math::quat_normalize(rotation);
+					++out_num_normalized;
+				}
+			}
+		}
+
+		static void make_rotations_continuous(sample* samples, size_t num_samples, uint32_t& out_num_flipped)
+		{
+			if (num_samples < 2)
+				return;
+
+			// A sample is flipped when its dot product with the original previous sample is negative, unless the
+			// previous one was flipped as well. The dot products only depend on the original rotations and are
+			// computed 4 at a time, the flips accumulate afterwards. The first sample retains its sign.
+			const math::float4_lanes zero = math::lanes_set(0.0F);
+			math::float4_lanes previous_row = math::lanes_load(&samples[0].q.x);
+			bool is_flipped = false;
+
+			for (size_t block_start = 1; block_start < num_samples; block_start += 4)
+			{
+				const size_t num_block_samples = std::min<size_t>(4, num_samples - block_start);
+
+				math::float4_lanes rotations[4];
+				load_rotations4(samples + block_start, num_block_samples, rotations);
+
+				math::float4_lanes previous_rotations[4] = { previous_row, rotations[0], rotations[1], rotations[2] };
+				previous_row = rotations[num_block_samples - 1];
+
+				math::lanes_transpose(rotations[0], rotations[1], rotations[2], rotations[3]);
+				math::lanes_transpose(previous_rotations[0], previous_rotations[1], previous_rotations[2], previous_rotations[3]);
+
+				const int is_opposite_mask = math::lanes_less_mask(dot_lanes(rotations, previous_rotations), zero);
+
+				for (size_t block_index = 0; block_index < num_block_samples; ++block_index)
+				{
+					if ((is_opposite_mask & (1 << block_index)) != 0)
+						is_flipped = !is_flipped;
+
+					if (!is_flipped)
+						continue;
+
+					quat& rotation = samples[block_start + block_index].q;
+					rotation.x = -rotation.x;
+					rotation.y = -rotation.y;
+					rotation.z = -rotation.z;
+					rotation.w = -rotation.w;
+					++out_num_flipped;
+				}
+			}
+		}
+
+		enum class snap_result
+		{
+			// Some samples are further than the threshold or they are already constant
+			unchanged,
+
+			constant,
+			default_value,
+		};
+
+		// Snaps a rotation sub-track when every sample is within the threshold angle of the default value or of the first sample
+		static snap_result snap_constant_rotations(sample* samples, size_t num_samples, const quat& default_value, float threshold_angle)
+		{
+			// Every lane holds the same rotation
+			const float* first_values = &samples[0].q.x;
+			const math::float4_lanes default_rotations[4] = { math::lanes_set(default_value.x), math::lanes_set(default_value.y), math::lanes_set(default_value.z), math::lanes_set(default_value.w) };
+			const math::float4_lanes first_rotations[4] = { math::lanes_set(first_values[0]), math::lanes_set(first_values[1]), math::lanes_set(first_values[2]), math::lanes_set(first_values[3]) };
+
+			// Two unit rotations are within an angle when the absolute value of their dot product is at least cos(angle / 2)
+			math::float4_lanes min_default_dot = math::lanes_set(1.0F);
+			math::float4_lanes min_first_dot = math::lanes_set(1.0F);
+			for (size_t block_start = 0; block_start < num_samples; block_start += 4)
+			{
+				math::float4_lanes rotations[4];
+				load_rotations4(samples + block_start, std::min<size_t>(4, num_samples - block_start), rotations);
+				math::lanes_transpose(rotations[0], rotations[1], rotations[2], rotations[3]);
+
+				min_default_dot = math::lanes_min(math::lanes_abs(dot_lanes(rotations, default_rotations)), min_default_dot);
+				min_first_dot = math::lanes_min(math::lanes_abs(dot_lanes(rotations, first_rotations)), min_first_dot);
+			}
+
+			const math::float4_lanes min_dot = math::lanes_set(std::cos(threshold_angle * 0.5F));
+			const bool is_default = math::lanes_less_mask(min_default_dot, min_dot) == 0;
+			const bool is_constant = math::lanes_less_mask(min_first_dot, min_dot) == 0;
+			if (!is_default && !is_constant)
+				return snap_result::unchanged;
+
+			const quat value = is_default ? default_value : samples[0].q;
+
+			bool is_changed = false;
+			for (size_t sample_index = 0; sample_index < num_samples; ++sample_index)
+			{
+				quat& rotation = samples[sample_index].q;
+				if (std::memcmp(&rotation, &value, sizeof(quat)) == 0)
+					continue;
+
+				rotation = value;
+				is_changed = true;
+			}
+
+			if (!is_changed)
+				return snap_result::unchanged;
+
+			return is_default ? snap_result::default_value : snap_result::constant;
+		}
+
+		// Snaps the x, y, and z components of a translation or scale sub-track when the range of every component is
+		// within the threshold. The default value is used when every sample is within the threshold of it, the center
+		// of the range otherwise.
+		static snap_result snap_constant_vectors(sample* samples, size_t num_samples, size_t component_offset, const vector4& default_value, float threshold)
+		{
+			const float* first_values = &samples[0].f1.x + component_offset;
+			math::float4_lanes min_value = math::lanes_load(first_values);
+			math::float4_lanes max_value = min_value;
+			for (size_t sample_index = 1; sample_index < num_samples; ++sample_index)
+			{
+				const math::float4_lanes value = math::lanes_load(&samples[sample_index].f1.x + component_offset);
+				min_value = math::lanes_min(value, min_value);
+				max_value = math::lanes_max(value, max_value);
+			}
+
+			const math::float4_lanes extent = math::lanes_sub(max_value, min_value);
+			const math::float4_lanes default_ = math::lanes_load(&default_value.x);
+			const math::float4_lanes default_distance = math::lanes_max(math::lanes_abs(math::lanes_sub(min_value, default_)), math::lanes_abs(math::lanes_sub(max_value, default_)));
+			const math::float4_lanes threshold_ = math::lanes_set(threshold);
+
+			// The w component is padding
+			const bool is_default = (math::lanes_less_mask(threshold_, default_distance) & 0x7) == 0;
+			const bool is_constant = (math::lanes_less_mask(threshold_, extent) & 0x7) == 0;
+			if (!is_default && !is_constant)
+				return snap_result::unchanged;
+
+			float value[4];
+			if (is_default)
+				math::lanes_store(default_, value);
+			else
+				math::lanes_store(math::lanes_add(min_value, math::lanes_mul(extent, math::lanes_set(0.5F))), value);
+
+			bool is_changed = false;
+			for (size_t sample_index = 0; sample_index < num_samples; ++sample_index)
+			{
+				float* values = &samples[sample_index].f1.x + component_offset;
+				if (std::memcmp(values, value, sizeof(float) * 3) == 0)
+					continue;
+
+				std::memcpy(values, value, sizeof(float) * 3);
+				is_changed = true;
+			}
+
+			if (!is_changed)
+				return snap_result::unchanged;
+
+			return is_default ? snap_result::default_value : snap_result::constant;
+		}
+
+		static void count_snap_result(snap_result result, preprocess_stats& out_stats)
+		{
+			if (result == snap_result::constant)
+				++out_stats.num_constant_sub_tracks;
+			else if (result == snap_result::default_value)
+				++out_stats.num_default_sub_tracks;
+		}
+
+		static void preprocess_samples(sample* samples, size_t num_samples, sample_type type, const transform_track_description& desc, const preprocess_settings& settings, preprocess_stats& out_stats)
+		{
+			const int component_mask = get_component_mask(type);
+
+			const bool has_non_finite = flush_denormals(samples, num_samples, component_mask, settings.flush_denormals, out_stats.num_flushed_denormals);
+			if (!is_transform(type) || has_non_finite)
+				return;
+
+			if (settings.normalize_rotations)
+				normalize_rotations(samples, num_samples, settings.rotation_length_tolerance, out_stats.num_normalized_rotations);
+
+			if (settings.make_rotations_continuous)
+				make_rotations_continuous(samples, num_samples, out_stats.num_flipped_rotations);
+
+			if (!settings.snap_constant_sub_tracks)
+				return;
+
+			count_snap_result(snap_constant_rotations(samples, num_samples, desc.default_value.rotation, desc.constant_rotation_threshold_angle), out_stats);
+
+			if (type != sample_type::qvv)
+				return;
+
+			count_snap_result(snap_constant_vectors(samples, num_samples, 4, desc.default_value.translation, desc.constant_translation_threshold), out_stats);
+			count_snap_result(snap_constant_vectors(samples, num_samples, 8, desc.default_value.scale, desc.constant_scale_threshold), out_stats);
+		}
+
+		static bool has_changes(const preprocess_stats& stats)
+		{
+			return stats.num_flushed_denormals != 0 || stats.num_normalized_rotations != 0 || stats.num_flipped_rotations != 0
+				|| stats.num_constant_sub_tracks != 0 || stats.num_default_sub_tracks != 0;
+		}
+
+		static void preprocess_track(track& track_, const preprocess_settings& settings, preprocess_stats& out_stats)
+		{
+			const size_t num_samples = track_.get_num_samples();
+			if (num_samples == 0)
+				return;
+
+			const sample_type type = track_.get_type();
+			const transform_track_description& desc = track_.get_description().transform;
+
+			if (!track_.is_collapsed())
+			{
+				preprocess_samples(track_.get_mutable_samples(), num_samples, type, desc, settings, out_stats);
+
+				// Snapping can leave every sample identical
+				if (has_changes(out_stats) && track_.collapse())
+					++out_stats.num_collapsed_tracks;
+
+				return;
+			}
+
+			// Collapsed tracks repeat a single sample, process it once and replace it in place
+			const track& constant_track = track_;
+			sample constant_sample = constant_track[0];
+			preprocess_samples(&constant_sample, 1, type, desc, settings, out_stats);
+
+			if (!has_changes(out_stats))
+				return;
+
+			track_.set_constant_sample(constant_sample);
+
+			// Every sample of a collapsed track has the change
+			const uint32_t num_repeats = static_cast<uint32_t>(num_samples);
+			out_stats.num_flushed_denormals *= num_repeats;
+			out_stats.num_normalized_rotations *= num_repeats;
+		}
+	}
+
+	void preprocess_tracks(track_array& tracks, const preprocess_settings& settings, preprocess_stats& out_stats)
+	{
+		out_stats = preprocess_stats();
+
+		const size_t num_tracks = tracks.get_num_tracks();
+
+		// Each track writes its own slot, they are summed once done
+		std::vector<preprocess_stats> track_stats(num_tracks);
+
+		const size_t work_per_track = tracks.get_num_samples_per_track() * sizeof(sample);
+		parallel_for(num_tracks, work_per_track, [&](size_t track_index)
+			{
+				preprocess_track(tracks[track_index], settings, track_stats[track_index]);
+			});
+
+		for (const preprocess_stats& stats : track_stats)
+		{
+			out_stats.num_flushed_denormals += stats.num_flushed_denormals;
+			out_stats.num_normalized_rotations += stats.num_normalized_rotations;
+			out_stats.num_flipped_rotations += stats.num_flipped_rotations;
+			out_stats.num_constant_sub_tracks += stats.num_constant_sub_tracks;
+			out_stats.num_default_sub_tracks += stats.num_default_sub_tracks;
+			out_stats.num_collapsed_tracks += stats.num_collapsed_tracks;
+		}
+	}
+}
@@ -0,0 +1,49 @@
+////////////////////////////////////////////////////////////////////////////////
+// The MIT License (MIT)
+//
+// Copyright (c) 2022 Nicholas Frechette
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+////////////////////////////////////////////////////////////////////////////////
+
+#include "acl-sjson/regression_metadata.h"
+
+#include "sjson_reader.h"
+
+#include <sjson/parser.h>
+
+#include <utility>
+
+namespace acl_sjson
+{
+	bool read_regression_metadata(const char* filename, regression_metadata_t& out_metadata)
+	{
+		regression_metadata_t metadata;
+		const auto parse_root = [&metadata](sjson::Parser& parser)
+		{
+			return read_strings(parser, "configs", true, metadata.configs) && read_strings(parser, "clips", true, metadata.clips);
+		};
+
+		if (!parse_sjson_file(filename, parse_root))
+			return false;
+
+		out_metadata = std::move(metadata);
+		return true;
+	}
+}
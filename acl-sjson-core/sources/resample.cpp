@@ -0,0 +1,229 @@
+////////////////////////////////////////////////////////////////////////////////
+// The MIT License (MIT)
+//
+// Copyright (c) 2022 Nicholas Frechette
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+////////////////////////////////////////////////////////////////////////////////
+
+#include "acl-sjson/resample.h"
+#include "acl-sjson/sample_traits.h"
+#include "acl-sjson/track.h"
+#include "acl-sjson/track_array.h"
+
+#include "interpolation.h"
+#include "simd_kernels.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+namespace acl_sjson
+{
+	namespace
+	{
+		struct resample_functor
+		{
+			const track& input_track;
+			track& output_track;
+			float new_sample_rate;
+			size_t num_new_samples;
+			rotation_interpolation interpolation;
+
+			void operator()(sample_traits<sample_type::unknown>) const
+			{
+				// Nothing to interpolate
+			}
+
+			template<typename traits_type>
+			void operator()(traits_type) const
+			{
+				const size_t num_samples = input_track.get_num_samples();
+				if (num_samples == 0)
+					return;
+
+				// Positions are computed in samples, times would accumulate more rounding error
+				// Constant tracks remain constant, every new sample is their single sample
+				const float sample_rate_ratio = input_track.get_sample_rate() / new_sample_rate;
+
+				output_track.reserve(num_new_samples);
+				for (size_t sample_index = 0; sample_index < num_new_samples; ++sample_index)
+				{
+					const interpolation_keys keys = find_interpolation_keys(num_samples, float(sample_index) * sample_rate_ratio, sample_wrap_policy::clamp);
+
+					sample smpl = sample_track<traits_type::k_type>(input_track, keys, interpolation);
+					output_track.emplace_back(std::move(smpl));
+				}
+			}
+		};
+
+		// The number of samples compared at once, small enough for the results to stay on the stack
+		static constexpr size_t k_num_block_samples = 64;
+
+		// Flags every frame where a track differs from the previous frame by more than the tolerance
+		static void find_changed_frames(const track_array& tracks, float tolerance, std::vector<uint8_t>& out_is_frame_changed)
+		{
+			const size_t num_samples = tracks.get_num_samples_per_track();
+			out_is_frame_changed.assign(num_samples, 0);
+
+			const simd_kernels& kernels = get_simd_kernels();
+			float block_errors[k_num_block_samples];
+			uint8_t block_is_match[k_num_block_samples];
+
+			const size_t num_tracks = tracks.get_num_tracks();
+			for (size_t track_index = 0; track_index < num_tracks; ++track_index)
+			{
+				const track& track_ = tracks[track_index];
+				if (track_.is_collapsed())
+					continue;
+
+				const uint32_t component_mask = static_cast<uint32_t>(get_component_mask(track_.get_type()));
+				for (size_t block_start = 1; block_start < num_samples; block_start += k_num_block_samples)
+				{
+					const size_t num_block_samples = std::min(k_num_block_samples, num_samples - block_start);
+					kernels.compare_samples(&track_[block_start - 1], 1, &track_[block_start], 1, num_block_samples, component_mask, tolerance, 0.0F, block_errors, block_is_match);
+
+					for (size_t block_index = 0; block_index < num_block_samples; ++block_index)
+						out_is_frame_changed[block_start + block_index] |= block_is_match[block_index] == 0 ? 1 : 0;
+				}
+			}
+		}
+
+		// Returns whether every frame is within the tolerance of the first frame of its block, the frame resampling keeps
+		static bool are_blocks_constant(const track_array& tracks, size_t duplication_factor, float tolerance)
+		{
+			const size_t num_samples = tracks.get_num_samples_per_track();
+
+			const simd_kernels& kernels = get_simd_kernels();
+			float block_errors[k_num_block_samples];
+			uint8_t block_is_match[k_num_block_samples];
+
+			const size_t num_tracks = tracks.get_num_tracks();
+			for (size_t track_index = 0; track_index < num_tracks; ++track_index)
+			{
+				const track& track_ = tracks[track_index];
+				if (track_.is_collapsed())
+					continue;
+
+				const uint32_t component_mask = static_cast<uint32_t>(get_component_mask(track_.get_type()));
+				for (size_t kept_index = 0; kept_index < num_samples; kept_index += duplication_factor)
+				{
+					// The kept frame is repeated against every other frame of its block
+					for (size_t block_start = kept_index + 1; block_start < std::min(kept_index + duplication_factor, num_samples); block_start += k_num_block_samples)
+					{
+						const size_t num_block_samples = std::min(std::min(k_num_block_samples, kept_index + duplication_factor - block_start), num_samples - block_start);
+						kernels.compare_samples(&track_[kept_index], 0, &track_[block_start], 1, num_block_samples, component_mask, tolerance, 0.0F, block_errors, block_is_match);
+
+						for (size_t block_index = 0; block_index < num_block_samples; ++block_index)
+						{
+							if (block_is_match[block_index] == 0)
+								return false;
+						}
+					}
+				}
+			}
+
+			return true;
+		}
+
+		static size_t greatest_common_divisor(size_t lhs, size_t rhs)
+		{
+			while (rhs != 0)
+			{
+				const size_t remainder = lhs % rhs;
+				lhs = rhs;
+				rhs = remainder;
+			}
+
+			return lhs;
+		}
+	}
+
+	bool resample(track_array& tracks, float new_sample_rate, rotation_interpolation interpolation)
+	{
+		if (!(new_sample_rate > 0.0F) || !std::isfinite(new_sample_rate))
+			return false;
+
+		const size_t num_samples = tracks.get_num_samples_per_track();
+		const float duration = tracks.get_duration();
+
+		// A small epsilon ensures that a duration that is a whole multiple of the new sample interval
+		// doesn't lose its last sample to rounding
+		const size_t num_new_samples = num_samples == 0 ? 0 : (static_cast<size_t>(std::floor((duration * new_sample_rate) + 1.0E-4F)) + 1);
+
+		track_array output_tracks(tracks.get_name(), tracks.get_metadata());
+
+		const size_t num_tracks = tracks.get_num_tracks();
+		for (size_t track_index = 0; track_index < num_tracks; ++track_index)
+		{
+			const track& input_track = tracks[track_index];
+
+			track output_track(input_track.get_type(), new_sample_rate, input_track.get_name());
+			output_track.get_description() = input_track.get_description();
+
+			visit_sample_type(input_track.get_type(), resample_functor{ input_track, output_track, new_sample_rate, num_new_samples, interpolation });
+
+			output_tracks.emplace_back(std::move(output_track));
+		}
+
+		tracks = std::move(output_tracks);
+		return true;
+	}
+
+	float find_native_sample_rate(const track_array& tracks, float tolerance)
+	{
+		const float sample_rate = tracks.get_sample_rate();
+		const size_t num_samples = tracks.get_num_samples_per_track();
+		if (num_samples < 2 || !(tolerance >= 0.0F))
+			return sample_rate;
+
+		std::vector<uint8_t> is_frame_changed;
+		find_changed_frames(tracks, tolerance, is_frame_changed);
+
+		// Resampling keeps frames 0, factor, 2 * factor, etc. Every frame that changes must start a block, the factor
+		// divides the index of every change and not only the distance between them
+		size_t duplication_factor = 0;
+		size_t num_changes = 0;
+		for (size_t sample_index = 1; sample_index < num_samples; ++sample_index)
+		{
+			if (is_frame_changed[sample_index] == 0)
+				continue;
+
+			duplication_factor = greatest_common_divisor(duplication_factor, sample_index);
+			if (duplication_factor == 1)
+				return sample_rate;	// No duplication
+
+			++num_changes;
+		}
+
+		if (num_changes < k_min_native_rate_changes || duplication_factor <= 1)
+			return sample_rate;
+
+		// Small changes within the tolerance can add up over a block, measure every frame against the frame kept
+		// and fall back to smaller factors that divide the one found
+		for (size_t factor = duplication_factor; factor > 1; --factor)
+		{
+			if (duplication_factor % factor == 0 && are_blocks_constant(tracks, factor, tolerance))
+				return sample_rate / float(factor);
+		}
+
+		return sample_rate;
+	}
+}
@@ -23,6 +23,7 @@
 ////////////////////////////////////////////////////////////////////////////////
 
 #include "acl-sjson/sample.h"
+#include "acl-sjson/sample_traits.h"
 
 namespace acl_sjson
 {
@@ -41,4 +42,40 @@ namespace acl_sjson
 			case sample_type::qvv:		return "qvv";
 		}
 	}
+
+	namespace
+	{
+		struct sample_size_functor
+		{
+			template<typename traits_type>
+			size_t operator()(traits_type) const { return traits_type::k_size; }
+		};
+
+		struct num_components_functor
+		{
+			uint32_t operator()(sample_traits<sample_type::unknown>) const { return 0; }
+
+			template<typename traits_type>
+			uint32_t operator()(traits_type) const { return traits_type::k_num_components; }
+		};
+	}
+
+	size_t get_sample_size(sample_type type)
+	{
+		return visit_sample_type(type, sample_size_functor());
+	}
+
+	bool is_transform(sample_type type)
+	{
+		return type == sample_type::qvv || type == sample_type::quat;
+	}
+
+	int get_component_mask(sample_type type)
+	{
+		if (type == sample_type::qvv)
+			return 0x77F;
+
+		const uint32_t num_components = visit_sample_type(type, num_components_functor());
+		return (1 << num_components) - 1;
+	}
 }
@@ -0,0 +1,399 @@
+#pragma once
+
+////////////////////////////////////////////////////////////////////////////////
+// The MIT License (MIT)
+//
+// Copyright (c) 2022 Nicholas Frechette
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+////////////////////////////////////////////////////////////////////////////////
+
+#include "acl-sjson/sample.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <cstdint>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+	#define ACL_SJSON_SSE2_INTRINSICS
+	#include <emmintrin.h>
+#endif
+
+// Internal math helpers shared by the core algorithms
+// Quaternions use the [x, y, z, w] layout where w is the real part
+namespace acl_sjson
+{
+	namespace math
+	{
+#if defined(ACL_SJSON_SSE2_INTRINSICS)
+		inline __m128 load4(const float* input) { return _mm_loadu_ps(input); }
+		inline void store4(__m128 input, float* output) { _mm_storeu_ps(output, input); }
+
+		inline float dot4(__m128 lhs, __m128 rhs)
+		{
+			const __m128 mul = _mm_mul_ps(lhs, rhs);
+			const __m128 shuf = _mm_shuffle_ps(mul, mul, _MM_SHUFFLE(2, 3, 0, 1));	// [y, x, w, z]
+			const __m128 sum = _mm_add_ps(mul, shuf);									// [x+y, x+y, z+w, z+w]
+			const __m128 high = _mm_movehl_ps(sum, sum);								// [z+w, z+w, ...]
+			return _mm_cvtss_f32(_mm_add_ss(sum, high));
+		}
+#endif
+
+		// Four independent values processed together, used to compute four transforms at once
+#if defined(ACL_SJSON_SSE2_INTRINSICS)
+		using float4_lanes = __m128;
+
+		inline float4_lanes lanes_load(const float* input) { return _mm_loadu_ps(input); }
+		inline void lanes_store(float4_lanes input, float* output) { _mm_storeu_ps(output, input); }
+		inline float4_lanes lanes_set(float value) { return _mm_set_ps1(value); }
+		inline float4_lanes lanes_add(float4_lanes lhs, float4_lanes rhs) { return _mm_add_ps(lhs, rhs); }
+		inline float4_lanes lanes_sub(float4_lanes lhs, float4_lanes rhs) { return _mm_sub_ps(lhs, rhs); }
+		inline float4_lanes lanes_mul(float4_lanes lhs, float4_lanes rhs) { return _mm_mul_ps(lhs, rhs); }
+		inline float4_lanes lanes_min(float4_lanes lhs, float4_lanes rhs) { return _mm_min_ps(lhs, rhs); }
+		inline float4_lanes lanes_max(float4_lanes lhs, float4_lanes rhs) { return _mm_max_ps(lhs, rhs); }
+		inline float4_lanes lanes_abs(float4_lanes input) { return _mm_and_ps(input, _mm_castsi128_ps(_mm_set1_epi32(0x7FFFFFFF))); }
+
+		// Returns a mask with a bit set per lane where lhs < rhs
+		inline int lanes_less_mask(float4_lanes lhs, float4_lanes rhs) { return _mm_movemask_ps(_mm_cmplt_ps(lhs, rhs)); }
+
+		// Turns 4 rows into 4 columns, e.g. 4 quaternions into their x, y, z, and w lanes
+		inline void lanes_transpose(float4_lanes& row0, float4_lanes& row1, float4_lanes& row2, float4_lanes& row3) { _MM_TRANSPOSE4_PS(row0, row1, row2, row3); }
+#else
+		struct float4_lanes
+		{
+			float values[4];
+		};
+
+		inline float4_lanes lanes_load(const float* input) { return float4_lanes{ { input[0], input[1], input[2], input[3] } }; }
+		inline void lanes_store(float4_lanes input, float* output) { output[0] = input.values[0]; output[1] = input.values[1]; output[2] = input.values[2]; output[3] = input.values[3]; }
+		inline float4_lanes lanes_set(float value) { return float4_lanes{ { value, value, value, value } }; }
+		inline float4_lanes lanes_add(float4_lanes lhs, float4_lanes rhs) { return float4_lanes{ { lhs.values[0] + rhs.values[0], lhs.values[1] + rhs.values[1], lhs.values[2] + rhs.values[2], lhs.values[3] + rhs.values[3] } }; }
+		inline float4_lanes lanes_sub(float4_lanes lhs, float4_lanes rhs) { return float4_lanes{ { lhs.values[0] - rhs.values[0], lhs.values[1] - rhs.values[1], lhs.values[2] - rhs.values[2], lhs.values[3] - rhs.values[3] } }; }
+		inline float4_lanes lanes_mul(float4_lanes lhs, float4_lanes rhs) { return float4_lanes{ { lhs.values[0] * rhs.values[0], lhs.values[1] * rhs.values[1], lhs.values[2] * rhs.values[2], lhs.values[3] * rhs.values[3] } }; }
+
+		// Returns the rhs when either value is NaN, like the SSE instructions
+		inline float4_lanes lanes_min(float4_lanes lhs, float4_lanes rhs)
+		{
+			float4_lanes result;
+			for (int lane_index = 0; lane_index < 4; ++lane_index)
+				result.values[lane_index] = lhs.values[lane_index] < rhs.values[lane_index] ? lhs.values[lane_index] : rhs.values[lane_index];
+			return result;
+		}
+
+		inline float4_lanes lanes_max(float4_lanes lhs, float4_lanes rhs)
+		{
+			float4_lanes result;
+			for (int lane_index = 0; lane_index < 4; ++lane_index)
+				result.values[lane_index] = lhs.values[lane_index] > rhs.values[lane_index] ? lhs.values[lane_index] : rhs.values[lane_index];
+			return result;
+		}
+
+		inline float4_lanes lanes_abs(float4_lanes input) { return float4_lanes{ { std::fabs(input.values[0]), std::fabs(input.values[1]), std::fabs(input.values[2]), std::fabs(input.values[3]) } }; }
+
+		inline int lanes_less_mask(float4_lanes lhs, float4_lanes rhs)
+		{
+			int mask = 0;
+			for (int lane_index = 0; lane_index < 4; ++lane_index)
+			{
+				if (lhs.values[lane_index] < rhs.values[lane_index])
+					mask |= 1 << lane_index;
+			}
+			return mask;
+		}
+
+		inline void lanes_transpose(float4_lanes& row0, float4_lanes& row1, float4_lanes& row2, float4_lanes& row3)
+		{
+			const float4_lanes rows[4] = { row0, row1, row2, row3 };
+			float4_lanes* columns[4] = { &row0, &row1, &row2, &row3 };
+			for (int column_index = 0; column_index < 4; ++column_index)
+			{
+				for (int row_index = 0; row_index < 4; ++row_index)
+					columns[column_index]->values[row_index] = rows[row_index].values[column_index];
+			}
+		}
+#endif
+
+		inline float dot4(const float* lhs, const float* rhs)
+		{
+#if defined(ACL_SJSON_SSE2_INTRINSICS)
+			return dot4(load4(lhs), load4(rhs));
+#else
+			return (lhs[0] * rhs[0]) + (lhs[1] * rhs[1]) + (lhs[2] * rhs[2]) + (lhs[3] * rhs[3]);
+#endif
+		}
+
+		inline float lerp(float start, float end, float alpha)
+		{
+			return ((end - start) * alpha) + start;
+		}
+
+		// Linearly interpolates the first 'num_components' values
+		inline void lerp(const float* start, const float* end, float alpha, uint32_t num_components, float* output)
+		{
+			for (uint32_t component_index = 0; component_index < num_components; ++component_index)
+				output[component_index] = lerp(start[component_index], end[component_index], alpha);
+		}
+
+		// Linearly interpolates 4 values at once
+		// Values are read and written in groups of four, the inputs and output must be padded accordingly (e.g. a sample)
+		inline void lerp4(const float* start, const float* end, float alpha, float* output)
+		{
+#if defined(ACL_SJSON_SSE2_INTRINSICS)
+			const __m128 start_ = load4(start);
+			const __m128 end_ = load4(end);
+			store4(_mm_add_ps(_mm_mul_ps(_mm_sub_ps(end_, start_), _mm_set_ps1(alpha)), start_), output);
+#else
+			lerp(start, end, alpha, 4, output);
+#endif
+		}
+
+		inline vector4 vector_lerp(const vector4& start, const vector4& end, float alpha)
+		{
+			vector4 result;
+#if defined(ACL_SJSON_SSE2_INTRINSICS)
+			const __m128 start_ = load4(&start.x);
+			const __m128 end_ = load4(&end.x);
+			store4(_mm_add_ps(_mm_mul_ps(_mm_sub_ps(end_, start_), _mm_set_ps1(alpha)), start_), &result.x);
+#else
+			lerp(&start.x, &end.x, alpha, 4, &result.x);
+#endif
+			return result;
+		}
+
+		inline quat quat_normalize(const quat& input)
+		{
+			const float length_sq = dot4(&input.x, &input.x);
+			if (length_sq == 0.0F)
+				return input;
+
+			const float inv_length = 1.0F / std::sqrt(length_sq);
+
+			quat result;
+#if defined(ACL_SJSON_SSE2_INTRINSICS)
+			store4(_mm_mul_ps(load4(&input.x), _mm_set_ps1(inv_length)), &result.x);
+#else
+			result.x = input.x * inv_length;
+			result.y = input.y * inv_length;
+			result.z = input.z * inv_length;
+			result.w = input.w * inv_length;
+#endif
+			return result;
+		}
+
+		// Interpolates along the shortest path and normalizes the result
+		inline quat quat_nlerp(const quat& start, const quat& end, float alpha)
+		{
+			// If the quaternions are in opposite hemispheres, flip the end to take the shortest path
+			const float bias = dot4(&start.x, &end.x) >= 0.0F ? 1.0F : -1.0F;
+
+			quat result;
+#if defined(ACL_SJSON_SSE2_INTRINSICS)
+			const __m128 start_ = load4(&start.x);
+			const __m128 end_ = _mm_mul_ps(load4(&end.x), _mm_set_ps1(bias));
+			store4(_mm_add_ps(_mm_mul_ps(_mm_sub_ps(end_, start_), _mm_set_ps1(alpha)), start_), &result.x);
+#else
+			result.x = lerp(start.x, end.x * bias, alpha);
+			result.y = lerp(start.y, end.y * bias, alpha);
+			result.z = lerp(start.z, end.z * bias, alpha);
+			result.w = lerp(start.w, end.w * bias, alpha);
+#endif
+			return quat_normalize(result);
+		}
+
+		// Spherical interpolation along the shortest path
+		inline quat quat_slerp(const quat& start, const quat& end, float alpha)
+		{
+			float cos_angle = dot4(&start.x, &end.x);
+			const float bias = cos_angle >= 0.0F ? 1.0F : -1.0F;
+			cos_angle *= bias;
+
+			// When the rotations are very close, the angle is too small to divide by its sine
+			if (cos_angle > 0.9995F)
+				return quat_nlerp(start, end, alpha);
+
+			const float angle = std::acos(cos_angle);
+			const float inv_sin_angle = 1.0F / std::sin(angle);
+			const float start_weight = std::sin((1.0F - alpha) * angle) * inv_sin_angle;
+			const float end_weight = std::sin(alpha * angle) * inv_sin_angle * bias;
+
+			quat result;
+#if defined(ACL_SJSON_SSE2_INTRINSICS)
+			const __m128 start_ = _mm_mul_ps(load4(&start.x), _mm_set_ps1(start_weight));
+			const __m128 end_ = _mm_mul_ps(load4(&end.x), _mm_set_ps1(end_weight));
+			store4(_mm_add_ps(start_, end_), &result.x);
+#else
+			result.x = (start.x * start_weight) + (end.x * end_weight);
+			result.y = (start.y * start_weight) + (end.y * end_weight);
+			result.z = (start.z * start_weight) + (end.z * end_weight);
+			result.w = (start.w * start_weight) + (end.w * end_weight);
+#endif
+			return result;
+		}
+
+		// Squaring a value with a magnitude of 2^64 or more overflows
+		static constexpr float k_min_overflowing_square_root = 18446744073709551616.0F;
+
+		// The classes of 4 values, each mask has a bit set per matching lane
+		struct value_classes
+		{
+			int non_finite_mask;
+			int denormal_mask;
+			int overflowing_mask;
+		};
+
+		// Classifies 4 values as non-finite (NaN or infinite), denormal, or overflowing when squared
+		inline value_classes classify4(const float* input)
+		{
+			value_classes result;
+#if defined(ACL_SJSON_SSE2_INTRINSICS)
+			// The magnitude of positive floats compares like integers, NaN and infinity are the largest
+			const __m128i abs_bits = _mm_and_si128(_mm_castps_si128(load4(input)), _mm_set1_epi32(0x7FFFFFFF));
+			const __m128i is_non_finite = _mm_cmpgt_epi32(abs_bits, _mm_set1_epi32(0x7F7FFFFF));
+			const __m128i is_denormal = _mm_and_si128(_mm_cmpgt_epi32(abs_bits, _mm_setzero_si128()), _mm_cmplt_epi32(abs_bits, _mm_set1_epi32(0x00800000)));
+			const __m128i is_overflowing = _mm_andnot_si128(is_non_finite, _mm_cmpgt_epi32(abs_bits, _mm_set1_epi32(0x5F7FFFFF)));
+
+			result.non_finite_mask = _mm_movemask_ps(_mm_castsi128_ps(is_non_finite));
+			result.denormal_mask = _mm_movemask_ps(_mm_castsi128_ps(is_denormal));
+			result.overflowing_mask = _mm_movemask_ps(_mm_castsi128_ps(is_overflowing));
+#else
+			result.non_finite_mask = 0;
+			result.denormal_mask = 0;
+			result.overflowing_mask = 0;
+
+			for (int lane_index = 0; lane_index < 4; ++lane_index)
+			{
+				const float value = input[lane_index];
+				if (!std::isfinite(value))
+					result.non_finite_mask |= 1 << lane_index;
+				else if (std::fpclassify(value) == FP_SUBNORMAL)
+					result.denormal_mask |= 1 << lane_index;
+				else if (std::fabs(value) >= k_min_overflowing_square_root)
+					result.overflowing_mask |= 1 << lane_index;
+			}
+#endif
+			return result;
+		}
+
+		// Compares 4 values against zero, each mask has a bit set per matching lane
+		// NaN is neither zero nor negative
+		inline void compare_to_zero4(const float* input, int& out_zero_mask, int& out_negative_mask)
+		{
+#if defined(ACL_SJSON_SSE2_INTRINSICS)
+			const __m128 input_ = load4(input);
+			out_zero_mask = _mm_movemask_ps(_mm_cmpeq_ps(input_, _mm_setzero_ps()));
+			out_negative_mask = _mm_movemask_ps(_mm_cmplt_ps(input_, _mm_setzero_ps()));
+#else
+			out_zero_mask = 0;
+			out_negative_mask = 0;
+
+			for (int lane_index = 0; lane_index < 4; ++lane_index)
+			{
+				if (input[lane_index] == 0.0F)
+					out_zero_mask |= 1 << lane_index;
+				else if (input[lane_index] < 0.0F)
+					out_negative_mask |= 1 << lane_index;
+			}
+#endif
+		}
+
+		// Returns whether the values selected by the component mask are bit for bit identical
+		// Values are read in groups of four, the inputs must be padded accordingly (e.g. a sample)
+		inline bool are_bit_equal(const float* lhs, const float* rhs, uint32_t component_mask)
+		{
+#if defined(ACL_SJSON_SSE2_INTRINSICS)
+			for (uint32_t component_index = 0; (component_mask >> component_index) != 0; component_index += 4)
+			{
+				const __m128i is_equal = _mm_cmpeq_epi32(_mm_castps_si128(load4(lhs + component_index)), _mm_castps_si128(load4(rhs + component_index)));
+				const uint32_t not_equal_mask = ~uint32_t(_mm_movemask_ps(_mm_castsi128_ps(is_equal))) & 0xF;
+
+				if ((not_equal_mask & (component_mask >> component_index)) != 0)
+					return false;
+			}
+#else
+			for (uint32_t component_index = 0; (component_mask >> component_index) != 0; ++component_index)
+			{
+				if ((component_mask & (1U << component_index)) != 0 && std::memcmp(lhs + component_index, rhs + component_index, sizeof(float)) != 0)
+					return false;
+			}
+#endif
+
+			return true;
+		}
+
+		// Compares the values selected by the component mask, two values match when their absolute difference is within
+		// the absolute tolerance or within the relative tolerance scaled by the largest magnitude of the two
+		// Returns whether every value matches, the largest absolute difference is written to 'out_max_error'
+		// Values are read in groups of four, the inputs must be padded accordingly (e.g. a sample)
+		inline bool compare_within_tolerance(const float* lhs, const float* rhs, uint32_t component_mask, float absolute_tolerance, float relative_tolerance, float& out_max_error)
+		{
+			bool is_match = true;
+			float max_error = 0.0F;
+
+#if defined(ACL_SJSON_SSE2_INTRINSICS)
+			const __m128 abs_mask = _mm_castsi128_ps(_mm_set1_epi32(0x7FFFFFFF));
+			const __m128 absolute_tolerance_ = _mm_set_ps1(absolute_tolerance);
+			const __m128 relative_tolerance_ = _mm_set_ps1(relative_tolerance);
+
+			for (uint32_t component_index = 0; (component_mask >> component_index) != 0; component_index += 4)
+			{
+				const __m128 lhs_ = load4(lhs + component_index);
+				const __m128 rhs_ = load4(rhs + component_index);
+				const __m128 error = _mm_and_ps(_mm_sub_ps(lhs_, rhs_), abs_mask);
+				const __m128 magnitude = _mm_max_ps(_mm_and_ps(lhs_, abs_mask), _mm_and_ps(rhs_, abs_mask));
+				const __m128 tolerance = _mm_max_ps(absolute_tolerance_, _mm_mul_ps(magnitude, relative_tolerance_));
+
+				// Not less than or equal is also true when the error is NaN
+				const int mismatch_mask = _mm_movemask_ps(_mm_cmpnle_ps(error, tolerance));
+
+				const int lane_mask = int(component_mask >> component_index) & 0xF;
+
+				if ((mismatch_mask & lane_mask) != 0)
+					is_match = false;
+
+				float errors[4];
+				store4(error, errors);
+				for (uint32_t lane_index = 0; lane_index < 4; ++lane_index)
+				{
+					if ((lane_mask & (1 << lane_index)) != 0)
+						max_error = std::isnan(errors[lane_index]) ? INFINITY : std::max(max_error, errors[lane_index]);
+				}
+			}
+#else
+			for (uint32_t component_index = 0; (component_mask >> component_index) != 0; ++component_index)
+			{
+				if ((component_mask & (1U << component_index)) == 0)
+					continue;
+
+				const float error = std::fabs(lhs[component_index] - rhs[component_index]);
+				const float magnitude = std::max(std::fabs(lhs[component_index]), std::fabs(rhs[component_index]));
+				const float tolerance = std::max(absolute_tolerance, magnitude * relative_tolerance);
+
+				if (!(error <= tolerance))
+					is_match = false;
+
+				max_error = std::isnan(error) ? INFINITY : std::max(max_error, error);
+			}
+#endif
+
+			out_max_error = max_error;
+			return is_match;
+		}
+	}
+}
@@ -0,0 +1,87 @@
+////////////////////////////////////////////////////////////////////////////////
+// The MIT License (MIT)
+//
+// Copyright (c) 2022 Nicholas Frechette
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+////////////////////////////////////////////////////////////////////////////////
+
+#include "acl-sjson/sample_range.h"
+#include "acl-sjson/track.h"
+#include "acl-sjson/track_array.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace acl_sjson
+{
+	bool get_sample_range(float sample_rate, size_t num_samples, float start_time, float end_time, sample_range& out_range)
+	{
+		if (num_samples == 0 || !(sample_rate > 0.0F))
+			return false;
+
+		if (!std::isfinite(start_time) || std::isnan(end_time) || start_time > end_time)
+			return false;
+
+		// Times that fall within rounding error of a sample include it
+		const float epsilon = 1.0E-4F;
+		const float first_position = std::ceil((std::max(start_time, 0.0F) * sample_rate) - epsilon);
+		const float last_position = std::floor((end_time * sample_rate) + epsilon);
+
+		const float last_sample_position = float(num_samples - 1);
+		if (first_position > last_sample_position || last_position < first_position)
+			return false;
+
+		const size_t first_sample_index = static_cast<size_t>(first_position);
+		const size_t last_sample_index = last_position >= last_sample_position ? (num_samples - 1) : static_cast<size_t>(last_position);
+
+		out_range.first_sample_index = first_sample_index;
+		out_range.num_samples = last_sample_index - first_sample_index + 1;
+		return true;
+	}
+
+	bool extract_range(track_array& tracks, float start_time, float end_time)
+	{
+		sample_range range;
+		if (!get_sample_range(tracks.get_sample_rate(), tracks.get_num_samples_per_track(), start_time, end_time, range))
+			return false;
+
+		track_array output_tracks(tracks.get_name(), tracks.get_metadata());
+
+		const size_t num_tracks = tracks.get_num_tracks();
+		for (size_t track_index = 0; track_index < num_tracks; ++track_index)
+		{
+			const track& input_track = tracks[track_index];
+
+			track output_track(input_track.get_type(), input_track.get_sample_rate(), input_track.get_name());
+			output_track.get_description() = input_track.get_description();
+
+			for (size_t sample_index = 0; sample_index < range.num_samples; ++sample_index)
+			{
+				sample smpl = input_track[range.first_sample_index + sample_index];
+				output_track.emplace_back(std::move(smpl));
+			}
+
+			output_tracks.emplace_back(std::move(output_track));
+		}
+
+		tracks = std::move(output_tracks);
+		return true;
+	}
+}
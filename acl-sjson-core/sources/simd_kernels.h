@@ -0,0 +1,81 @@
+#pragma once
+
+////////////////////////////////////////////////////////////////////////////////
+// The MIT License (MIT)
+//
+// Copyright (c) 2022 Nicholas Frechette
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+////////////////////////////////////////////////////////////////////////////////
+
+#include "acl-sjson/sample.h"
+
+#include <cstddef>
+#include <cstdint>
+
+// SIMD kernels are built once per instruction set, each in its own translation unit. The translation units
+// compiled with extra instruction sets must only include headers without inline functions or templates: the
+// linker keeps a single copy of those and it could pick one that uses instructions the CPU does not support.
+namespace acl_sjson
+{
+	// The classes of the 12 values of a sample, each mask has a bit set per matching component
+	// Values that aren't used by the sample type or that are padding must be masked out by the caller
+	struct sample_classes
+	{
+		// NaN or infinite
+		uint32_t non_finite_mask;
+
+		uint32_t denormal_mask;
+
+		// Finite values that overflow once squared
+		uint32_t overflowing_mask;
+
+		// Positive or negative zero
+		uint32_t zero_mask;
+
+		// Negative values, including negative infinity, NaN is never negative
+		uint32_t negative_mask;
+	};
+
+	//////////////////////////////////////////////////////////////////////////
+	// The kernels built for an instruction set, every instruction set computes bit identical results.
+	struct simd_kernels
+	{
+		// Classifies every value of the samples, one set of masks per sample
+		void (*classify_samples)(const sample* samples, size_t num_samples, sample_classes* out_classes);
+
+		// Compares the values of sample pairs selected by 'component_mask' (see get_component_mask(..)), the stride
+		// between samples is either 1 or 0 to repeat the first sample. Samples match when the selected values are
+		// bit for bit identical or when the absolute difference of every value is within the absolute tolerance or
+		// within the relative tolerance scaled by the largest magnitude of the two. The largest absolute difference
+		// of every pair is written, it is infinite when a difference is NaN and zero when the pair is bit for bit identical.
+		void (*compare_samples)(const sample* lhs, size_t lhs_stride, const sample* rhs, size_t rhs_stride, size_t num_samples, uint32_t component_mask,
+			float absolute_tolerance, float relative_tolerance, float* out_errors, uint8_t* out_is_match);
+	};
+
+	//////////////////////////////////////////////////////////////////////////
+	// Returns the kernels of the current instruction set, see cpu_dispatch.h
+	const simd_kernels& get_simd_kernels();
+
+	// Return nullptr when the instruction set isn't available in this build
+	const simd_kernels* get_scalar_kernels();
+	const simd_kernels* get_sse2_kernels();
+	const simd_kernels* get_avx2_kernels();
+	const simd_kernels* get_avx512_kernels();
+}
@@ -0,0 +1,209 @@
+////////////////////////////////////////////////////////////////////////////////
+// The MIT License (MIT)
+//
+// Copyright (c) 2022 Nicholas Frechette
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+////////////////////////////////////////////////////////////////////////////////
+
+#include "simd_kernels.h"
+
+// Only built with AVX2 when the build system enables it for this file, see simd_kernels.h for the headers it can include
+#if defined(__AVX2__)
+	#include <immintrin.h>
+#endif
+
+namespace acl_sjson
+{
+#if defined(__AVX2__)
+	namespace
+	{
+		// The masks of up to 64 values: non-finite, denormal, overflowing, zero, and negative
+		struct wide_classes
+		{
+			uint64_t masks[5];
+		};
+
+		// The magnitude of positive floats compares like integers, NaN and infinity are the largest
+		inline void classify8(__m256 values, uint32_t bit_offset, wide_classes& classes)
+		{
+			const __m256i abs_bits = _mm256_and_si256(_mm256_castps_si256(values), _mm256_set1_epi32(0x7FFFFFFF));
+			const __m256i is_non_finite = _mm256_cmpgt_epi32(abs_bits, _mm256_set1_epi32(0x7F7FFFFF));
+			const __m256i is_zero = _mm256_cmpeq_epi32(abs_bits, _mm256_setzero_si256());
+			const __m256i is_denormal = _mm256_andnot_si256(is_zero, _mm256_cmpgt_epi32(_mm256_set1_epi32(0x00800000), abs_bits));
+			const __m256i is_overflowing = _mm256_andnot_si256(is_non_finite, _mm256_cmpgt_epi32(abs_bits, _mm256_set1_epi32(0x5F7FFFFF)));
+			const __m256 is_negative = _mm256_cmp_ps(values, _mm256_setzero_ps(), _CMP_LT_OQ);
+
+			classes.masks[0] |= uint64_t(_mm256_movemask_ps(_mm256_castsi256_ps(is_non_finite))) << bit_offset;
+			classes.masks[1] |= uint64_t(_mm256_movemask_ps(_mm256_castsi256_ps(is_denormal))) << bit_offset;
+			classes.masks[2] |= uint64_t(_mm256_movemask_ps(_mm256_castsi256_ps(is_overflowing))) << bit_offset;
+			classes.masks[3] |= uint64_t(_mm256_movemask_ps(_mm256_castsi256_ps(is_zero))) << bit_offset;
+			classes.masks[4] |= uint64_t(_mm256_movemask_ps(is_negative)) << bit_offset;
+		}
+
+		inline void classify4(__m128 values, uint32_t bit_offset, wide_classes& classes)
+		{
+			const __m128i abs_bits = _mm_and_si128(_mm_castps_si128(values), _mm_set1_epi32(0x7FFFFFFF));
+			const __m128i is_non_finite = _mm_cmpgt_epi32(abs_bits, _mm_set1_epi32(0x7F7FFFFF));
+			const __m128i is_zero = _mm_cmpeq_epi32(abs_bits, _mm_setzero_si128());
+			const __m128i is_denormal = _mm_andnot_si128(is_zero, _mm_cmplt_epi32(abs_bits, _mm_set1_epi32(0x00800000)));
+			const __m128i is_overflowing = _mm_andnot_si128(is_non_finite, _mm_cmpgt_epi32(abs_bits, _mm_set1_epi32(0x5F7FFFFF)));
+			const __m128 is_negative = _mm_cmplt_ps(values, _mm_setzero_ps());
+
+			classes.masks[0] |= uint64_t(_mm_movemask_ps(_mm_castsi128_ps(is_non_finite))) << bit_offset;
+			classes.masks[1] |= uint64_t(_mm_movemask_ps(_mm_castsi128_ps(is_denormal))) << bit_offset;
+			classes.masks[2] |= uint64_t(_mm_movemask_ps(_mm_castsi128_ps(is_overflowing))) << bit_offset;
+			classes.masks[3] |= uint64_t(_mm_movemask_ps(_mm_castsi128_ps(is_zero))) << bit_offset;
+			classes.masks[4] |= uint64_t(_mm_movemask_ps(is_negative)) << bit_offset;
+		}
+
+		inline sample_classes get_sample_classes(const wide_classes& classes, uint32_t bit_offset)
+		{
+			sample_classes result;
+			result.non_finite_mask = uint32_t(classes.masks[0] >> bit_offset) & 0xFFF;
+			result.denormal_mask = uint32_t(classes.masks[1] >> bit_offset) & 0xFFF;
+			result.overflowing_mask = uint32_t(classes.masks[2] >> bit_offset) & 0xFFF;
+			result.zero_mask = uint32_t(classes.masks[3] >> bit_offset) & 0xFFF;
+			result.negative_mask = uint32_t(classes.masks[4] >> bit_offset) & 0xFFF;
+			return result;
+		}
+
+		static void classify_samples_avx2(const sample* samples, size_t num_samples, sample_classes* out_classes)
+		{
+			// Samples are contiguous, 4 samples span 48 values classified 8 at a time
+			size_t sample_index = 0;
+			for (; sample_index + 4 <= num_samples; sample_index += 4)
+			{
+				const float* values = &samples[sample_index].f1.x;
+
+				wide_classes classes = { { 0, 0, 0, 0, 0 } };
+				for (uint32_t value_index = 0; value_index < 48; value_index += 8)
+					classify8(_mm256_loadu_ps(values + value_index), value_index, classes);
+
+				for (uint32_t lane_index = 0; lane_index < 4; ++lane_index)
+					out_classes[sample_index + lane_index] = get_sample_classes(classes, lane_index * 12);
+			}
+
+			for (; sample_index < num_samples; ++sample_index)
+			{
+				const float* values = &samples[sample_index].f1.x;
+
+				wide_classes classes = { { 0, 0, 0, 0, 0 } };
+				classify8(_mm256_loadu_ps(values), 0, classes);
+				classify4(_mm_loadu_ps(values + 8), 8, classes);
+
+				out_classes[sample_index] = get_sample_classes(classes, 0);
+			}
+		}
+
+		struct compare_state
+		{
+			uint32_t not_equal_mask;
+			uint32_t mismatch_mask;
+			uint32_t nan_mask;
+
+			// The largest error that isn't NaN
+			float max_error;
+		};
+
+		inline void compare8(__m256 lhs, __m256 rhs, __m256 is_active, float absolute_tolerance, float relative_tolerance, compare_state& state)
+		{
+			const __m256 abs_mask = _mm256_castsi256_ps(_mm256_set1_epi32(0x7FFFFFFF));
+			const __m256 is_equal = _mm256_castsi256_ps(_mm256_cmpeq_epi32(_mm256_castps_si256(lhs), _mm256_castps_si256(rhs)));
+
+			const __m256 error = _mm256_and_ps(_mm256_sub_ps(lhs, rhs), abs_mask);
+			const __m256 magnitude = _mm256_max_ps(_mm256_and_ps(lhs, abs_mask), _mm256_and_ps(rhs, abs_mask));
+			const __m256 tolerance = _mm256_max_ps(_mm256_set1_ps(absolute_tolerance), _mm256_mul_ps(magnitude, _mm256_set1_ps(relative_tolerance)));
+
+			// Not less than or equal is also true when the error is NaN
+			const __m256 is_mismatch = _mm256_and_ps(_mm256_cmp_ps(error, tolerance, _CMP_NLE_UQ), is_active);
+			const __m256 is_nan = _mm256_and_ps(_mm256_cmp_ps(error, error, _CMP_UNORD_Q), is_active);
+
+			state.not_equal_mask |= uint32_t(_mm256_movemask_ps(_mm256_andnot_ps(is_equal, is_active)));
+			state.mismatch_mask |= uint32_t(_mm256_movemask_ps(is_mismatch));
+			state.nan_mask |= uint32_t(_mm256_movemask_ps(is_nan));
+
+			// Errors are positive, inactive and NaN lanes are zeroed to not contribute
+			const __m256 valid_error = _mm256_andnot_ps(is_nan, _mm256_and_ps(error, is_active));
+			__m128 max_error = _mm_max_ps(_mm256_castps256_ps128(valid_error), _mm256_extractf128_ps(valid_error, 1));
+			max_error = _mm_max_ps(max_error, _mm_movehl_ps(max_error, max_error));
+			max_error = _mm_max_ss(max_error, _mm_shuffle_ps(max_error, max_error, _MM_SHUFFLE(1, 1, 1, 1)));
+
+			const float error_value = _mm_cvtss_f32(max_error);
+			state.max_error = error_value > state.max_error ? error_value : state.max_error;
+		}
+
+		// Returns all bits set for the lanes with their bit set in the lower 8 bits of the mask
+		inline __m256 get_active_lanes(uint32_t lane_mask)
+		{
+			const __m256i lane_bits = _mm256_setr_epi32(1, 2, 4, 8, 16, 32, 64, 128);
+			return _mm256_castsi256_ps(_mm256_cmpeq_epi32(_mm256_and_si256(_mm256_set1_epi32(int(lane_mask)), lane_bits), lane_bits));
+		}
+
+		static void compare_samples_avx2(const sample* lhs, size_t lhs_stride, const sample* rhs, size_t rhs_stride, size_t num_samples, uint32_t component_mask,
+			float absolute_tolerance, float relative_tolerance, float* out_errors, uint8_t* out_is_match)
+		{
+			// Up to 12 values are compared, the first 8 then the last 4 as the lower half of a second group
+			const __m256 is_active0 = get_active_lanes(component_mask);
+			const __m256 is_active1 = get_active_lanes(component_mask >> 8);
+			const bool has_active1 = (component_mask >> 8) != 0;
+			const float infinity = _mm_cvtss_f32(_mm_castsi128_ps(_mm_set1_epi32(0x7F800000)));
+
+			for (size_t sample_index = 0; sample_index < num_samples; ++sample_index)
+			{
+				const float* lhs_values = &lhs[sample_index * lhs_stride].f1.x;
+				const float* rhs_values = &rhs[sample_index * rhs_stride].f1.x;
+
+				compare_state state = { 0, 0, 0, 0.0F };
+				compare8(_mm256_loadu_ps(lhs_values), _mm256_loadu_ps(rhs_values), is_active0, absolute_tolerance, relative_tolerance, state);
+
+				if (has_active1)
+				{
+					const __m256 lhs_values1 = _mm256_castps128_ps256(_mm_loadu_ps(lhs_values + 8));
+					const __m256 rhs_values1 = _mm256_castps128_ps256(_mm_loadu_ps(rhs_values + 8));
+					compare8(lhs_values1, rhs_values1, is_active1, absolute_tolerance, relative_tolerance, state);
+				}
+
+				// Bit for bit identical samples always match
+				if (state.not_equal_mask == 0)
+				{
+					out_errors[sample_index] = 0.0F;
+					out_is_match[sample_index] = 1;
+					continue;
+				}
+
+				out_errors[sample_index] = state.nan_mask != 0 ? infinity : state.max_error;
+				out_is_match[sample_index] = state.mismatch_mask == 0 ? 1 : 0;
+			}
+		}
+
+		static const simd_kernels k_avx2_kernels = { classify_samples_avx2, compare_samples_avx2 };
+	}
+
+	const simd_kernels* get_avx2_kernels()
+	{
+		return &k_avx2_kernels;
+	}
+#else
+	const simd_kernels* get_avx2_kernels()
+	{
+		return nullptr;
+	}
+#endif
+}
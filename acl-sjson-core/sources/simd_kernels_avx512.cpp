@@ -0,0 +1,161 @@
+////////////////////////////////////////////////////////////////////////////////
+// The MIT License (MIT)
+//
+// Copyright (c) 2022 Nicholas Frechette
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+////////////////////////////////////////////////////////////////////////////////
+
+#include "simd_kernels.h"
+
+// Only built with AVX-512 when the build system enables it for this file, see simd_kernels.h for the headers it can include
+#if defined(__AVX512F__)
+	#include <immintrin.h>
+#endif
+
+namespace acl_sjson
+{
+#if defined(__AVX512F__)
+	namespace
+	{
+		// The masks of up to 64 values: non-finite, denormal, overflowing, zero, and negative
+		struct wide_classes
+		{
+			uint64_t masks[5];
+		};
+
+		// The magnitude of positive floats compares like integers, NaN and infinity are the largest
+		inline void classify16(__m512 values, uint32_t bit_offset, wide_classes& classes)
+		{
+			const __m512i abs_bits = _mm512_and_si512(_mm512_castps_si512(values), _mm512_set1_epi32(0x7FFFFFFF));
+			const __mmask16 is_non_finite = _mm512_cmpgt_epi32_mask(abs_bits, _mm512_set1_epi32(0x7F7FFFFF));
+			const __mmask16 is_zero = _mm512_cmpeq_epi32_mask(abs_bits, _mm512_setzero_si512());
+			const __mmask16 is_denormal = _mm512_mask_cmplt_epi32_mask(static_cast<__mmask16>(~is_zero), abs_bits, _mm512_set1_epi32(0x00800000));
+			const __mmask16 is_overflowing = _mm512_mask_cmpgt_epi32_mask(static_cast<__mmask16>(~is_non_finite), abs_bits, _mm512_set1_epi32(0x5F7FFFFF));
+			const __mmask16 is_negative = _mm512_cmp_ps_mask(values, _mm512_setzero_ps(), _CMP_LT_OQ);
+
+			classes.masks[0] |= uint64_t(is_non_finite) << bit_offset;
+			classes.masks[1] |= uint64_t(is_denormal) << bit_offset;
+			classes.masks[2] |= uint64_t(is_overflowing) << bit_offset;
+			classes.masks[3] |= uint64_t(is_zero) << bit_offset;
+			classes.masks[4] |= uint64_t(is_negative) << bit_offset;
+		}
+
+		inline sample_classes get_sample_classes(const wide_classes& classes, uint32_t bit_offset)
+		{
+			sample_classes result;
+			result.non_finite_mask = uint32_t(classes.masks[0] >> bit_offset) & 0xFFF;
+			result.denormal_mask = uint32_t(classes.masks[1] >> bit_offset) & 0xFFF;
+			result.overflowing_mask = uint32_t(classes.masks[2] >> bit_offset) & 0xFFF;
+			result.zero_mask = uint32_t(classes.masks[3] >> bit_offset) & 0xFFF;
+			result.negative_mask = uint32_t(classes.masks[4] >> bit_offset) & 0xFFF;
+			return result;
+		}
+
+		// The largest of positive values, written with intrinsics that don't read undefined registers
+		// The largest of positive values, the zero masked intrinsics don't read undefined registers
+		inline float reduce_max16(__m512 values)
+		{
+			const __mmask16 all_lanes = 0xFFFF;
+			values = _mm512_maskz_max_ps(all_lanes, values, _mm512_maskz_shuffle_f32x4(all_lanes, values, values, _MM_SHUFFLE(1, 0, 3, 2)));
+			values = _mm512_maskz_max_ps(all_lanes, values, _mm512_maskz_shuffle_f32x4(all_lanes, values, values, _MM_SHUFFLE(2, 3, 0, 1)));
+			values = _mm512_maskz_max_ps(all_lanes, values, _mm512_maskz_shuffle_ps(all_lanes, values, values, _MM_SHUFFLE(1, 0, 3, 2)));
+			values = _mm512_maskz_max_ps(all_lanes, values, _mm512_maskz_shuffle_ps(all_lanes, values, values, _MM_SHUFFLE(2, 3, 0, 1)));
+			return _mm512_cvtss_f32(values);
+		}
+
+		static void classify_samples_avx512(const sample* samples, size_t num_samples, sample_classes* out_classes)
+		{
+			// Samples are contiguous, 4 samples span 48 values classified 16 at a time
+			size_t sample_index = 0;
+			for (; sample_index + 4 <= num_samples; sample_index += 4)
+			{
+				const float* values = &samples[sample_index].f1.x;
+
+				wide_classes classes = { { 0, 0, 0, 0, 0 } };
+				for (uint32_t value_index = 0; value_index < 48; value_index += 16)
+					classify16(_mm512_loadu_ps(values + value_index), value_index, classes);
+
+				for (uint32_t lane_index = 0; lane_index < 4; ++lane_index)
+					out_classes[sample_index + lane_index] = get_sample_classes(classes, lane_index * 12);
+			}
+
+			// The masked load does not touch the memory past the sample
+			for (; sample_index < num_samples; ++sample_index)
+			{
+				wide_classes classes = { { 0, 0, 0, 0, 0 } };
+				classify16(_mm512_maskz_loadu_ps(0x0FFF, &samples[sample_index].f1.x), 0, classes);
+
+				out_classes[sample_index] = get_sample_classes(classes, 0);
+			}
+		}
+
+		static void compare_samples_avx512(const sample* lhs, size_t lhs_stride, const sample* rhs, size_t rhs_stride, size_t num_samples, uint32_t component_mask,
+			float absolute_tolerance, float relative_tolerance, float* out_errors, uint8_t* out_is_match)
+		{
+			// Every value of a sample fits in a single register
+			const __mmask16 is_active = static_cast<__mmask16>(component_mask);
+			const __m512 absolute_tolerance_ = _mm512_set1_ps(absolute_tolerance);
+			const __m512 relative_tolerance_ = _mm512_set1_ps(relative_tolerance);
+			const float infinity = _mm_cvtss_f32(_mm_castsi128_ps(_mm_set1_epi32(0x7F800000)));
+
+			for (size_t sample_index = 0; sample_index < num_samples; ++sample_index)
+			{
+				const __m512 lhs_values = _mm512_maskz_loadu_ps(is_active, &lhs[sample_index * lhs_stride].f1.x);
+				const __m512 rhs_values = _mm512_maskz_loadu_ps(is_active, &rhs[sample_index * rhs_stride].f1.x);
+
+				// Bit for bit identical samples always match
+				const __mmask16 is_equal = _mm512_mask_cmpeq_epi32_mask(is_active, _mm512_castps_si512(lhs_values), _mm512_castps_si512(rhs_values));
+				if (is_equal == is_active)
+				{
+					out_errors[sample_index] = 0.0F;
+					out_is_match[sample_index] = 1;
+					continue;
+				}
+
+				const __m512 error = _mm512_abs_ps(_mm512_sub_ps(lhs_values, rhs_values));
+				const __m512 magnitude = _mm512_maskz_max_ps(is_active, _mm512_abs_ps(lhs_values), _mm512_abs_ps(rhs_values));
+				const __m512 tolerance = _mm512_maskz_max_ps(is_active, absolute_tolerance_, _mm512_maskz_mul_ps(is_active, magnitude, relative_tolerance_));
+
+				// Not less than or equal is also true when the error is NaN
+				const __mmask16 is_mismatch = _mm512_mask_cmp_ps_mask(is_active, error, tolerance, _CMP_NLE_UQ);
+				const __mmask16 is_nan = _mm512_mask_cmp_ps_mask(is_active, error, error, _CMP_UNORD_Q);
+
+				// Errors are positive, inactive and NaN lanes are zeroed to not contribute
+				const float max_error = reduce_max16(_mm512_maskz_mov_ps(static_cast<__mmask16>(is_active & ~is_nan), error));
+
+				out_errors[sample_index] = is_nan != 0 ? infinity : max_error;
+				out_is_match[sample_index] = is_mismatch == 0 ? 1 : 0;
+			}
+		}
+
+		static const simd_kernels k_avx512_kernels = { classify_samples_avx512, compare_samples_avx512 };
+	}
+
+	const simd_kernels* get_avx512_kernels()
+	{
+		return &k_avx512_kernels;
+	}
+#else
+	const simd_kernels* get_avx512_kernels()
+	{
+		return nullptr;
+	}
+#endif
+}
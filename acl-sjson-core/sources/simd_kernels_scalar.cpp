@@ -0,0 +1,125 @@
+////////////////////////////////////////////////////////////////////////////////
+// The MIT License (MIT)
+//
+// Copyright (c) 2022 Nicholas Frechette
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+////////////////////////////////////////////////////////////////////////////////
+
+#include "simd_kernels.h"
+
+#include <cmath>
+#include <cstring>
+
+// The reference implementation, every other instruction set must match it bit for bit
+namespace acl_sjson
+{
+	namespace
+	{
+		// Squaring a value with a magnitude of 2^64 or more overflows
+		static constexpr float k_min_overflowing_square_root = 18446744073709551616.0F;
+
+		static void classify_samples_scalar(const sample* samples, size_t num_samples, sample_classes* out_classes)
+		{
+			for (size_t sample_index = 0; sample_index < num_samples; ++sample_index)
+			{
+				const float* values = &samples[sample_index].f1.x;
+
+				sample_classes classes = { 0, 0, 0, 0, 0 };
+				for (uint32_t component_index = 0; component_index < 12; ++component_index)
+				{
+					const float value = values[component_index];
+					const uint32_t component_bit = 1U << component_index;
+
+					if (!std::isfinite(value))
+						classes.non_finite_mask |= component_bit;
+					else if (std::fpclassify(value) == FP_SUBNORMAL)
+						classes.denormal_mask |= component_bit;
+					else if (std::fabs(value) >= k_min_overflowing_square_root)
+						classes.overflowing_mask |= component_bit;
+
+					if (value == 0.0F)
+						classes.zero_mask |= component_bit;
+					else if (value < 0.0F)
+						classes.negative_mask |= component_bit;
+				}
+
+				out_classes[sample_index] = classes;
+			}
+		}
+
+		// Returns the rhs when either value is NaN, like the SIMD max instructions
+		inline float max_like_simd(float lhs, float rhs)
+		{
+			return lhs > rhs ? lhs : rhs;
+		}
+
+		static void compare_samples_scalar(const sample* lhs, size_t lhs_stride, const sample* rhs, size_t rhs_stride, size_t num_samples, uint32_t component_mask,
+			float absolute_tolerance, float relative_tolerance, float* out_errors, uint8_t* out_is_match)
+		{
+			for (size_t sample_index = 0; sample_index < num_samples; ++sample_index)
+			{
+				const float* lhs_values = &lhs[sample_index * lhs_stride].f1.x;
+				const float* rhs_values = &rhs[sample_index * rhs_stride].f1.x;
+
+				// Identical samples are the common case, skip the tolerance checks
+				bool is_equal = true;
+				for (uint32_t component_index = 0; component_index < 12; ++component_index)
+				{
+					if ((component_mask & (1U << component_index)) != 0 && std::memcmp(&lhs_values[component_index], &rhs_values[component_index], sizeof(float)) != 0)
+						is_equal = false;
+				}
+
+				if (is_equal)
+				{
+					out_errors[sample_index] = 0.0F;
+					out_is_match[sample_index] = 1;
+					continue;
+				}
+
+				bool is_match = true;
+				float max_error = 0.0F;
+				for (uint32_t component_index = 0; component_index < 12; ++component_index)
+				{
+					if ((component_mask & (1U << component_index)) == 0)
+						continue;
+
+					const float error = std::fabs(lhs_values[component_index] - rhs_values[component_index]);
+					const float magnitude = max_like_simd(std::fabs(lhs_values[component_index]), std::fabs(rhs_values[component_index]));
+					const float tolerance = max_like_simd(absolute_tolerance, magnitude * relative_tolerance);
+
+					if (!(error <= tolerance))
+						is_match = false;
+
+					max_error = std::isnan(error) ? INFINITY : max_like_simd(max_error, error);
+				}
+
+				out_errors[sample_index] = max_error;
+				out_is_match[sample_index] = is_match ? 1 : 0;
+			}
+		}
+
+		static const simd_kernels k_scalar_kernels = { classify_samples_scalar, compare_samples_scalar };
+	}
+
+	const simd_kernels* get_scalar_kernels()
+	{
+		return &k_scalar_kernels;
+	}
+}
@@ -0,0 +1,93 @@
+////////////////////////////////////////////////////////////////////////////////
+// The MIT License (MIT)
+//
+// Copyright (c) 2022 Nicholas Frechette
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+////////////////////////////////////////////////////////////////////////////////
+
+#include "simd_kernels.h"
+#include "sample_math.h"
+
+// SSE2 is part of the baseline of x64 builds, the shared math helpers can be used here
+namespace acl_sjson
+{
+#if defined(ACL_SJSON_SSE2_INTRINSICS)
+	namespace
+	{
+		static void classify_samples_sse2(const sample* samples, size_t num_samples, sample_classes* out_classes)
+		{
+			for (size_t sample_index = 0; sample_index < num_samples; ++sample_index)
+			{
+				const float* values = &samples[sample_index].f1.x;
+
+				sample_classes classes = { 0, 0, 0, 0, 0 };
+				for (uint32_t component_index = 0; component_index < 12; component_index += 4)
+				{
+					const math::value_classes value_classes = math::classify4(values + component_index);
+					classes.non_finite_mask |= uint32_t(value_classes.non_finite_mask) << component_index;
+					classes.denormal_mask |= uint32_t(value_classes.denormal_mask) << component_index;
+					classes.overflowing_mask |= uint32_t(value_classes.overflowing_mask) << component_index;
+
+					int zero_mask;
+					int negative_mask;
+					math::compare_to_zero4(values + component_index, zero_mask, negative_mask);
+					classes.zero_mask |= uint32_t(zero_mask) << component_index;
+					classes.negative_mask |= uint32_t(negative_mask) << component_index;
+				}
+
+				out_classes[sample_index] = classes;
+			}
+		}
+
+		static void compare_samples_sse2(const sample* lhs, size_t lhs_stride, const sample* rhs, size_t rhs_stride, size_t num_samples, uint32_t component_mask,
+			float absolute_tolerance, float relative_tolerance, float* out_errors, uint8_t* out_is_match)
+		{
+			for (size_t sample_index = 0; sample_index < num_samples; ++sample_index)
+			{
+				const float* lhs_values = &lhs[sample_index * lhs_stride].f1.x;
+				const float* rhs_values = &rhs[sample_index * rhs_stride].f1.x;
+
+				// Identical samples are the common case, skip the tolerance checks
+				if (math::are_bit_equal(lhs_values, rhs_values, component_mask))
+				{
+					out_errors[sample_index] = 0.0F;
+					out_is_match[sample_index] = 1;
+					continue;
+				}
+
+				const bool is_match = math::compare_within_tolerance(lhs_values, rhs_values, component_mask, absolute_tolerance, relative_tolerance, out_errors[sample_index]);
+				out_is_match[sample_index] = is_match ? 1 : 0;
+			}
+		}
+
+		static const simd_kernels k_sse2_kernels = { classify_samples_sse2, compare_samples_sse2 };
+	}
+
+	const simd_kernels* get_sse2_kernels()
+	{
+		return &k_sse2_kernels;
+	}
+#else
+	const simd_kernels* get_sse2_kernels()
+	{
+		return nullptr;
+	}
+#endif
+}
@@ -0,0 +1,72 @@
+////////////////////////////////////////////////////////////////////////////////
+// The MIT License (MIT)
+//
+// Copyright (c) 2022 Nicholas Frechette
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+////////////////////////////////////////////////////////////////////////////////
+
+#include "sjson_reader.h"
+
+#include "acl-sjson/io.h"
+
+#include <sjson/parser.h>
+
+#include <cstdio>
+
+namespace acl_sjson
+{
+	bool parse_sjson_file(const char* filename, const std::function<bool(sjson::Parser&)>& parse_root)
+	{
+		char* buffer = nullptr;
+		size_t file_size = 0;
+		if (!read_file(filename, buffer, file_size))
+			return false;
+
+		sjson::Parser parser(buffer, file_size);
+		const bool is_valid = parse_root(parser) && parser.remainder_is_comments_and_whitespace();
+
+		if (!is_valid)
+		{
+			const sjson::ParserError error = parser.get_error();
+			if (error.error != sjson::ParserError::None)
+				printf("Failed to parse %s on line %u column %u: %s\n", filename, error.line, error.column, error.get_description());
+		}
+
+		free_file_memory(buffer);
+		return is_valid;
+	}
+
+	bool read_strings(sjson::Parser& parser, const char* key, bool is_required, std::vector<std::string>& out_strings)
+	{
+		if (is_required ? !parser.array_begins(key) : !parser.try_array_begins(key))
+			return !is_required && parser.is_valid();
+
+		while (!parser.try_array_ends())
+		{
+			sjson::StringView value;
+			if (!parser.read(&value, 1))
+				return false;
+
+			out_strings.emplace_back(value.c_str(), value.size());
+		}
+
+		return parser.is_valid();
+	}
+}
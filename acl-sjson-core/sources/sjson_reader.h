@@ -0,0 +1,43 @@
+#pragma once
+
+////////////////////////////////////////////////////////////////////////////////
+// The MIT License (MIT)
+//
+// Copyright (c) 2022 Nicholas Frechette
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+////////////////////////////////////////////////////////////////////////////////
+
+#include <sjson/parser.h>
+
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace acl_sjson
+{
+	//////////////////////////////////////////////////////////////////////////
+	// Reads a SJSON file and parses its root with the provided function, keys are read in document order.
+	// Parsing errors are printed, the function prints its own errors.
+	bool parse_sjson_file(const char* filename, const std::function<bool(sjson::Parser&)>& parse_root);
+
+	//////////////////////////////////////////////////////////////////////////
+	// Reads the array of strings with the provided key, the array is optional unless required.
+	bool read_strings(sjson::Parser& parser, const char* key, bool is_required, std::vector<std::string>& out_strings);
+}
@@ -0,0 +1,605 @@
+////////////////////////////////////////////////////////////////////////////////
+// The MIT License (MIT)
+//
+// Copyright (c) 2022 Nicholas Frechette
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+////////////////////////////////////////////////////////////////////////////////
+
+#include "acl-sjson/sjson_writer.h"
+#include "acl-sjson/parallel.h"
+#include "acl-sjson/sample.h"
+#include "acl-sjson/track.h"
+#include "acl-sjson/track_array.h"
+#include "acl-sjson/track_description.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace acl_sjson
+{
+	namespace
+	{
+		// The version of the SJSON file format written, see regression_tests/format_reference.acl.sjson
+		static constexpr uint32_t k_sjson_format_version = 5;
+
+		static const char* get_track_type_name(sample_type type)
+		{
+			switch (type)
+			{
+			case sample_type::float1:	return "float1f";
+			case sample_type::float2:	return "float2f";
+			case sample_type::float3:	return "float3f";
+			case sample_type::float4:	return "float4f";
+			case sample_type::vector4:	return "vector4f";
+			case sample_type::qvv:		return "qvvf";
+			default:					return nullptr;
+			}
+		}
+
+		static bool is_finite(const float* values, size_t num_values)
+		{
+			for (size_t value_index = 0; value_index < num_values; ++value_index)
+			{
+				if (!std::isfinite(values[value_index]))
+					return false;
+			}
+
+			return true;
+		}
+
+		static bool is_finite(sample_type type, const sample& smpl)
+		{
+			if (type == sample_type::qvv)
+				return is_finite(&smpl.transform.rotation.x, 4) && is_finite(&smpl.transform.translation.x, 3) && is_finite(&smpl.transform.scale.x, 3);
+
+			return is_finite(&smpl.f4.x, get_sample_size(type) / sizeof(float));
+		}
+
+		static bool is_identity(const qvv& transform)
+		{
+			const qvv identity = { { 0.0F, 0.0F, 0.0F, 1.0F }, { 0.0F, 0.0F, 0.0F, 0.0F }, { 1.0F, 1.0F, 1.0F, 0.0F } };
+			return std::memcmp(&transform.rotation, &identity.rotation, sizeof(quat)) == 0
+				&& std::memcmp(&transform.translation, &identity.translation, sizeof(float) * 3) == 0
+				&& std::memcmp(&transform.scale, &identity.scale, sizeof(float) * 3) == 0;
+		}
+
+		// Shortest float to decimal conversion based on Ryu by Ulf Adams, see "Ryu: fast float-to-string conversion" (PLDI 2018)
+		// The bounds of the interval of values that round to a float are scaled by a power of 10 with 64 bit multipliers,
+		// digits are then removed while both bounds agree. The result is the shortest decimal that reads back to the float
+		// and the closest one to its exact value when several are as short.
+		static constexpr int32_t k_float_mantissa_bits = 23;
+		static constexpr int32_t k_float_bias = 127;
+		static constexpr int32_t k_float_pow5_inv_bit_count = 59;
+		static constexpr int32_t k_float_pow5_bit_count = 61;
+
+		// floor(2^(pow5_bits(i) - 1 + 59) / 5^i) + 1
+		static const uint64_t k_float_pow5_inv_split[31] =
+		{
+			0x0800000000000001ULL, 0x0666666666666667ULL, 0x051EB851EB851EB9ULL, 0x04189374BC6A7EFAULL,
+			0x068DB8BAC710CB2AULL, 0x053E2D6238DA3C22ULL, 0x0431BDE82D7B634EULL, 0x06B5FCA6AF2BD216ULL,
+			0x055E63B88C230E78ULL, 0x044B82FA09B5A52DULL, 0x06DF37F675EF6EAEULL, 0x057F5FF85E592558ULL,
+			0x0465E6604B7A8447ULL, 0x0709709A125DA071ULL, 0x05A126E1A84AE6C1ULL, 0x0480EBE7B9D58567ULL,
+			0x0734ACA5F6226F0BULL, 0x05C3BD5191B525A3ULL, 0x049C97747490EAE9ULL, 0x0760F253EDB4AB0EULL,
+			0x05E72843249088D8ULL, 0x04B8ED0283A6D3E0ULL, 0x078E480405D7B966ULL, 0x060B6CD004AC9452ULL,
+			0x04D5F0A66A23A9DBULL, 0x07BCB43D769F762BULL, 0x063090312BB2C4EFULL, 0x04F3A68DBC8F03F3ULL,
+			0x07EC3DAF94180651ULL, 0x065697BFA9ACD1DAULL, 0x051212FFBAF0A7E2ULL,
+		};
+
+		// floor(5^i / 2^(pow5_bits(i) - 61))
+		static const uint64_t k_float_pow5_split[47] =
+		{
+			0x1000000000000000ULL, 0x1400000000000000ULL, 0x1900000000000000ULL, 0x1F40000000000000ULL,
+			0x1388000000000000ULL, 0x186A000000000000ULL, 0x1E84800000000000ULL, 0x1312D00000000000ULL,
+			0x17D7840000000000ULL, 0x1DCD650000000000ULL, 0x12A05F2000000000ULL, 0x174876E800000000ULL,
+			0x1D1A94A200000000ULL, 0x12309CE540000000ULL, 0x16BCC41E90000000ULL, 0x1C6BF52634000000ULL,
+			0x11C37937E0800000ULL, 0x16345785D8A00000ULL, 0x1BC16D674EC80000ULL, 0x1158E460913D0000ULL,
+			0x15AF1D78B58C4000ULL, 0x1B1AE4D6E2EF5000ULL, 0x10F0CF064DD59200ULL, 0x152D02C7E14AF680ULL,
+			0x1A784379D99DB420ULL, 0x108B2A2C28029094ULL, 0x14ADF4B7320334B9ULL, 0x19D971E4FE8401E7ULL,
+			0x1027E72F1F128130ULL, 0x1431E0FAE6D7217CULL, 0x193E5939A08CE9DBULL, 0x1F8DEF8808B02452ULL,
+			0x13B8B5B5056E16B3ULL, 0x18A6E32246C99C60ULL, 0x1ED09BEAD87C0378ULL, 0x13426172C74D822BULL,
+			0x1812F9CF7920E2B6ULL, 0x1E17B84357691B64ULL, 0x12CED32A16A1B11EULL, 0x178287F49C4A1D66ULL,
+			0x1D6329F1C35CA4BFULL, 0x125DFA371A19E6F7ULL, 0x16F578C4E0A060B5ULL, 0x1CB2D6F618C878E3ULL,
+			0x11EFC659CF7D4B8DULL, 0x166BB7F0435C9E71ULL, 0x1C06A5EC5433C60DULL,
+		};
+
+		// The number of bits of 5^e, e in [0, 3528]
+		inline int32_t pow5_bits(int32_t e) { return static_cast<int32_t>(((static_cast<uint32_t>(e) * 1217359U) >> 19) + 1); }
+
+		// floor(log10(2^e)) and floor(log10(5^e)), e in [0, 1650] and [0, 2620]
+		inline uint32_t log10_pow2(int32_t e) { return (static_cast<uint32_t>(e) * 78913U) >> 18; }
+		inline uint32_t log10_pow5(int32_t e) { return (static_cast<uint32_t>(e) * 732923U) >> 20; }
+
+		inline bool is_multiple_of_pow5(uint32_t value, uint32_t power)
+		{
+			uint32_t count = 0;
+			for (; value != 0 && (value % 5) == 0 && count < power; value /= 5)
+				++count;
+
+			return count >= power;
+		}
+
+		inline bool is_multiple_of_pow2(uint32_t value, uint32_t power) { return (value & ((1U << power) - 1)) == 0; }
+
+		inline uint32_t mul_shift(uint32_t value, uint64_t factor, int32_t shift)
+		{
+			const uint64_t low_bits = uint64_t(value) * uint32_t(factor);
+			const uint64_t high_bits = uint64_t(value) * uint32_t(factor >> 32);
+			return static_cast<uint32_t>(((low_bits >> 32) + high_bits) >> (shift - 32));
+		}
+
+		// A float written as digits * 10^exponent
+		struct decimal_float
+		{
+			uint32_t digits;
+			int32_t exponent;
+		};
+
+		static decimal_float to_shortest_decimal(uint32_t ieee_mantissa, uint32_t ieee_exponent)
+		{
+			int32_t e2;
+			uint32_t m2;
+			if (ieee_exponent == 0)
+			{
+				e2 = 1 - k_float_bias - k_float_mantissa_bits - 2;
+				m2 = ieee_mantissa;
+			}
+			else
+			{
+				e2 = static_cast<int32_t>(ieee_exponent) - k_float_bias - k_float_mantissa_bits - 2;
+				m2 = (1U << k_float_mantissa_bits) | ieee_mantissa;
+			}
+
+			// Round to even, the bounds are part of the interval when the mantissa is even
+			const bool accept_bounds = (m2 & 1) == 0;
+
+			// The value and the halfway points to its neighbors, the lower one is closer at a power of 2
+			const uint32_t mv = 4 * m2;
+			const uint32_t mp = 4 * m2 + 2;
+			const uint32_t mm_shift = ieee_mantissa != 0 || ieee_exponent <= 1 ? 1 : 0;
+			const uint32_t mm = 4 * m2 - 1 - mm_shift;
+
+			uint32_t vr;
+			uint32_t vp;
+			uint32_t vm;
+			int32_t e10;
+			bool vm_is_trailing_zeros = false;
+			bool vr_is_trailing_zeros = false;
+			uint32_t last_removed_digit = 0;
+
+			if (e2 >= 0)
+			{
+				const uint32_t q = log10_pow2(e2);
+				e10 = static_cast<int32_t>(q);
+				const int32_t k = k_float_pow5_inv_bit_count + pow5_bits(static_cast<int32_t>(q)) - 1;
+				const int32_t i = -e2 + static_cast<int32_t>(q) + k;
+				vr = mul_shift(mv, k_float_pow5_inv_split[q], i);
+				vp = mul_shift(mp, k_float_pow5_inv_split[q], i);
+				vm = mul_shift(mm, k_float_pow5_inv_split[q], i);
+
+				if (q != 0 && (vp - 1) / 10 <= vm / 10)
+				{
+					// The loop below removes a single digit, compute it exactly
+					const int32_t l = k_float_pow5_inv_bit_count + pow5_bits(static_cast<int32_t>(q - 1)) - 1;
+					last_removed_digit = mul_shift(mv, k_float_pow5_inv_split[q - 1], -e2 + static_cast<int32_t>(q) - 1 + l) % 10;
+				}
+
+				if (q <= 9)
+				{
+					// Only one of mp, mv, and mm can be a multiple of 5
+					if ((mv % 5) == 0)
+						vr_is_trailing_zeros = is_multiple_of_pow5(mv, q);
+					else if (accept_bounds)
+						vm_is_trailing_zeros = is_multiple_of_pow5(mm, q);
+					else
+						vp -= is_multiple_of_pow5(mp, q) ? 1 : 0;
+				}
+			}
+			else
+			{
+				const uint32_t q = log10_pow5(-e2);
+				e10 = static_cast<int32_t>(q) + e2;
+				const int32_t i = -e2 - static_cast<int32_t>(q);
+				const int32_t k = pow5_bits(i) - k_float_pow5_bit_count;
+				int32_t j = static_cast<int32_t>(q) - k;
+				vr = mul_shift(mv, k_float_pow5_split[i], j);
+				vp = mul_shift(mp, k_float_pow5_split[i], j);
+				vm = mul_shift(mm, k_float_pow5_split[i], j);
+
+				if (q != 0 && (vp - 1) / 10 <= vm / 10)
+				{
+					j = static_cast<int32_t>(q) - 1 - (pow5_bits(i + 1) - k_float_pow5_bit_count);
+					last_removed_digit = mul_shift(mv, k_float_pow5_split[i + 1], j) % 10;
+				}
+
+				if (q <= 1)
+				{
+					// mv has at least q trailing zero bits
+					vr_is_trailing_zeros = true;
+					if (accept_bounds)
+						vm_is_trailing_zeros = mm_shift == 1;
+					else
+						--vp;
+				}
+				else if (q < 31)
+					vr_is_trailing_zeros = is_multiple_of_pow2(mv, q - 1);
+			}
+
+			// Remove digits while the bounds still differ
+			int32_t num_removed = 0;
+			uint32_t output;
+			if (vm_is_trailing_zeros || vr_is_trailing_zeros)
+			{
+				while (vp / 10 > vm / 10)
+				{
+					vm_is_trailing_zeros &= (vm % 10) == 0;
+					vr_is_trailing_zeros &= last_removed_digit == 0;
+					last_removed_digit = vr % 10;
+					vr /= 10;
+					vp /= 10;
+					vm /= 10;
+					++num_removed;
+				}
+
+				if (vm_is_trailing_zeros)
+				{
+					while ((vm % 10) == 0)
+					{
+						vr_is_trailing_zeros &= last_removed_digit == 0;
+						last_removed_digit = vr % 10;
+						vr /= 10;
+						vp /= 10;
+						vm /= 10;
+						++num_removed;
+					}
+				}
+
+				// Round half to even when the exact value ends with 5 followed by zeros
+				if (vr_is_trailing_zeros && last_removed_digit == 5 && (vr % 2) == 0)
+					last_removed_digit = 4;
+
+				output = vr + (((vr == vm && (!accept_bounds || !vm_is_trailing_zeros)) || last_removed_digit >= 5) ? 1 : 0);
+			}
+			else
+			{
+				while (vp / 10 > vm / 10)
+				{
+					last_removed_digit = vr % 10;
+					vr /= 10;
+					vp /= 10;
+					vm /= 10;
+					++num_removed;
+				}
+
+				output = vr + ((vr == vm || last_removed_digit >= 5) ? 1 : 0);
+			}
+
+			return decimal_float{ output, e10 + num_removed };
+		}
+
+		static void append_float(std::string& out, float value)
+		{
+			char buffer[32];
+			const size_t length = format_shortest_float(value, buffer, sizeof(buffer));
+			out.append(buffer, length);
+		}
+
+		static void append_uint(std::string& out, uint32_t value)
+		{
+			char buffer[16];
+			const int length = snprintf(buffer, sizeof(buffer), "%u", value);
+			out.append(buffer, static_cast<size_t>(length));
+		}
+
+		static void append_string(std::string& out, const char* value)
+		{
+			out += '"';
+			for (const char* ptr = value; *ptr != '\0'; ++ptr)
+			{
+				if (*ptr == '"' || *ptr == '\\')
+					out += '\\';
+
+				out += *ptr;
+			}
+			out += '"';
+		}
+
+		static void append_floats(std::string& out, const float* values, size_t num_values)
+		{
+			out += "[ ";
+			for (size_t value_index = 0; value_index < num_values; ++value_index)
+			{
+				if (value_index != 0)
+					out += ", ";
+
+				append_float(out, values[value_index]);
+			}
+			out += " ]";
+		}
+
+		static void append_sample(std::string& out, sample_type type, const sample& smpl)
+		{
+			// Transforms are of the form: [ [ rot.x, rot.y, rot.z, rot.w ], [ trans.x, trans.y, trans.z ], [ scale.x, scale.y, scale.z ] ]
+			if (type == sample_type::qvv)
+			{
+				out += "[ ";
+				append_floats(out, &smpl.transform.rotation.x, 4);
+				out += ", ";
+				append_floats(out, &smpl.transform.translation.x, 3);
+				out += ", ";
+				append_floats(out, &smpl.transform.scale.x, 3);
+				out += " ]";
+			}
+			else
+				append_floats(out, &smpl.f4.x, get_sample_size(type) / sizeof(float));
+		}
+
+		static void append_track(std::string& out, const track& track_, acl_version version)
+		{
+			const sample_type type = track_.get_type();
+			const track_description& desc = track_.get_description();
+
+			out += "\t{\n";
+			out += "\t\tname = ";
+			append_string(out, track_.get_name());
+			out += "\n\t\ttype = ";
+			append_string(out, get_track_type_name(type));
+
+			if (type == sample_type::qvv)
+			{
+				out += "\n\t\tprecision = ";
+				append_float(out, desc.transform.precision);
+				out += "\n\t\toutput_index = ";
+				append_uint(out, desc.transform.output_index);
+				out += "\n\t\tparent_index = ";
+				append_uint(out, desc.transform.parent_index);
+				out += "\n\t\tshell_distance = ";
+				append_float(out, desc.transform.shell_distance);
+
+				if (version == acl_version::v02_00_00)
+				{
+					// ACL 2.1 removed the constant thresholds
+					out += "\n\t\tconstant_rotation_threshold_angle = ";
+					append_float(out, desc.transform.constant_rotation_threshold_angle);
+					out += "\n\t\tconstant_translation_threshold = ";
+					append_float(out, desc.transform.constant_translation_threshold);
+					out += "\n\t\tconstant_scale_threshold = ";
+					append_float(out, desc.transform.constant_scale_threshold);
+				}
+				else if (!is_identity(desc.transform.default_value))
+				{
+					// ACL 2.0 has no bind pose, it is optional since ACL 2.1 and defaults to the identity
+					out += "\n\t\tbind_rotation = ";
+					append_floats(out, &desc.transform.default_value.rotation.x, 4);
+					out += "\n\t\tbind_translation = ";
+					append_floats(out, &desc.transform.default_value.translation.x, 3);
+					out += "\n\t\tbind_scale = ";
+					append_floats(out, &desc.transform.default_value.scale.x, 3);
+				}
+			}
+			else
+			{
+				out += "\n\t\tprecision = ";
+				append_float(out, desc.scalar.precision);
+				out += "\n\t\toutput_index = ";
+				append_uint(out, desc.scalar.output_index);
+			}
+
+			out += "\n\t\tdata =\n\t\t[\n";
+
+			const size_t num_samples = track_.get_num_samples();
+			if (track_.is_collapsed())
+			{
+				// Every sample is identical, format it once
+				std::string line = "\t\t\t";
+				append_sample(line, type, track_[0]);
+				line += '\n';
+
+				out.reserve(out.size() + line.size() * num_samples + 64);
+				for (size_t sample_index = 0; sample_index < num_samples; ++sample_index)
+					out += line;
+			}
+			else
+			{
+				for (size_t sample_index = 0; sample_index < num_samples; ++sample_index)
+				{
+					out += "\t\t\t";
+					append_sample(out, type, track_[sample_index]);
+					out += '\n';
+				}
+			}
+
+			out += "\t\t]\n";
+			out += "\t}\n";
+		}
+	}
+
+	size_t format_shortest_float(float value, char* buffer, size_t buffer_size)
+	{
+		if (!std::isfinite(value) || buffer_size == 0)
+			return 0;
+
+		uint32_t bits;
+		std::memcpy(&bits, &value, sizeof(float));
+
+		const bool is_negative = (bits >> 31) != 0;
+		const uint32_t ieee_exponent = (bits >> k_float_mantissa_bits) & 0xFF;
+		const uint32_t ieee_mantissa = bits & ((1U << k_float_mantissa_bits) - 1);
+
+		char text[32];
+		size_t length = 0;
+		if (is_negative)
+			text[length++] = '-';
+
+		if (ieee_exponent == 0 && ieee_mantissa == 0)
+			text[length++] = '0';
+		else
+		{
+			const decimal_float decimal = to_shortest_decimal(ieee_mantissa, ieee_exponent);
+
+			char digits[10] = {};
+			int32_t num_digits = 0;
+			for (uint32_t remaining = decimal.digits; remaining != 0; remaining /= 10)
+				digits[num_digits++] = static_cast<char>('0' + (remaining % 10));
+			std::reverse(digits, digits + num_digits);
+
+			// The exponent of the first digit, laid out like %g except that integers below 1e9 keep their digits (e.g. 30 and not 3e+01)
+			const int32_t exponent = decimal.exponent + num_digits - 1;
+			if (exponent >= -4 && exponent < 9)
+			{
+				if (exponent < 0)
+				{
+					text[length++] = '0';
+					text[length++] = '.';
+					for (int32_t zero_index = -1; zero_index > exponent; --zero_index)
+						text[length++] = '0';
+					for (int32_t digit_index = 0; digit_index < num_digits; ++digit_index)
+						text[length++] = digits[digit_index];
+				}
+				else
+				{
+					for (int32_t digit_index = 0; digit_index <= std::max(exponent, num_digits - 1); ++digit_index)
+					{
+						if (digit_index == exponent + 1)
+							text[length++] = '.';
+
+						text[length++] = digit_index < num_digits ? digits[digit_index] : '0';
+					}
+				}
+			}
+			else
+			{
+				text[length++] = digits[0];
+				if (num_digits > 1)
+				{
+					text[length++] = '.';
+					for (int32_t digit_index = 1; digit_index < num_digits; ++digit_index)
+						text[length++] = digits[digit_index];
+				}
+
+				const int32_t abs_exponent = std::abs(exponent);
+				text[length++] = 'e';
+				text[length++] = exponent < 0 ? '-' : '+';
+				if (abs_exponent >= 10)
+					text[length++] = static_cast<char>('0' + (abs_exponent / 10));
+				else
+					text[length++] = '0';
+				text[length++] = static_cast<char>('0' + (abs_exponent % 10));
+			}
+		}
+
+		if (length >= buffer_size)
+			return 0;
+
+		std::memcpy(buffer, text, length);
+		buffer[length] = '\0';
+		return length;
+	}
+
+	bool can_write_sjson_decimal(const track_array& tracks)
+	{
+		for (size_t track_index = 0; track_index < tracks.get_num_tracks(); ++track_index)
+		{
+			const track& track_ = tracks[track_index];
+			const sample_type type = track_.get_type();
+
+			// Collapsed tracks only hold a single distinct sample
+			const size_t num_samples = track_.is_collapsed() ? 1 : track_.get_num_samples();
+			for (size_t sample_index = 0; sample_index < num_samples; ++sample_index)
+			{
+				if (!is_finite(type, track_[sample_index]))
+					return false;
+			}
+		}
+
+		return true;
+	}
+
+	bool write_sjson_tracks(const char* filename, const track_array& tracks, acl_version version)
+	{
+		if (version != acl_version::v02_00_00 && version != acl_version::v02_01_00)
+		{
+			printf("Unsupported ACL version: %s\n", to_string(version));
+			return false;
+		}
+
+		const size_t num_tracks = tracks.get_num_tracks();
+		for (size_t track_index = 0; track_index < num_tracks; ++track_index)
+		{
+			const sample_type type = tracks[track_index].get_type();
+			if (get_track_type_name(type) == nullptr)
+			{
+				printf("Unsupported sample type: %s\n", to_string(type));
+				return false;
+			}
+		}
+
+		if (!can_write_sjson_decimal(tracks))
+		{
+			printf("Samples that aren't finite cannot be written as decimals\n");
+			return false;
+		}
+
+		// Formatting dominates, every track is formatted in parallel then written in order
+		std::vector<std::string> track_texts(num_tracks);
+		const size_t work_per_track = tracks.get_num_samples_per_track() * sizeof(sample) * 4;
+		parallel_for(num_tracks, work_per_track, [&](size_t track_index)
+			{
+				append_track(track_texts[track_index], tracks[track_index], version);
+			});
+
+		std::string header;
+		header += "version = ";
+		append_uint(header, k_sjson_format_version);
+		header += "\n\ntrack_list =\n{\n\tname = ";
+		append_string(header, tracks.get_name());
+		header += "\n\tnum_samples = ";
+		append_uint(header, static_cast<uint32_t>(tracks.get_num_samples_per_track()));
+		header += "\n\tsample_rate = ";
+		append_float(header, tracks.get_sample_rate());
+		header += "\n\tis_binary_exact = false\n}\n\ntracks =\n[\n";
+
+		std::ofstream file_stream(filename, std::ios_base::out | std::ios_base::binary | std::ios_base::trunc);
+		if (!file_stream.is_open() || !file_stream.good())
+		{
+			printf("Failed to open output file for writing: %s\n", filename);
+			return false;
+		}
+
+		file_stream.write(header.data(), header.size());
+		for (const std::string& track_text : track_texts)
+			file_stream.write(track_text.data(), track_text.size());
+		file_stream.write("]\n", 2);
+
+		if (!file_stream.good())
+		{
+			printf("Failed to write output file: %s\n", filename);
+			return false;
+		}
+
+		return true;
+	}
+}
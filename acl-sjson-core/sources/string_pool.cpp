@@ -0,0 +1,130 @@
+////////////////////////////////////////////////////////////////////////////////
+// The MIT License (MIT)
+//
+// Copyright (c) 2022 Nicholas Frechette
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+////////////////////////////////////////////////////////////////////////////////
+
+#include "acl-sjson/string_pool.h"
+#include "acl-sjson/hash.h"
+
+#include <cstring>
+
+namespace acl_sjson
+{
+	// Most names are short, a single block holds a few hundred of them
+	static constexpr size_t k_block_size = 4 * 1024;
+
+	size_t string_hasher::operator()(const char* str) const
+	{
+		return static_cast<size_t>(hash64(str, std::strlen(str)));
+	}
+
+	bool string_equal::operator()(const char* lhs, const char* rhs) const
+	{
+		return std::strcmp(lhs, rhs) == 0;
+	}
+
+	string_pool::string_pool()
+		: m_blocks()
+		, m_strings()
+		, m_block_cursor(nullptr)
+		, m_block_remaining(0)
+	{
+	}
+
+	string_pool::string_pool(string_pool&& other)
+		: m_blocks(std::move(other.m_blocks))
+		, m_strings(std::move(other.m_strings))
+		, m_block_cursor(other.m_block_cursor)
+		, m_block_remaining(other.m_block_remaining)
+	{
+		other.clear();
+	}
+
+	string_pool& string_pool::operator=(string_pool&& other)
+	{
+		if (this != &other)
+		{
+			m_blocks = std::move(other.m_blocks);
+			m_strings = std::move(other.m_strings);
+			m_block_cursor = other.m_block_cursor;
+			m_block_remaining = other.m_block_remaining;
+
+			other.clear();
+		}
+
+		return *this;
+	}
+
+	size_t string_pool::get_num_strings() const
+	{
+		return m_strings.size();
+	}
+
+	const char* string_pool::intern(const char* str)
+	{
+		const auto it = m_strings.find(str);
+		if (it != m_strings.end())
+			return *it;
+
+		const size_t size = std::strlen(str) + 1;
+
+		char* interned_str;
+		if (size > k_block_size)
+		{
+			// Large strings get a dedicated block, the current block remains in use
+			m_blocks.emplace_back(new char[size]);
+			interned_str = m_blocks.back().get();
+		}
+		else
+		{
+			if (size > m_block_remaining)
+			{
+				m_blocks.emplace_back(new char[k_block_size]);
+				m_block_cursor = m_blocks.back().get();
+				m_block_remaining = k_block_size;
+			}
+
+			interned_str = m_block_cursor;
+			m_block_cursor += size;
+			m_block_remaining -= size;
+		}
+
+		std::memcpy(interned_str, str, size);
+		m_strings.insert(interned_str);
+
+		return interned_str;
+	}
+
+	const char* string_pool::find(const char* str) const
+	{
+		const auto it = m_strings.find(str);
+		return it != m_strings.end() ? *it : nullptr;
+	}
+
+	void string_pool::clear()
+	{
+		m_strings.clear();
+		m_blocks.clear();
+		m_block_cursor = nullptr;
+		m_block_remaining = 0;
+	}
+}
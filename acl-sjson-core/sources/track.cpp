@@ -25,10 +25,17 @@
 #include "acl-sjson/sample.h"
 #include "acl-sjson/track.h"
 
+#include "interpolation.h"
+
+#include <cstring>
+
 namespace acl_sjson
 {
 	track::track(sample_type type, float sample_rate, const char* name)
 		: m_name(name)
+		, m_interned_name(nullptr)
+		, m_num_samples(0)
+		, m_num_reserved_samples(0)
 		, m_type(type)
 		, m_sample_rate(sample_rate)
 	{
@@ -41,7 +48,7 @@ namespace acl_sjson
 
 	size_t track::get_num_samples() const
 	{
-		return m_samples.size();
+		return m_num_samples;
 	}
 
 	float track::get_sample_rate() const
@@ -51,12 +58,79 @@ namespace acl_sjson
 
 	const char* track::get_name() const
 	{
-		return m_name.c_str();
+		return m_interned_name != nullptr ? m_interned_name : m_name.c_str();
 	}
 
 	void track::emplace_back(sample&& item)
 	{
+		// As long as every sample matches the first, we only retain the first
+		if (m_samples.size() == 1 && std::memcmp(&m_samples[0], &item, get_sample_size(m_type)) == 0)
+		{
+			++m_num_samples;
+			return;
+		}
+
+		// The track is about to hold distinct samples, allocate everything we reserved at once
+		if (m_samples.size() == 1)
+			m_samples.reserve(m_num_reserved_samples);
+
+		if (is_collapsed())
+			expand();
+
 		m_samples.emplace_back(std::move(item));
+		++m_num_samples;
+	}
+
+	void track::reserve(size_t num_samples)
+	{
+		m_num_reserved_samples = num_samples;
+
+		if (m_samples.size() > 1)
+			m_samples.reserve(num_samples);
+	}
+
+	bool track::is_collapsed() const
+	{
+		return m_samples.size() != m_num_samples;
+	}
+
+	void track::expand()
+	{
+		if (!is_collapsed())
+			return;
+
+		const sample constant_sample = m_samples[0];
+		m_samples.resize(m_num_samples, constant_sample);
+	}
+
+	bool track::collapse()
+	{
+		if (m_samples.size() <= 1)
+			return is_collapsed();
+
+		const size_t sample_size = get_sample_size(m_type);
+		for (size_t sample_index = 1; sample_index < m_samples.size(); ++sample_index)
+		{
+			if (std::memcmp(&m_samples[0], &m_samples[sample_index], sample_size) != 0)
+				return false;
+		}
+
+		// Release the storage of the repeated samples
+		std::vector<sample>(1, m_samples[0]).swap(m_samples);
+		return true;
+	}
+
+	sample track::sample_at(float time, rotation_interpolation interpolation, sample_wrap_policy wrap_policy) const
+	{
+		if (m_num_samples == 0)
+		{
+			sample result;
+			std::memset(&result, 0, sizeof(result));
+			return result;
+		}
+
+		const interpolation_keys keys = find_interpolation_keys(m_num_samples, time * m_sample_rate, wrap_policy);
+		return visit_sample_type(m_type, sample_track_functor{ *this, keys, interpolation });
 	}
 
 	track_description& track::get_description()
@@ -69,13 +143,62 @@ namespace acl_sjson
 		return m_desc;
 	}
 
+	uint32_t track::get_output_index() const
+	{
+		return is_transform(m_type) ? m_desc.transform.output_index : m_desc.scalar.output_index;
+	}
+
+	void track::set_output_index(uint32_t output_index)
+	{
+		if (is_transform(m_type))
+			m_desc.transform.output_index = output_index;
+		else
+			m_desc.scalar.output_index = output_index;
+	}
+
+	void track::set_interned_name(const char* name)
+	{
+		m_interned_name = name;
+
+		// Release our copy, we no longer need it
+		std::string().swap(m_name);
+	}
+
+	void track::set_sample(size_t index, const sample& item)
+	{
+		// Writing the repeating sample leaves the track unchanged
+		if (is_collapsed() && std::memcmp(&m_samples[0], &item, get_sample_size(m_type)) == 0)
+			return;
+
+		expand();
+		m_samples[index] = item;
+	}
+
+	void track::set_constant_sample(const sample& item)
+	{
+		if (m_num_samples == 0)
+			return;
+
+		if (m_samples.size() == 1)
+			m_samples[0] = item;
+		else
+			std::vector<sample>(1, item).swap(m_samples);	// Release the storage of the individual samples
+	}
+
+	sample* track::get_mutable_samples()
+	{
+		expand();
+		return m_samples.data();
+	}
+
 	sample& track::operator[](size_t index)
 	{
+		expand();
 		return m_samples[index];
 	}
 
 	const sample& track::operator[](size_t index) const
 	{
-		return m_samples[index];
+		return is_collapsed() ? m_samples[0] : m_samples[index];
 	}
 }
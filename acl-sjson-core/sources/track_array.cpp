@@ -25,16 +25,74 @@
 #include "acl-sjson/track.h"
 #include "acl-sjson/track_array.h"
 
+#include "interpolation.h"
+
+#include <cstring>
+
 namespace acl_sjson
 {
+	namespace
+	{
+		// Every track shares the same sample type, it is dispatched once for the whole pose
+		struct sample_pose_functor
+		{
+			const track_array& tracks;
+			const interpolation_keys& keys;
+			rotation_interpolation interpolation;
+			sample* out_pose;
+
+			void operator()(sample_traits<sample_type::unknown>) const
+			{
+				// Nothing to sample
+			}
+
+			template<typename traits_type>
+			void operator()(traits_type) const
+			{
+				const size_t num_tracks = tracks.get_num_tracks();
+				for (size_t track_index = 0; track_index < num_tracks; ++track_index)
+					out_pose[track_index] = sample_track<traits_type::k_type>(tracks[track_index], keys, interpolation);
+			}
+		};
+	}
+
 	track_array::track_array()
+		: m_is_name_index_built(false)
 	{
 	}
 
 	track_array::track_array(const char* name, const metadata_t& metadata)
 		: m_name(name)
 		, m_metadata(metadata)
+		, m_is_name_index_built(false)
+	{
+	}
+
+	track_array::track_array(track_array&& other)
+		: m_tracks(std::move(other.m_tracks))
+		, m_name(std::move(other.m_name))
+		, m_metadata(std::move(other.m_metadata))
+		, m_names(std::move(other.m_names))
+		, m_is_name_index_built(false)
+	{
+		// Interned names remain valid, the pool blocks are moved along with our tracks
+		other.clear();
+	}
+
+	track_array& track_array::operator=(track_array&& other)
 	{
+		if (this != &other)
+		{
+			m_tracks = std::move(other.m_tracks);
+			m_name = std::move(other.m_name);
+			m_metadata = std::move(other.m_metadata);
+			m_names = std::move(other.m_names);
+			invalidate_name_index();
+
+			other.clear();
+		}
+
+		return *this;
 	}
 
 	sample_type track_array::get_type() const
@@ -91,12 +149,62 @@ namespace acl_sjson
 
 	void track_array::emplace_back(track&& item)
 	{
+		item.set_interned_name(m_names.intern(item.get_name()));
 		m_tracks.emplace_back(std::move(item));
+		invalidate_name_index();
 	}
 
 	void track_array::clear()
 	{
 		m_tracks.clear();
+		m_names.clear();
+		invalidate_name_index();
+	}
+
+	uint32_t track_array::find(const char* name) const
+	{
+		if (!m_is_name_index_built.load(std::memory_order_acquire))
+		{
+			std::lock_guard<std::mutex> lock(m_name_index_lock);
+
+			// Another thread might have built it while we waited
+			if (!m_is_name_index_built.load(std::memory_order_relaxed))
+			{
+				const uint32_t num_tracks = static_cast<uint32_t>(m_tracks.size());
+
+				m_name_index.clear();
+				m_name_index.reserve(num_tracks);
+
+				// If names are duplicated, the first track wins
+				for (uint32_t track_index = 0; track_index < num_tracks; ++track_index)
+					m_name_index.emplace(m_tracks[track_index].get_name(), track_index);
+
+				m_is_name_index_built.store(true, std::memory_order_release);
+			}
+		}
+
+		const auto it = m_name_index.find(name);
+		return it != m_name_index.end() ? it->second : k_invalid_track_index;
+	}
+
+	bool track_array::sample_pose_at(float time, sample* out_pose, size_t pose_size, rotation_interpolation interpolation, sample_wrap_policy wrap_policy) const
+	{
+		if (pose_size < m_tracks.size())
+			return false;
+
+		if (m_tracks.empty())
+			return true;
+
+		const size_t num_samples = get_num_samples_per_track();
+		if (num_samples == 0)
+		{
+			std::memset(out_pose, 0, sizeof(sample) * m_tracks.size());
+			return true;
+		}
+
+		const interpolation_keys keys = find_interpolation_keys(num_samples, time * get_sample_rate(), wrap_policy);
+		visit_sample_type(get_type(), sample_pose_functor{ *this, keys, interpolation, out_pose });
+		return true;
 	}
 
 	track& track_array::operator[](size_t index)
@@ -108,4 +216,10 @@ namespace acl_sjson
 	{
 		return m_tracks[index];
 	}
+
+	void track_array::invalidate_name_index()
+	{
+		m_name_index.clear();
+		m_is_name_index_built.store(false, std::memory_order_relaxed);
+	}
 }
@@ -0,0 +1,483 @@
+////////////////////////////////////////////////////////////////////////////////
+// The MIT License (MIT)
+//
+// Copyright (c) 2022 Nicholas Frechette
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+////////////////////////////////////////////////////////////////////////////////
+
+#include "acl-sjson/hash.h"
+#include "acl-sjson/io.h"
+#include "acl-sjson/track.h"
+#include "acl-sjson/track_store.h"
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+
+namespace acl_sjson
+{
+	namespace
+	{
+		// 'ACLP'
+		static constexpr uint32_t k_track_store_tag = 0x504C4341;
+		static constexpr uint32_t k_track_store_version = 1;
+
+		// The smallest serialized size of each element, counts read from a file are checked against
+		// the bytes remaining before anything is allocated
+		// Entry: type, sample rate, number of samples, and data size
+		// Clip: both names, the metadata, and the number of tracks
+		// Reference: name size and entry index
+		static constexpr size_t k_min_entry_size = sizeof(uint32_t) * 4;
+		static constexpr size_t k_min_clip_size = sizeof(uint32_t) * 6 + sizeof(uint64_t) + sizeof(transform_metadata_t);
+		static constexpr size_t k_min_reference_size = sizeof(uint32_t) * 2;
+
+		template<typename value_type>
+		static void write_value(std::vector<uint8_t>& buffer, const value_type& value)
+		{
+			const size_t offset = buffer.size();
+			buffer.resize(offset + sizeof(value_type));
+			std::memcpy(buffer.data() + offset, &value, sizeof(value_type));
+		}
+
+		static void write_bytes(std::vector<uint8_t>& buffer, const void* data, size_t size)
+		{
+			const uint8_t* data_u8 = static_cast<const uint8_t*>(data);
+			buffer.insert(buffer.end(), data_u8, data_u8 + size);
+		}
+
+		static void write_string(std::vector<uint8_t>& buffer, const std::string& value)
+		{
+			write_value(buffer, static_cast<uint32_t>(value.size()));
+			write_bytes(buffer, value.data(), value.size());
+		}
+
+		struct buffer_reader
+		{
+			const uint8_t* ptr;
+			const uint8_t* end;
+
+			template<typename value_type>
+			bool read_value(value_type& out_value)
+			{
+				return read_bytes(&out_value, sizeof(value_type));
+			}
+
+			bool read_bytes(void* out_data, size_t size)
+			{
+				if (size > static_cast<size_t>(end - ptr))
+					return false;	// Truncated
+
+				std::memcpy(out_data, ptr, size);
+				ptr += size;
+				return true;
+			}
+
+			// Returns whether the remaining bytes can hold the provided number of elements
+			bool can_hold(uint32_t num_elements, size_t min_element_size) const
+			{
+				return num_elements <= static_cast<size_t>(end - ptr) / min_element_size;
+			}
+
+			bool read_string(std::string& out_value)
+			{
+				uint32_t size = 0;
+				if (!read_value(size) || size > static_cast<size_t>(end - ptr))
+					return false;
+
+				out_value.assign(reinterpret_cast<const char*>(ptr), size);
+				ptr += size;
+				return true;
+			}
+		};
+
+		// Only the description fields relevant to the sample type are part of the track identity
+		static void write_description(std::vector<uint8_t>& buffer, sample_type type, const track_description& desc)
+		{
+			if (is_transform(type))
+			{
+				write_value(buffer, desc.transform.default_value);
+				write_value(buffer, desc.transform.output_index);
+				write_value(buffer, desc.transform.parent_index);
+				write_value(buffer, desc.transform.precision);
+				write_value(buffer, desc.transform.shell_distance);
+				write_value(buffer, desc.transform.constant_rotation_threshold_angle);
+				write_value(buffer, desc.transform.constant_translation_threshold);
+				write_value(buffer, desc.transform.constant_scale_threshold);
+			}
+			else
+			{
+				write_value(buffer, desc.scalar.output_index);
+				write_value(buffer, desc.scalar.precision);
+			}
+		}
+
+		static bool read_description(buffer_reader& reader, sample_type type, track_description& out_desc)
+		{
+			std::memset(&out_desc, 0, sizeof(out_desc));
+
+			if (is_transform(type))
+			{
+				return reader.read_value(out_desc.transform.default_value)
+					&& reader.read_value(out_desc.transform.output_index)
+					&& reader.read_value(out_desc.transform.parent_index)
+					&& reader.read_value(out_desc.transform.precision)
+					&& reader.read_value(out_desc.transform.shell_distance)
+					&& reader.read_value(out_desc.transform.constant_rotation_threshold_angle)
+					&& reader.read_value(out_desc.transform.constant_translation_threshold)
+					&& reader.read_value(out_desc.transform.constant_scale_threshold);
+			}
+			else
+			{
+				return reader.read_value(out_desc.scalar.output_index)
+					&& reader.read_value(out_desc.scalar.precision);
+			}
+		}
+
+		template<typename entry_type>
+		static uint64_t hash_entry(const entry_type& entry)
+		{
+			hasher64 hasher;
+			hasher.update(&entry.type, sizeof(entry.type));
+			hasher.update(&entry.sample_rate, sizeof(entry.sample_rate));
+			hasher.update(&entry.num_samples, sizeof(entry.num_samples));
+			hasher.update(entry.data.data(), entry.data.size());
+			return hasher.digest();
+		}
+	}
+
+	track_store::track_store()
+	{
+	}
+
+	size_t track_store::get_num_clips() const
+	{
+		return m_clips.size();
+	}
+
+	size_t track_store::get_num_unique_tracks() const
+	{
+		return m_entries.size();
+	}
+
+	size_t track_store::get_num_track_references() const
+	{
+		size_t num_references = 0;
+		for (const clip_entry& clip : m_clips)
+			num_references += clip.tracks.size();
+
+		return num_references;
+	}
+
+	const char* track_store::get_clip_name(size_t clip_index) const
+	{
+		return m_clips[clip_index].name.c_str();
+	}
+
+	void track_store::add_clip(const char* name, const track_array& tracks)
+	{
+		clip_entry clip;
+		clip.name = name;
+		clip.array_name = tracks.get_name();
+		clip.metadata = tracks.get_metadata();
+
+		const size_t num_tracks = tracks.get_num_tracks();
+		clip.tracks.reserve(num_tracks);
+
+		for (size_t track_index = 0; track_index < num_tracks; ++track_index)
+		{
+			const track& track_ = tracks[track_index];
+			const sample_type type = track_.get_type();
+			const size_t num_samples = track_.get_num_samples();
+			const size_t sample_size = get_sample_size(type);
+
+			track_entry entry;
+			entry.type = type;
+			entry.sample_rate = track_.get_sample_rate();
+			entry.num_samples = static_cast<uint32_t>(num_samples);
+
+			write_description(entry.data, type, track_.get_description());
+
+			// Samples are tightly packed, only the bytes used by the sample type are retained
+			const size_t samples_offset = entry.data.size();
+			entry.data.resize(samples_offset + num_samples * sample_size);
+			for (size_t sample_index = 0; sample_index < num_samples; ++sample_index)
+				std::memcpy(entry.data.data() + samples_offset + sample_index * sample_size, &track_[sample_index], sample_size);
+
+			entry.hash = hash_entry(entry);
+
+			track_reference reference;
+			reference.name = track_.get_name();
+			reference.entry_index = find_or_add_entry(std::move(entry));
+
+			clip.tracks.emplace_back(std::move(reference));
+		}
+
+		m_clips.emplace_back(std::move(clip));
+	}
+
+	bool track_store::make_clip(size_t clip_index, track_array& out_tracks) const
+	{
+		const clip_entry& clip = m_clips[clip_index];
+
+		track_array tracks(clip.array_name.c_str(), clip.metadata);
+
+		for (const track_reference& reference : clip.tracks)
+		{
+			const track_entry& entry = m_entries[reference.entry_index];
+			const size_t sample_size = get_sample_size(entry.type);
+			if (sample_size == 0)
+			{
+				printf("Invalid sample type for track '%s' of clip: %s\n", reference.name.c_str(), clip.name.c_str());
+				return false;
+			}
+
+			track out_track(entry.type, entry.sample_rate, reference.name.c_str());
+
+			buffer_reader reader = { entry.data.data(), entry.data.data() + entry.data.size() };
+			bool is_valid = read_description(reader, entry.type, out_track.get_description());
+
+			for (uint32_t sample_index = 0; is_valid && sample_index < entry.num_samples; ++sample_index)
+			{
+				sample smpl;
+				std::memset(&smpl, 0, sizeof(smpl));
+				is_valid = reader.read_bytes(&smpl, sample_size);
+
+				out_track.emplace_back(std::move(smpl));
+			}
+
+			if (!is_valid)
+			{
+				printf("Truncated track '%s' in clip: %s\n", reference.name.c_str(), clip.name.c_str());
+				return false;
+			}
+
+			tracks.emplace_back(std::move(out_track));
+		}
+
+		out_tracks = std::move(tracks);
+		return true;
+	}
+
+	void track_store::clear()
+	{
+		m_entries.clear();
+		m_clips.clear();
+		m_entry_map.clear();
+	}
+
+	uint32_t track_store::find_or_add_entry(track_entry&& entry)
+	{
+		// Hashes can collide, we only share an entry if its content matches exactly
+		const auto range = m_entry_map.equal_range(entry.hash);
+		for (auto it = range.first; it != range.second; ++it)
+		{
+			const track_entry& candidate = m_entries[it->second];
+			if (candidate.type == entry.type
+				&& candidate.num_samples == entry.num_samples
+				&& std::memcmp(&candidate.sample_rate, &entry.sample_rate, sizeof(float)) == 0
+				&& candidate.data == entry.data)
+				return it->second;
+		}
+
+		const uint32_t entry_index = static_cast<uint32_t>(m_entries.size());
+		m_entry_map.emplace(entry.hash, entry_index);
+		m_entries.emplace_back(std::move(entry));
+		return entry_index;
+	}
+
+	bool track_store::write(const char* filename) const
+	{
+		std::vector<uint8_t> buffer;
+
+		write_value(buffer, k_track_store_tag);
+		write_value(buffer, k_track_store_version);
+
+		write_value(buffer, static_cast<uint32_t>(m_entries.size()));
+		for (const track_entry& entry : m_entries)
+		{
+			write_value(buffer, static_cast<uint32_t>(entry.type));
+			write_value(buffer, entry.sample_rate);
+			write_value(buffer, entry.num_samples);
+			write_value(buffer, static_cast<uint32_t>(entry.data.size()));
+			write_bytes(buffer, entry.data.data(), entry.data.size());
+		}
+
+		write_value(buffer, static_cast<uint32_t>(m_clips.size()));
+		for (const clip_entry& clip : m_clips)
+		{
+			write_string(buffer, clip.name);
+			write_string(buffer, clip.array_name);
+
+			write_value(buffer, static_cast<int32_t>(clip.metadata.version));
+			write_value(buffer, static_cast<uint64_t>(clip.metadata.size));
+			write_string(buffer, clip.metadata.name);
+			write_value(buffer, static_cast<uint32_t>(clip.metadata.track_variant));
+			write_value(buffer, clip.metadata.variant.transform);
+
+			write_value(buffer, static_cast<uint32_t>(clip.tracks.size()));
+			for (const track_reference& reference : clip.tracks)
+			{
+				write_string(buffer, reference.name);
+				write_value(buffer, reference.entry_index);
+			}
+		}
+
+		std::ofstream file_stream(filename, std::ios_base::out | std::ios_base::binary | std::ios_base::trunc);
+		if (!file_stream.is_open() || !file_stream.good())
+		{
+			printf("Failed to open output file for writing: %s\n", filename);
+			return false;
+		}
+
+		file_stream.write(reinterpret_cast<const char*>(buffer.data()), buffer.size());
+		file_stream.close();
+
+		if (!file_stream.good())
+		{
+			printf("Failed to write output file: %s\n", filename);
+			return false;
+		}
+
+		return true;
+	}
+
+	bool track_store::read(const char* filename)
+	{
+		clear();
+
+		char* file_buffer = nullptr;
+		size_t file_size = 0;
+
+		if (!read_file(filename, file_buffer, file_size))
+			return false;
+
+		const uint8_t* file_buffer_u8 = reinterpret_cast<const uint8_t*>(file_buffer);
+		buffer_reader reader = { file_buffer_u8, file_buffer_u8 + file_size };
+
+		// Returns false if the content is truncated or invalid
+		const auto read_content = [&]() -> bool
+		{
+			uint32_t tag = 0;
+			uint32_t version = 0;
+
+			if (!reader.read_value(tag) || tag != k_track_store_tag)
+			{
+				printf("Input file is not a track store: %s\n", filename);
+				return false;
+			}
+
+			if (!reader.read_value(version) || version != k_track_store_version)
+			{
+				printf("Unsupported track store version: %u\n", version);
+				return false;
+			}
+
+			uint32_t num_entries = 0;
+			if (!reader.read_value(num_entries) || !reader.can_hold(num_entries, k_min_entry_size))
+				return false;
+
+			m_entries.reserve(num_entries);
+			for (uint32_t entry_index = 0; entry_index < num_entries; ++entry_index)
+			{
+				uint32_t type = 0;
+				uint32_t data_size = 0;
+
+				track_entry entry;
+				if (!reader.read_value(type) || !reader.read_value(entry.sample_rate) || !reader.read_value(entry.num_samples) || !reader.read_value(data_size))
+					return false;
+
+				entry.type = static_cast<sample_type>(type);
+				if (get_sample_size(entry.type) == 0)
+				{
+					printf("Invalid sample type found in track store: %u\n", type);
+					return false;
+				}
+
+				if (!reader.can_hold(data_size, 1))
+					return false;
+
+				entry.data.resize(data_size);
+				if (!reader.read_bytes(entry.data.data(), data_size))
+					return false;
+
+				entry.hash = hash_entry(entry);
+
+				m_entry_map.emplace(entry.hash, entry_index);
+				m_entries.emplace_back(std::move(entry));
+			}
+
+			uint32_t num_clips = 0;
+			if (!reader.read_value(num_clips) || !reader.can_hold(num_clips, k_min_clip_size))
+				return false;
+
+			m_clips.reserve(num_clips);
+			for (uint32_t clip_index = 0; clip_index < num_clips; ++clip_index)
+			{
+				int32_t version_value = 0;
+				uint64_t metadata_size = 0;
+				uint32_t track_variant = 0;
+				uint32_t num_tracks = 0;
+
+				clip_entry clip;
+				if (!reader.read_string(clip.name) || !reader.read_string(clip.array_name))
+					return false;
+
+				if (!reader.read_value(version_value) || !reader.read_value(metadata_size) || !reader.read_string(clip.metadata.name)
+					|| !reader.read_value(track_variant) || !reader.read_value(clip.metadata.variant.transform))
+					return false;
+
+				clip.metadata.version = static_cast<acl_version>(version_value);
+				clip.metadata.size = static_cast<size_t>(metadata_size);
+				clip.metadata.track_variant = static_cast<track_variant_t>(track_variant);
+
+				if (!reader.read_value(num_tracks) || !reader.can_hold(num_tracks, k_min_reference_size))
+					return false;
+
+				clip.tracks.resize(num_tracks);
+				for (track_reference& reference : clip.tracks)
+				{
+					if (!reader.read_string(reference.name) || !reader.read_value(reference.entry_index))
+						return false;
+
+					if (reference.entry_index >= num_entries)
+					{
+						printf("Invalid track reference found in track store: %s\n", filename);
+						return false;
+					}
+				}
+
+				m_clips.emplace_back(std::move(clip));
+			}
+
+			return true;
+		};
+
+		const bool success = read_content();
+		if (!success)
+		{
+			printf("Failed to read track store: %s\n", filename);
+			clear();
+		}
+
+		free_file_memory(file_buffer);
+
+		return success;
+	}
+}
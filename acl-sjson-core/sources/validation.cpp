@@ -0,0 +1,363 @@
+////////////////////////////////////////////////////////////////////////////////
+// The MIT License (MIT)
+//
+// Copyright (c) 2022 Nicholas Frechette
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+////////////////////////////////////////////////////////////////////////////////
+
+#include "acl-sjson/parallel.h"
+#include "acl-sjson/track.h"
+#include "acl-sjson/track_array.h"
+#include "acl-sjson/validation.h"
+
+#include "sample_math.h"
+#include "simd_kernels.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+
+namespace acl_sjson
+{
+	namespace
+	{
+		static constexpr uint32_t k_num_issue_types = static_cast<uint32_t>(validation_issue_type::duplicate_output_index) + 1;
+
+		// The number of samples classified at once, small enough for the classes to stay on the stack
+		static constexpr uint32_t k_num_block_samples = 64;
+
+		static uint32_t get_first_lane(int mask)
+		{
+			uint32_t lane_index = 0;
+			while ((mask & (1 << lane_index)) == 0)
+				++lane_index;
+
+			return lane_index;
+		}
+
+		static validation_issue make_description_issue(validation_issue_type type, uint32_t track_index, uint32_t index)
+		{
+			validation_issue issue;
+			issue.type = type;
+			issue.track_index = track_index;
+			issue.sample_index = k_invalid_track_index;
+			issue.index = index;
+			return issue;
+		}
+
+		// Only the first offending sample of each issue type is retained, the others are counted
+		static void record_sample_issue(validation_issue* issues, validation_issue_type type, uint32_t sample_index, uint32_t component_index, float value)
+		{
+			validation_issue& issue = issues[static_cast<uint32_t>(type)];
+			if (issue.num_samples == 0)
+			{
+				issue.type = type;
+				issue.sample_index = sample_index;
+				issue.component_index = component_index;
+				issue.value = value;
+			}
+
+			++issue.num_samples;
+		}
+
+		static void validate_descriptions(const track_array& tracks, std::vector<std::vector<validation_issue>>& out_track_issues)
+		{
+			const uint32_t num_tracks = static_cast<uint32_t>(tracks.get_num_tracks());
+
+			// Output indices must map every track that isn't stripped to [0, num_output_tracks)
+			uint32_t num_output_tracks = 0;
+			for (uint32_t track_index = 0; track_index < num_tracks; ++track_index)
+			{
+				if (tracks[track_index].get_output_index() != k_invalid_track_index)
+					++num_output_tracks;
+			}
+
+			std::vector<uint32_t> output_owners(num_output_tracks, k_invalid_track_index);
+			for (uint32_t track_index = 0; track_index < num_tracks; ++track_index)
+			{
+				const uint32_t output_index = tracks[track_index].get_output_index();
+				if (output_index == k_invalid_track_index)
+					continue;
+
+				if (output_index >= num_output_tracks)
+					out_track_issues[track_index].push_back(make_description_issue(validation_issue_type::invalid_output_index, track_index, output_index));
+				else if (output_owners[output_index] != k_invalid_track_index)
+					out_track_issues[track_index].push_back(make_description_issue(validation_issue_type::duplicate_output_index, track_index, output_index));
+				else
+					output_owners[output_index] = track_index;
+			}
+
+			if (!is_transform(tracks.get_type()))
+				return;
+
+			const auto get_parent_index = [&tracks](uint32_t track_index) { return tracks[track_index].get_description().transform.parent_index; };
+
+			for (uint32_t track_index = 0; track_index < num_tracks; ++track_index)
+			{
+				const uint32_t parent_index = get_parent_index(track_index);
+				if (parent_index == k_invalid_track_index)
+					continue;
+
+				if (parent_index >= num_tracks || parent_index == track_index)
+				{
+					out_track_issues[track_index].push_back(make_description_issue(validation_issue_type::invalid_parent_index, track_index, parent_index));
+					continue;
+				}
+
+				// Only tracks on the cycle are reported, their descendants are not
+				uint32_t ancestor_index = parent_index;
+				for (uint32_t depth = 0; depth < num_tracks; ++depth)
+				{
+					if (ancestor_index == k_invalid_track_index || ancestor_index >= num_tracks || ancestor_index == track_index)
+						break;
+
+					ancestor_index = get_parent_index(ancestor_index);
+				}
+
+				if (ancestor_index == track_index)
+					out_track_issues[track_index].push_back(make_description_issue(validation_issue_type::parent_cycle, track_index, parent_index));
+			}
+		}
+
+		static void validate_samples(const track& track_, uint32_t track_index, const validation_settings& settings, const std::atomic<bool>& is_done, std::vector<validation_issue>& out_issues)
+		{
+			const sample_type type = track_.get_type();
+			const uint32_t num_samples = static_cast<uint32_t>(track_.get_num_samples());
+
+			const int component_mask = get_component_mask(type);
+			const bool has_rotation = is_transform(type);
+			const bool has_scale = type == sample_type::qvv;
+
+			validation_issue issues[k_num_issue_types];
+
+			// Collapsed tracks repeat a single sample, validate it once
+			const uint32_t num_validated_samples = track_.is_collapsed() ? 1 : num_samples;
+
+			// Samples are classified in blocks by the kernels of the current instruction set
+			const simd_kernels& kernels = get_simd_kernels();
+			sample_classes block_classes[k_num_block_samples];
+
+			bool is_stopped = false;
+			for (uint32_t block_start = 0; block_start < num_validated_samples && !is_stopped; block_start += k_num_block_samples)
+			{
+				// Another track already found an error, the answer is known
+				if (settings.stop_on_first_error && is_done.load(std::memory_order_relaxed))
+					break;
+
+				const uint32_t num_block_samples = std::min(k_num_block_samples, num_validated_samples - block_start);
+				kernels.classify_samples(&track_[block_start], num_block_samples, block_classes);
+
+				for (uint32_t block_index = 0; block_index < num_block_samples; ++block_index)
+				{
+					const uint32_t sample_index = block_start + block_index;
+					const sample_classes& classes = block_classes[block_index];
+					const float* values = &track_[sample_index].f1.x;
+
+					const int non_finite_mask = classes.non_finite_mask & component_mask;
+					const int denormal_mask = classes.denormal_mask & component_mask;
+					const int overflowing_mask = classes.overflowing_mask & component_mask;
+
+					if (non_finite_mask != 0)
+					{
+						const uint32_t component_index = get_first_lane(non_finite_mask);
+						record_sample_issue(issues, validation_issue_type::non_finite_value, sample_index, component_index, values[component_index]);
+					}
+
+					if (denormal_mask != 0)
+					{
+						const uint32_t component_index = get_first_lane(denormal_mask);
+						record_sample_issue(issues, validation_issue_type::denormal_value, sample_index, component_index, values[component_index]);
+					}
+
+					if (overflowing_mask != 0)
+					{
+						const uint32_t component_index = get_first_lane(overflowing_mask);
+						record_sample_issue(issues, validation_issue_type::overflowing_value, sample_index, component_index, values[component_index]);
+					}
+
+					// The length of a rotation that isn't finite is meaningless, it is already reported
+					if (has_rotation && (non_finite_mask & 0xF) == 0)
+					{
+						const float length_sq = math::dot4(values, values);
+						if (!(std::fabs(length_sq - 1.0F) <= settings.rotation_length_tolerance))
+							record_sample_issue(issues, validation_issue_type::non_normalized_rotation, sample_index, 0, length_sq);
+					}
+
+					if (has_scale)
+					{
+						// The scale starts at the ninth component
+						const int zero_mask = (classes.zero_mask >> 8) & 0x7;
+						const int negative_mask = (classes.negative_mask >> 8) & 0x7;
+
+						if (zero_mask != 0)
+						{
+							const uint32_t lane_index = get_first_lane(zero_mask);
+							record_sample_issue(issues, validation_issue_type::zero_scale, sample_index, 8 + lane_index, values[8 + lane_index]);
+						}
+
+						if (negative_mask != 0)
+						{
+							const uint32_t lane_index = get_first_lane(negative_mask);
+							record_sample_issue(issues, validation_issue_type::negative_scale, sample_index, 8 + lane_index, values[8 + lane_index]);
+						}
+					}
+
+					if (settings.stop_on_first_error && (non_finite_mask != 0 || issues[static_cast<uint32_t>(validation_issue_type::non_normalized_rotation)].num_samples != 0))
+					{
+						is_stopped = true;
+						break;
+					}
+				}
+			}
+
+			for (validation_issue& issue : issues)
+			{
+				if (issue.num_samples == 0)
+					continue;
+
+				// Every sample of a collapsed track has the issue
+				if (track_.is_collapsed())
+					issue.num_samples = num_samples;
+
+				issue.track_index = track_index;
+				out_issues.push_back(issue);
+			}
+		}
+	}
+
+	const char* to_string(validation_severity severity)
+	{
+		switch (severity)
+		{
+		case validation_severity::warning:	return "warning";
+		case validation_severity::error:	return "error";
+		default:							return "unknown";
+		}
+	}
+
+	const char* to_string(validation_issue_type type)
+	{
+		switch (type)
+		{
+		case validation_issue_type::non_finite_value:			return "non-finite value";
+		case validation_issue_type::denormal_value:				return "denormal value";
+		case validation_issue_type::overflowing_value:			return "overflowing value";
+		case validation_issue_type::non_normalized_rotation:	return "non-normalized rotation";
+		case validation_issue_type::zero_scale:					return "zero scale";
+		case validation_issue_type::negative_scale:				return "negative scale";
+		case validation_issue_type::invalid_parent_index:		return "invalid parent index";
+		case validation_issue_type::parent_cycle:				return "parent cycle";
+		case validation_issue_type::invalid_output_index:		return "invalid output index";
+		case validation_issue_type::duplicate_output_index:		return "duplicate output index";
+		default:												return "unknown";
+		}
+	}
+
+	validation_severity get_severity(validation_issue_type type)
+	{
+		switch (type)
+		{
+		case validation_issue_type::denormal_value:
+		case validation_issue_type::overflowing_value:
+		case validation_issue_type::zero_scale:
+		case validation_issue_type::negative_scale:
+			return validation_severity::warning;
+		default:
+			return validation_severity::error;
+		}
+	}
+
+	const char* get_component_name(sample_type type, uint32_t component_index)
+	{
+		static const char* k_component_names[] = { "x", "y", "z", "w" };
+		static const char* k_transform_component_names[] =
+		{
+			"rotation.x", "rotation.y", "rotation.z", "rotation.w",
+			"translation.x", "translation.y", "translation.z", "translation.w",
+			"scale.x", "scale.y", "scale.z", "scale.w",
+		};
+
+		if (type == sample_type::qvv)
+			return component_index < 12 ? k_transform_component_names[component_index] : "unknown";
+
+		return component_index < 4 ? k_component_names[component_index] : "unknown";
+	}
+
+	void validate_tracks(const track_array& tracks, const validation_settings& settings, clip_validation& out_validation)
+	{
+		out_validation = clip_validation();
+
+		const size_t num_tracks = tracks.get_num_tracks();
+
+		// Each track writes its own slot, they are gathered in order once done
+		std::vector<std::vector<validation_issue>> track_issues(num_tracks);
+
+		// Descriptions are cheap to validate, if they are invalid the samples do not matter
+		validate_descriptions(tracks, track_issues);
+
+		std::atomic<bool> is_done(false);
+		const bool stop_on_first_error = settings.stop_on_first_error;
+		if (stop_on_first_error)
+		{
+			for (const std::vector<validation_issue>& issues : track_issues)
+			{
+				if (!issues.empty())
+					is_done.store(true, std::memory_order_relaxed);
+			}
+		}
+
+		const size_t work_per_track = tracks.get_num_samples_per_track() * sizeof(sample);
+		parallel_for(num_tracks, work_per_track, [&](size_t track_index)
+			{
+				if (stop_on_first_error && is_done.load(std::memory_order_relaxed))
+					return;
+
+				std::vector<validation_issue>& issues = track_issues[track_index];
+				validate_samples(tracks[track_index], static_cast<uint32_t>(track_index), settings, is_done, issues);
+
+				if (stop_on_first_error)
+				{
+					for (const validation_issue& issue : issues)
+					{
+						if (get_severity(issue.type) == validation_severity::error)
+							is_done.store(true, std::memory_order_relaxed);
+					}
+				}
+			});
+
+		for (std::vector<validation_issue>& issues : track_issues)
+		{
+			std::stable_sort(issues.begin(), issues.end(), [](const validation_issue& lhs, const validation_issue& rhs) { return lhs.type < rhs.type; });
+
+			for (const validation_issue& issue : issues)
+			{
+				out_validation.issues.push_back(issue);
+
+				if (get_severity(issue.type) == validation_severity::error)
+					++out_validation.num_errors;
+				else
+					++out_validation.num_warnings;
+
+				if (stop_on_first_error && out_validation.has_errors())
+					return;
+			}
+		}
+	}
+}
@@ -24,22 +24,112 @@
 
 #include "command_line_options.h"
 
+#include <cstdlib>
 #include <cstring>
 
 command_line_options::command_line_options()
 	: action(command_line_action::none)
 	, input_filename()
 	, output_filename()
+	, input_filenames()
 	, output_version(acl_sjson::acl_version::unknown)
+	, additional_outputs()
+	, resample_rate(0.0F)
+	, resample_to_native_rate(false)
+	, resample_with_slerp(false)
+	, has_range(false)
+	, range_start_time(0.0F)
+	, range_end_time(0.0F)
+	, reorder_hierarchy(false)
+	, hierarchy_order(acl_sjson::hierarchy_order::breadth_first)
+	, preprocess(false)
+	, binary_exact(false)
+	, lod_variants_filename()
+	, num_threads(0)
+	, force_cpu_isa(false)
+	, cpu_isa(acl_sjson::cpu_isa::scalar)
+	, print_memory_report(false)
+	, generator()
+	, diff()
 {}
 
 static void print_usage()
 {
-	printf("Usage: acl-sjson --convert <input_file> <output_file> [--target <version>]\n");
+	printf("Usage: acl-sjson --convert <input_file> <output_file> [--target <version>] [--output <output_file> [--target <version>] ...] [--resample <sample_rate|native>] [--slerp] [--range <start_time> <end_time>]\n");
+	printf("       [--reorder <breadth|depth>] [--preprocess]\n");
 	printf("This utility converts between two ACL file formats.\n");
 	printf("Human readable files end with the *.acl.sjson extension.\n");
 	printf("Binary files end with the *.acl extension.\n");
 	printf("Optionally, a target version can be provided (e.g. --target 2.0). Defaults to the source file version.\n");
+	printf("Optionally, extra outputs can be provided (e.g. --output clip.acl --target 2.0). The input is only read once\n");
+	printf("and every output is written concurrently. A target version applies to the output that precedes it.\n");
+	printf("Optionally, tracks can be resampled to a new sample rate (e.g. --resample 30) or to their native\n");
+	printf("sample rate detected from duplicated frames (e.g. --resample native). Rotations use nlerp unless --slerp is provided.\n");
+	printf("Optionally, a time range in seconds can be extracted into a sub-clip (e.g. --range 0.5 1.25).\n");
+	printf("Compressed inputs only decompress the poses within the range.\n");
+	printf("Optionally, transform tracks can be reordered so that parents come before their children, breadth or depth first\n");
+	printf("(e.g. --reorder depth). Parent indices are remapped while output indices are retained.\n");
+	printf("Optionally, tracks can be cleaned up before compression with --preprocess: denormals are flushed to zero, rotations\n");
+	printf("are normalized and made continuous, and nearly constant sub-tracks are snapped to an exact constant.\n");
+	printf("\n");
+	printf("Usage: acl-sjson --info <input_file>\n");
+	printf("Dumps information about an ACL file.\n");
+	printf("\n");
+	printf("Usage: acl-sjson --pack <output_file> <input_file> [<input_file> ...]\n");
+	printf("Packs ACL files into a single track store where identical tracks are only stored once.\n");
+	printf("\n");
+	printf("Usage: acl-sjson --unpack <input_file> <output_directory> [--target <version>]\n");
+	printf("Unpacks every ACL file from a track store with their original filename.\n");
+	printf("\n");
+	printf("Usage: acl-sjson --generate <output_file> [--target <version>] [--output <output_file> [--target <version>] ...]\n");
+	printf("       [--bones <count>] [--depth <count>] [--samples <count>] [--rate <sample_rate>] [--constant_ratio <ratio>] [--seed <seed>]\n");
+	printf("Generates a deterministic synthetic clip, the same seed and settings always produce the same clip.\n");
+	printf("Defaults to 64 bones with a hierarchy depth of 8, 300 samples at 30 FPS where 25%% of the bones are constant.\n");
+	printf("\n");
+	printf("Usage: acl-sjson --diff <input_file> <input_file> [--abs_tolerance <value>] [--rel_tolerance <value>] [--quick]\n");
+	printf("Compares the samples of two ACL files track by track, regardless of their format and version.\n");
+	printf("By default, samples must be bit for bit identical. Values also match when their difference is within the absolute\n");
+	printf("tolerance or within the relative tolerance scaled by their magnitude. With --quick, the comparison stops at the first mismatch.\n");
+	printf("Returns 0 if the clips match, 1 otherwise.\n");
+	printf("\n");
+	printf("Usage: acl-sjson --hash <input_file> [<input_file> ...]\n");
+	printf("Prints a hash of the canonical content of each ACL file. The same animation hashes the same regardless of its\n");
+	printf("format and version. Track names and settings that binary files do not retain are excluded.\n");
+	printf("\n");
+	printf("Usage: acl-sjson --index <input_directory> <output_file>\n");
+	printf("Writes an index with an entry per ACL file found recursively within the directory.\n");
+	printf("The index is written as JSON for *.json files and as SJSON for *.sjson files.\n");
+	printf("\n");
+	printf("Usage: acl-sjson --matrix <metadata_file> <output_file> [--target <version>]\n");
+	printf("Compresses every config and clip pair listed in a regression test metadata.sjson file with every ACL version.\n");
+	printf("Configs and clips are found next to the metadata file. The compressed size, the compression and decompression\n");
+	printf("times, and the max error are printed as a table and written as JSON. A target version only runs that version.\n");
+	printf("\n");
+	printf("Usage: acl-sjson --validate <input_file> [<input_file> ...]\n");
+	printf("Checks every track of ACL files for NaN, infinite, denormal, and overflowing values, rotations that aren't normalized,\n");
+	printf("zero or negative scale, and invalid parent or output indices. Issues are listed with the first offending sample.\n");
+	printf("Returns 0 if no errors are found, 1 otherwise. Binary outputs and --matrix reject clips with errors before compressing.\n");
+	printf("\n");
+	printf("Usage: acl-sjson --lod <input_file> <variants_file> <output_directory> [--target <version>]\n");
+	printf("Compresses a binary ACL file per level of detail variant listed in a SJSON file, variants are compressed concurrently.\n");
+	printf("Each variant strips tracks from the output by max hierarchy depth, name pattern (with * and ?), or name.\n");
+	printf("Descendants of stripped transform tracks are stripped as well and the remaining output indices stay contiguous.\n");
+	printf("Variants are written as <output_directory>/<clip>_<variant>.acl\n");
+	printf("\n");
+	printf("Usage: acl-sjson --database <config_file> <output_directory> <input_file> [<input_file> ...] [--target <version>]\n");
+	printf("Compresses ACL files with the settings of a config file and builds a database with their medium and low importance tiers.\n");
+	printf("Tier proportions and the chunk size are read from the database object of the config. Clips are written to the output\n");
+	printf("directory as binary files alongside database.acldb and the bulk data of each tier in database.acldb.medium and .low.\n");
+	printf("Tiers are then streamed back from the files to print the resident size and max error of each quality level.\n");
+	printf("A target version selects the ACL version used to build the database, defaults to the latest.\n");
+	printf("\n");
+	printf("Every action that writes ACL files accepts [--binary_exact] to write SJSON floats in hexadecimal with ACL.\n");
+	printf("By default, SJSON floats are written as the shortest decimal that reads back to the same value.\n");
+	printf("Every action accepts [--num_threads <count>] to limit the number of threads used to process tracks.\n");
+	printf("Defaults to every hardware thread available.\n");
+	printf("Every action accepts [--cpu <scalar|sse2|avx2|avx512>] to force the instruction set of the SIMD kernels.\n");
+	printf("Defaults to the most capable instruction set supported by the CPU.\n");
+	printf("Every action accepts [--memory-report] to print the memory allocated while reading, converting, compressing, and writing.\n");
 }
 
 static bool is_str_equal(const char* argument0, const char* argument1)
@@ -87,11 +177,14 @@ bool parse_command_line_arguments(int argc, char* argv[], command_line_options&
 				return false;
 			}
 
+			// The target version applies to the most recent output
+			acl_sjson::acl_version& output_version = options.additional_outputs.empty() ? options.output_version : options.additional_outputs.back().version;
+
 			const char* target_version = argv[arg_index + 1];
 			if (is_str_equal(target_version, "2.0"))
-				options.output_version = acl_sjson::acl_version::v02_00_00;
+				output_version = acl_sjson::acl_version::v02_00_00;
 			else if (is_str_equal(target_version, "2.1"))
-				options.output_version = acl_sjson::acl_version::v02_01_00;
+				output_version = acl_sjson::acl_version::v02_01_00;
 			else
 			{
 				printf("--target requires a valid version\n");
@@ -101,6 +194,164 @@ bool parse_command_line_arguments(int argc, char* argv[], command_line_options&
 
 			arg_index += 1;
 		}
+		else if (is_str_equal(argument, "--output"))
+		{
+			if (options.action != command_line_action::convert && options.action != command_line_action::generate)
+			{
+				printf("--output requires a preceding --convert or --generate\n");
+				print_usage();
+				return false;
+			}
+
+			if (arg_index + 1 >= argc)
+			{
+				printf("--output requires an output file\n");
+				print_usage();
+				return false;
+			}
+
+			command_line_output output;
+			output.filename = argv[arg_index + 1];
+			output.version = acl_sjson::acl_version::unknown;
+			options.additional_outputs.push_back(output);
+
+			arg_index += 1;
+		}
+		else if (is_str_equal(argument, "--resample"))
+		{
+			if (arg_index + 1 >= argc)
+			{
+				printf("--resample requires a sample rate\n");
+				print_usage();
+				return false;
+			}
+
+			const char* sample_rate = argv[arg_index + 1];
+			if (is_str_equal(sample_rate, "native"))
+				options.resample_to_native_rate = true;
+			else
+			{
+				options.resample_rate = static_cast<float>(std::atof(sample_rate));
+				if (!(options.resample_rate > 0.0F))
+				{
+					printf("--resample requires a valid sample rate\n");
+					print_usage();
+					return false;
+				}
+			}
+
+			arg_index += 1;
+		}
+		else if (is_str_equal(argument, "--range"))
+		{
+			if (arg_index + 2 >= argc)
+			{
+				printf("--range requires a start and end time\n");
+				print_usage();
+				return false;
+			}
+
+			options.has_range = true;
+			options.range_start_time = static_cast<float>(std::atof(argv[arg_index + 1]));
+			options.range_end_time = static_cast<float>(std::atof(argv[arg_index + 2]));
+
+			if (!(options.range_start_time >= 0.0F) || !(options.range_end_time >= options.range_start_time))
+			{
+				printf("--range requires a valid time range\n");
+				print_usage();
+				return false;
+			}
+
+			arg_index += 2;
+		}
+		else if (is_str_equal(argument, "--reorder"))
+		{
+			if (arg_index + 1 >= argc)
+			{
+				printf("--reorder requires an order\n");
+				print_usage();
+				return false;
+			}
+
+			const char* order = argv[arg_index + 1];
+			if (is_str_equal(order, "breadth"))
+				options.hierarchy_order = acl_sjson::hierarchy_order::breadth_first;
+			else if (is_str_equal(order, "depth"))
+				options.hierarchy_order = acl_sjson::hierarchy_order::depth_first;
+			else
+			{
+				printf("--reorder requires a valid order\n");
+				print_usage();
+				return false;
+			}
+
+			options.reorder_hierarchy = true;
+			arg_index += 1;
+		}
+		else if (is_str_equal(argument, "--preprocess"))
+		{
+			options.preprocess = true;
+		}
+		else if (is_str_equal(argument, "--slerp"))
+		{
+			options.resample_with_slerp = true;
+		}
+		else if (is_str_equal(argument, "--binary_exact"))
+		{
+			options.binary_exact = true;
+		}
+		else if (is_str_equal(argument, "--num_threads"))
+		{
+			if (arg_index + 1 >= argc)
+			{
+				printf("--num_threads requires a thread count\n");
+				print_usage();
+				return false;
+			}
+
+			const int num_threads = std::atoi(argv[arg_index + 1]);
+			if (num_threads <= 0)
+			{
+				printf("--num_threads requires a valid thread count\n");
+				print_usage();
+				return false;
+			}
+
+			options.num_threads = static_cast<uint32_t>(num_threads);
+			arg_index += 1;
+		}
+		else if (is_str_equal(argument, "--cpu"))
+		{
+			if (arg_index + 1 >= argc)
+			{
+				printf("--cpu requires an instruction set\n");
+				print_usage();
+				return false;
+			}
+
+			const char* isa = argv[arg_index + 1];
+			if (is_str_equal(isa, "scalar"))
+				options.cpu_isa = acl_sjson::cpu_isa::scalar;
+			else if (is_str_equal(isa, "sse2"))
+				options.cpu_isa = acl_sjson::cpu_isa::sse2;
+			else if (is_str_equal(isa, "avx2"))
+				options.cpu_isa = acl_sjson::cpu_isa::avx2;
+			else if (is_str_equal(isa, "avx512"))
+				options.cpu_isa = acl_sjson::cpu_isa::avx512;
+			else
+			{
+				printf("--cpu requires a valid instruction set\n");
+				print_usage();
+				return false;
+			}
+
+			options.force_cpu_isa = true;
+			arg_index += 1;
+		}
+		else if (is_str_equal(argument, "--memory-report"))
+		{
+			options.print_memory_report = true;
+		}
 		else if (is_str_equal(argument, "--info"))
 		{
 			if (options.action != command_line_action::none)
@@ -122,6 +373,353 @@ bool parse_command_line_arguments(int argc, char* argv[], command_line_options&
 
 			arg_index += 1;
 		}
+		else if (is_str_equal(argument, "--pack"))
+		{
+			if (options.action != command_line_action::none)
+			{
+				printf("Only one action can be provided\n");
+				print_usage();
+				return false;
+			}
+
+			if (arg_index + 2 >= argc)
+			{
+				printf("--pack requires an output file and input files\n");
+				print_usage();
+				return false;
+			}
+
+			options.action = command_line_action::pack;
+			options.output_filename = argv[arg_index + 1];
+
+			// Every argument until the next option is an input file
+			arg_index += 1;
+			while (arg_index + 1 < argc && !is_str_equal(argv[arg_index + 1], "--"))
+			{
+				options.input_filenames.push_back(argv[arg_index + 1]);
+				arg_index += 1;
+			}
+
+			if (options.input_filenames.empty())
+			{
+				printf("--pack requires input files\n");
+				print_usage();
+				return false;
+			}
+		}
+		else if (is_str_equal(argument, "--unpack"))
+		{
+			if (options.action != command_line_action::none)
+			{
+				printf("Only one action can be provided\n");
+				print_usage();
+				return false;
+			}
+
+			if (arg_index + 2 >= argc)
+			{
+				printf("--unpack requires an input file and an output directory\n");
+				print_usage();
+				return false;
+			}
+
+			options.action = command_line_action::unpack;
+			options.input_filename = argv[arg_index + 1];
+			options.output_filename = argv[arg_index + 2];
+
+			arg_index += 2;
+		}
+		else if (is_str_equal(argument, "--diff"))
+		{
+			if (options.action != command_line_action::none)
+			{
+				printf("Only one action can be provided\n");
+				print_usage();
+				return false;
+			}
+
+			if (arg_index + 2 >= argc)
+			{
+				printf("--diff requires two input files\n");
+				print_usage();
+				return false;
+			}
+
+			options.action = command_line_action::diff;
+			options.input_filenames.push_back(argv[arg_index + 1]);
+			options.input_filenames.push_back(argv[arg_index + 2]);
+
+			arg_index += 2;
+		}
+		else if (is_str_equal(argument, "--abs_tolerance") || is_str_equal(argument, "--rel_tolerance"))
+		{
+			if (arg_index + 1 >= argc)
+			{
+				printf("%s requires a tolerance\n", argument);
+				print_usage();
+				return false;
+			}
+
+			const float tolerance = static_cast<float>(std::atof(argv[arg_index + 1]));
+			if (!(tolerance >= 0.0F))
+			{
+				printf("%s requires a valid tolerance\n", argument);
+				print_usage();
+				return false;
+			}
+
+			if (is_str_equal(argument, "--abs_tolerance"))
+				options.diff.absolute_tolerance = tolerance;
+			else
+				options.diff.relative_tolerance = tolerance;
+
+			arg_index += 1;
+		}
+		else if (is_str_equal(argument, "--quick"))
+		{
+			options.diff.stop_on_first_mismatch = true;
+		}
+		else if (is_str_equal(argument, "--hash"))
+		{
+			if (options.action != command_line_action::none)
+			{
+				printf("Only one action can be provided\n");
+				print_usage();
+				return false;
+			}
+
+			options.action = command_line_action::hash;
+
+			// Every argument until the next option is an input file
+			while (arg_index + 1 < argc && !is_str_equal(argv[arg_index + 1], "--"))
+			{
+				options.input_filenames.push_back(argv[arg_index + 1]);
+				arg_index += 1;
+			}
+
+			if (options.input_filenames.empty())
+			{
+				printf("--hash requires input files\n");
+				print_usage();
+				return false;
+			}
+		}
+		else if (is_str_equal(argument, "--validate"))
+		{
+			if (options.action != command_line_action::none)
+			{
+				printf("Only one action can be provided\n");
+				print_usage();
+				return false;
+			}
+
+			options.action = command_line_action::validate;
+
+			// Every argument until the next option is an input file
+			while (arg_index + 1 < argc && !is_str_equal(argv[arg_index + 1], "--"))
+			{
+				options.input_filenames.push_back(argv[arg_index + 1]);
+				arg_index += 1;
+			}
+
+			if (options.input_filenames.empty())
+			{
+				printf("--validate requires input files\n");
+				print_usage();
+				return false;
+			}
+		}
+		else if (is_str_equal(argument, "--lod"))
+		{
+			if (options.action != command_line_action::none)
+			{
+				printf("Only one action can be provided\n");
+				print_usage();
+				return false;
+			}
+
+			if (arg_index + 3 >= argc)
+			{
+				printf("--lod requires an input file, a variants file, and an output directory\n");
+				print_usage();
+				return false;
+			}
+
+			options.action = command_line_action::lod;
+			options.input_filename = argv[arg_index + 1];
+			options.lod_variants_filename = argv[arg_index + 2];
+			options.output_filename = argv[arg_index + 3];
+
+			arg_index += 3;
+		}
+		else if (is_str_equal(argument, "--database"))
+		{
+			if (options.action != command_line_action::none)
+			{
+				printf("Only one action can be provided\n");
+				print_usage();
+				return false;
+			}
+
+			if (arg_index + 3 >= argc)
+			{
+				printf("--database requires a config file, an output directory, and input files\n");
+				print_usage();
+				return false;
+			}
+
+			options.action = command_line_action::database;
+			options.input_filename = argv[arg_index + 1];
+			options.output_filename = argv[arg_index + 2];
+
+			// Every argument until the next option is an input file
+			arg_index += 2;
+			while (arg_index + 1 < argc && !is_str_equal(argv[arg_index + 1], "--"))
+			{
+				options.input_filenames.push_back(argv[arg_index + 1]);
+				arg_index += 1;
+			}
+
+			if (options.input_filenames.empty())
+			{
+				printf("--database requires input files\n");
+				print_usage();
+				return false;
+			}
+		}
+		else if (is_str_equal(argument, "--index"))
+		{
+			if (options.action != command_line_action::none)
+			{
+				printf("Only one action can be provided\n");
+				print_usage();
+				return false;
+			}
+
+			if (arg_index + 2 >= argc)
+			{
+				printf("--index requires an input directory and an output file\n");
+				print_usage();
+				return false;
+			}
+
+			options.action = command_line_action::index;
+			options.input_filename = argv[arg_index + 1];
+			options.output_filename = argv[arg_index + 2];
+
+			arg_index += 2;
+		}
+		else if (is_str_equal(argument, "--matrix"))
+		{
+			if (options.action != command_line_action::none)
+			{
+				printf("Only one action can be provided\n");
+				print_usage();
+				return false;
+			}
+
+			if (arg_index + 2 >= argc)
+			{
+				printf("--matrix requires a metadata file and an output file\n");
+				print_usage();
+				return false;
+			}
+
+			options.action = command_line_action::matrix;
+			options.input_filename = argv[arg_index + 1];
+			options.output_filename = argv[arg_index + 2];
+
+			arg_index += 2;
+		}
+		else if (is_str_equal(argument, "--generate"))
+		{
+			if (options.action != command_line_action::none)
+			{
+				printf("Only one action can be provided\n");
+				print_usage();
+				return false;
+			}
+
+			if (arg_index + 1 >= argc)
+			{
+				printf("--generate requires an output file\n");
+				print_usage();
+				return false;
+			}
+
+			options.action = command_line_action::generate;
+			options.output_filename = argv[arg_index + 1];
+
+			arg_index += 1;
+		}
+		else if (is_str_equal(argument, "--bones") || is_str_equal(argument, "--depth") || is_str_equal(argument, "--samples") || is_str_equal(argument, "--seed"))
+		{
+			if (arg_index + 1 >= argc)
+			{
+				printf("%s requires a value\n", argument);
+				print_usage();
+				return false;
+			}
+
+			// Any seed is valid, counts must be positive
+			const bool is_seed = is_str_equal(argument, "--seed");
+			const long long value = std::atoll(argv[arg_index + 1]);
+			if (value < 0 || (!is_seed && (value == 0 || value > 0xFFFFFFFFLL)))
+			{
+				printf("%s requires a valid value\n", argument);
+				print_usage();
+				return false;
+			}
+
+			if (is_str_equal(argument, "--bones"))
+				options.generator.num_bones = static_cast<uint32_t>(value);
+			else if (is_str_equal(argument, "--depth"))
+				options.generator.hierarchy_depth = static_cast<uint32_t>(value);
+			else if (is_str_equal(argument, "--samples"))
+				options.generator.num_samples = static_cast<uint32_t>(value);
+			else if (is_seed)
+				options.generator.seed = static_cast<uint64_t>(value);
+
+			arg_index += 1;
+		}
+		else if (is_str_equal(argument, "--rate"))
+		{
+			if (arg_index + 1 >= argc)
+			{
+				printf("--rate requires a sample rate\n");
+				print_usage();
+				return false;
+			}
+
+			options.generator.sample_rate = static_cast<float>(std::atof(argv[arg_index + 1]));
+			if (!(options.generator.sample_rate > 0.0F))
+			{
+				printf("--rate requires a valid sample rate\n");
+				print_usage();
+				return false;
+			}
+
+			arg_index += 1;
+		}
+		else if (is_str_equal(argument, "--constant_ratio"))
+		{
+			if (arg_index + 1 >= argc)
+			{
+				printf("--constant_ratio requires a ratio\n");
+				print_usage();
+				return false;
+			}
+
+			options.generator.constant_bone_ratio = static_cast<float>(std::atof(argv[arg_index + 1]));
+			if (!(options.generator.constant_bone_ratio >= 0.0F) || options.generator.constant_bone_ratio > 1.0F)
+			{
+				printf("--constant_ratio requires a ratio between 0.0 and 1.0\n");
+				print_usage();
+				return false;
+			}
+
+			arg_index += 1;
+		}
 		else
 		{
 			// Unknown arguments just warn, they are ignored
@@ -25,8 +25,14 @@
 ////////////////////////////////////////////////////////////////////////////////
 
 #include <acl-sjson/acl_version.h>
+#include <acl-sjson/cpu_dispatch.h>
+#include <acl-sjson/diff.h>
+#include <acl-sjson/generator.h>
+#include <acl-sjson/hierarchy.h>
 
+#include <cstdint>
 #include <string>
+#include <vector>
 
 enum class command_line_action
 {
@@ -38,6 +44,43 @@ enum class command_line_action
 
 	// Dumps information about an input ACL clip to stdout
 	info,
+
+	// Packs a set of ACL clips into a track store where identical tracks are stored once
+	pack,
+
+	// Unpacks every clip from a track store into a directory
+	unpack,
+
+	// Generates a synthetic clip from a seed
+	generate,
+
+	// Compares the samples of two ACL clips
+	diff,
+
+	// Prints the canonical content hash of ACL clips
+	hash,
+
+	// Writes an index of every ACL clip within a directory
+	index,
+
+	// Compresses every config and clip pair listed in a regression test metadata file
+	matrix,
+
+	// Checks ACL clips for data that cannot be compressed reliably
+	validate,
+
+	// Compresses level of detail variants of an ACL clip where some tracks are stripped from the output
+	lod,
+
+	// Compresses a set of ACL clips and builds a database to stream their less important keyframes
+	database,
+};
+
+// An extra output written by the convert action
+struct command_line_output
+{
+	std::string				filename;
+	acl_sjson::acl_version	version;
 };
 
 struct command_line_options
@@ -47,8 +90,56 @@ struct command_line_options
 	std::string				input_filename;
 	std::string				output_filename;
 
+	std::vector<std::string>	input_filenames;
+
 	acl_sjson::acl_version	output_version;
 
+	// Extra outputs written from the same input, each with their own target version
+	std::vector<command_line_output>	additional_outputs;
+
+	// When positive, tracks are resampled to this sample rate before being written
+	float					resample_rate;
+
+	// Whether to resample to the native sample rate detected from duplicated frames
+	bool					resample_to_native_rate;
+
+	// Whether to use spherical interpolation for rotations when resampling
+	bool					resample_with_slerp;
+
+	// When set, only the samples within [range_start_time, range_end_time] in seconds are converted
+	bool					has_range;
+	float					range_start_time;
+	float					range_end_time;
+
+	// When set, transform tracks are reordered so that parents come before their children
+	bool					reorder_hierarchy;
+	acl_sjson::hierarchy_order	hierarchy_order;
+
+	// When set, tracks are cleaned up before they are written, see acl_sjson::preprocess_tracks
+	bool					preprocess;
+
+	// Whether SJSON outputs store floats in hexadecimal instead of the shortest decimal that reads back exactly
+	bool					binary_exact;
+
+	// SJSON file that lists the level of detail variants written by the lod action
+	std::string				lod_variants_filename;
+
+	// Maximum number of threads used to process tracks, 0 uses every hardware thread
+	uint32_t				num_threads;
+
+	// When set, the SIMD kernels use this instruction set instead of the most capable one supported
+	bool					force_cpu_isa;
+	acl_sjson::cpu_isa		cpu_isa;
+
+	// Whether to print the memory usage of every phase once the action completes
+	bool					print_memory_report;
+
+	// Settings used by the generate action
+	acl_sjson::generator_settings	generator;
+
+	// Settings used by the diff action
+	acl_sjson::diff_settings	diff;
+
 	command_line_options();
 };
 
@@ -22,25 +22,92 @@
 // SOFTWARE.
 ////////////////////////////////////////////////////////////////////////////////
 
+#include "convert.h"
 #include "command_line_options.h"
 #include "utils.h"
+#include "validate.h"
 
-#include <acl-sjson/api_v20.h>
-#include <acl-sjson/api_v21.h>
+#include <acl-sjson/hierarchy.h>
+#include <acl-sjson/io.h>
+#include <acl-sjson/parallel.h>
+#include <acl-sjson/preprocess.h>
+#include <acl-sjson/resample.h>
 #include <acl-sjson/track_array.h>
 
 #include <cstdio>
+#include <vector>
 
-bool convert(const command_line_options& options)
+bool get_outputs(const command_line_options& options, std::vector<command_line_output>& out_outputs)
 {
-	if (options.input_filename == options.output_filename)
+	std::vector<command_line_output> outputs;
+	outputs.push_back(command_line_output{ options.output_filename, options.output_version });
+	outputs.insert(outputs.end(), options.additional_outputs.begin(), options.additional_outputs.end());
+
+	for (size_t output_index = 0; output_index < outputs.size(); ++output_index)
 	{
-		printf("Input and output cannot be the same file\n");
-		return false;
+		const std::string& output_filename = outputs[output_index].filename;
+		if (options.input_filename == output_filename)
+		{
+			printf("Input and output cannot be the same file\n");
+			return false;
+		}
+
+		for (size_t other_output_index = 0; other_output_index < output_index; ++other_output_index)
+		{
+			if (outputs[other_output_index].filename == output_filename)
+			{
+				printf("Output file provided more than once: %s\n", output_filename.c_str());
+				return false;
+			}
+		}
+	}
+
+	out_outputs = std::move(outputs);
+	return true;
+}
+
+bool write_outputs(const std::vector<command_line_output>& outputs, const acl_sjson::track_array& tracks, bool binary_exact)
+{
+	if (outputs.size() == 1)
+		return write_tracks(outputs[0].filename.c_str(), tracks, outputs[0].version, binary_exact);
+
+	// The tracks are only read from here on, every output can be written concurrently
+	// Each output touches every sample, writers nested in this loop then run their own loops serially
+	const size_t work_per_output = tracks.get_num_tracks() * tracks.get_num_samples_per_track() * sizeof(acl_sjson::sample);
+
+	std::vector<char> results(outputs.size(), 0);
+	acl_sjson::parallel_for(outputs.size(), work_per_output, [&outputs, &tracks, &results, binary_exact](size_t output_index)
+		{
+			const command_line_output& output = outputs[output_index];
+			results[output_index] = write_tracks(output.filename.c_str(), tracks, output.version, binary_exact);
+		});
+
+	bool success = true;
+	for (size_t output_index = 0; output_index < outputs.size(); ++output_index)
+	{
+		if (results[output_index] == 0)
+		{
+			printf("Failed to write output: %s\n", outputs[output_index].filename.c_str());
+			success = false;
+		}
 	}
 
+	return success;
+}
+
+bool convert(const command_line_options& options)
+{
+	std::vector<command_line_output> outputs;
+	if (!get_outputs(options, outputs))
+		return false;
+
 	acl_sjson::track_array tracks;
-	if (!read_tracks(options.input_filename.c_str(), tracks))
+	if (options.has_range)
+	{
+		if (!read_tracks(options.input_filename.c_str(), options.range_start_time, options.range_end_time, tracks))
+			return false;
+	}
+	else if (!read_tracks(options.input_filename.c_str(), tracks))
 		return false;
 
 	if (tracks.get_version() == acl_sjson::acl_version::unknown)
@@ -49,35 +116,52 @@ bool convert(const command_line_options& options)
 		return false;
 	}
 
-	switch (options.output_version)
+	if (options.resample_rate > 0.0F || options.resample_to_native_rate)
 	{
-	case acl_sjson::acl_version::v02_00_00:
-		if (!acl_sjson_v20::write_tracks(options.output_filename.c_str(), tracks))
-			return false;
-		break;
-	case acl_sjson::acl_version::v02_01_00:
-		if (!acl_sjson_v21::write_tracks(options.output_filename.c_str(), tracks))
-			return false;
-		break;
-	default:
-		// By default, if no target version is specified, we maintain the source version
-		switch (tracks.get_version())
+		const float sample_rate = options.resample_to_native_rate ? acl_sjson::find_native_sample_rate(tracks) : options.resample_rate;
+		if (sample_rate != tracks.get_sample_rate())
 		{
-		case acl_sjson::acl_version::v02_00_00:
-			if (!acl_sjson_v20::write_tracks(options.output_filename.c_str(), tracks))
-				return false;
-			break;
-		case acl_sjson::acl_version::v02_01_00:
-			if (!acl_sjson_v21::write_tracks(options.output_filename.c_str(), tracks))
+			printf("Resampling from %.2f FPS to %.2f FPS\n", tracks.get_sample_rate(), sample_rate);
+
+			const acl_sjson::rotation_interpolation interpolation = options.resample_with_slerp ? acl_sjson::rotation_interpolation::slerp : acl_sjson::rotation_interpolation::nlerp;
+			if (!acl_sjson::resample(tracks, sample_rate, interpolation))
+			{
+				printf("Failed to resample tracks\n");
 				return false;
-			break;
-		default:
-			printf("Unsupported source version\n");
-			return false;
+			}
 		}
+	}
+
+	if (options.reorder_hierarchy && !acl_sjson::reorder_hierarchy(tracks, options.hierarchy_order))
+	{
+		printf("Failed to reorder tracks, the hierarchy is invalid\n");
+		return false;
+	}
+
+	if (options.preprocess)
+	{
+		acl_sjson::preprocess_stats stats;
+		acl_sjson::preprocess_tracks(tracks, acl_sjson::preprocess_settings(), stats);
+
+		printf("Preprocessed tracks: %u denormals flushed, %u rotations normalized, %u rotations flipped\n", stats.num_flushed_denormals, stats.num_normalized_rotations, stats.num_flipped_rotations);
+		printf("%u sub-tracks snapped to a constant, %u to their default value, %u tracks collapsed\n", stats.num_constant_sub_tracks, stats.num_default_sub_tracks, stats.num_collapsed_tracks);
+	}
+
+	// Binary outputs are compressed, reject invalid data before spending time compressing it
+	for (const command_line_output& output : outputs)
+	{
+		if (!acl_sjson::is_acl_bin_file(output.filename.c_str()))
+			continue;
+
+		if (!validate_before_compression(options.input_filename.c_str(), tracks))
+			return false;
+
 		break;
 	}
 
+	if (!write_outputs(outputs, tracks, options.binary_exact))
+		return false;
+
 	// Done!
 	return true;
 }
@@ -24,6 +24,20 @@
 // SOFTWARE.
 ////////////////////////////////////////////////////////////////////////////////
 
+#include <vector>
+
+namespace acl_sjson
+{
+	class track_array;
+}
+
 struct command_line_options;
+struct command_line_output;
 
 bool convert(const command_line_options& options);
+
+// Gathers every output provided on the command line, they must be unique
+bool get_outputs(const command_line_options& options, std::vector<command_line_output>& out_outputs);
+
+// Writes the tracks into every output concurrently
+bool write_outputs(const std::vector<command_line_output>& outputs, const acl_sjson::track_array& tracks, bool binary_exact);
@@ -0,0 +1,150 @@
+////////////////////////////////////////////////////////////////////////////////
+// The MIT License (MIT)
+//
+// Copyright (c) 2022 Nicholas Frechette
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+////////////////////////////////////////////////////////////////////////////////
+
+#include "command_line_options.h"
+#include "database.h"
+#include "utils.h"
+#include "validate.h"
+
+#include <acl-sjson/api_v20.h>
+#include <acl-sjson/api_v21.h>
+#include <acl-sjson/compression_settings.h>
+#include <acl-sjson/io.h>
+#include <acl-sjson/parallel.h>
+#include <acl-sjson/track_array.h>
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+static bool write_database(acl_sjson::acl_version version, const std::vector<const acl_sjson::track_array*>& clips, const std::vector<const char*>& clip_filenames,
+	const acl_sjson::compression_settings_t& settings, const char* database_filename, acl_sjson::database_stats_t& out_stats)
+{
+	switch (version)
+	{
+	case acl_sjson::acl_version::v02_00_00:
+		return acl_sjson_v20::write_database(clips.data(), clip_filenames.data(), clips.size(), settings, database_filename, out_stats);
+	case acl_sjson::acl_version::v02_01_00:
+		return acl_sjson_v21::write_database(clips.data(), clip_filenames.data(), clips.size(), settings, database_filename, out_stats);
+	default:
+		printf("Unsupported version\n");
+		return false;
+	}
+}
+
+static double get_ratio(size_t size, size_t total_size)
+{
+	return total_size != 0 ? (double(size) * 100.0 / double(total_size)) : 0.0;
+}
+
+bool build_database(const command_line_options& options)
+{
+	acl_sjson::compression_settings_t settings;
+	if (!acl_sjson::read_compression_settings(options.input_filename.c_str(), settings))
+		return false;
+
+	if (!settings.enable_database)
+		printf("Config does not enable the database, default tier proportions are used: %s\n", options.input_filename.c_str());
+
+	const size_t num_clips = options.input_filenames.size();
+	std::vector<acl_sjson::track_array> clips(num_clips);
+	std::vector<char> is_clip_valid(num_clips, 0);
+
+	// Every file is independent, reading dominates so each one counts as a large work item
+	const size_t work_per_clip = 1024 * 1024;
+	acl_sjson::parallel_for(num_clips, work_per_clip, [&](size_t clip_index)
+		{
+			const char* clip_filename = options.input_filenames[clip_index].c_str();
+			if (!read_tracks(clip_filename, clips[clip_index]))
+			{
+				printf("Failed to read input file: %s\n", clip_filename);
+				return;
+			}
+
+			is_clip_valid[clip_index] = validate_before_compression(clip_filename, clips[clip_index]);
+		});
+
+	for (const char is_valid : is_clip_valid)
+	{
+		if (is_valid == 0)
+			return false;
+	}
+
+	// Clips are written next to the database with their original name, they only retain the high importance tier
+	std::vector<std::string> output_filenames(num_clips);
+	std::vector<const acl_sjson::track_array*> clip_ptrs(num_clips);
+	std::vector<const char*> output_filename_ptrs(num_clips);
+	for (size_t clip_index = 0; clip_index < num_clips; ++clip_index)
+	{
+		std::string clip_name = get_filename(options.input_filenames[clip_index].c_str());
+		const size_t extension_offset = clip_name.find(".acl");
+		if (extension_offset != std::string::npos)
+			clip_name.resize(extension_offset);
+
+		output_filenames[clip_index] = options.output_filename + "/" + clip_name + ".acl";
+		clip_ptrs[clip_index] = &clips[clip_index];
+		output_filename_ptrs[clip_index] = output_filenames[clip_index].c_str();
+	}
+
+	for (size_t clip_index = 0; clip_index < num_clips; ++clip_index)
+	{
+		for (size_t other_clip_index = 0; other_clip_index < clip_index; ++other_clip_index)
+		{
+			if (output_filenames[clip_index] == output_filenames[other_clip_index])
+			{
+				printf("Clips cannot share the same name: %s\n", output_filenames[clip_index].c_str());
+				return false;
+			}
+		}
+	}
+
+	// A database can only be read by the ACL version that built it, the latest is used by default
+	const acl_sjson::acl_version version = options.output_version != acl_sjson::acl_version::unknown ? options.output_version : acl_sjson::acl_version::v02_01_00;
+	const std::string database_filename = options.output_filename + "/database.acldb";
+
+	if (!acl_sjson::create_directory(options.output_filename.c_str()))
+		return false;
+
+	acl_sjson::database_stats_t stats;
+	if (!write_database(version, clip_ptrs, output_filename_ptrs, settings, database_filename.c_str(), stats))
+		return false;
+
+	const size_t resident_high_size = stats.clips_size + stats.database_size;
+	const size_t resident_medium_size = resident_high_size + stats.medium_tier_size;
+	const size_t resident_all_size = resident_medium_size + stats.low_tier_size;
+
+	printf("Built a database with %u clips in %.3f ms: %s\n", static_cast<uint32_t>(stats.num_clips), stats.compression_time_ms, database_filename.c_str());
+	printf("    Clips (high importance tier): %u bytes\n", static_cast<uint32_t>(stats.clips_size));
+	printf("    Database without bulk data: %u bytes\n", static_cast<uint32_t>(stats.database_size));
+	printf("    Medium importance tier: %u bytes\n", static_cast<uint32_t>(stats.medium_tier_size));
+	printf("    Low importance tier: %u bytes\n", static_cast<uint32_t>(stats.low_tier_size));
+	printf("    Resident with every tier: %u bytes, max error %f\n", static_cast<uint32_t>(resident_all_size), stats.max_error_with_every_tier);
+	printf("    Resident without the low importance tier: %u bytes (%.2f%%), max error %f\n", static_cast<uint32_t>(resident_medium_size),
+		get_ratio(resident_medium_size, resident_all_size), stats.max_error_without_low_tier);
+	printf("    Resident with the high importance tier only: %u bytes (%.2f%%), max error %f\n", static_cast<uint32_t>(resident_high_size),
+		get_ratio(resident_high_size, resident_all_size), stats.max_error_with_high_tier_only);
+
+	return true;
+}
@@ -0,0 +1,102 @@
+////////////////////////////////////////////////////////////////////////////////
+// The MIT License (MIT)
+//
+// Copyright (c) 2022 Nicholas Frechette
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+////////////////////////////////////////////////////////////////////////////////
+
+#include "command_line_options.h"
+#include "utils.h"
+
+#include <acl-sjson/diff.h>
+#include <acl-sjson/track.h>
+#include <acl-sjson/track_array.h>
+
+#include <cstdio>
+#include <thread>
+
+bool diff(const command_line_options& options)
+{
+	const char* lhs_filename = options.input_filenames[0].c_str();
+	const char* rhs_filename = options.input_filenames[1].c_str();
+
+	// Both inputs are independent, read them concurrently
+	acl_sjson::track_array lhs_tracks;
+	bool is_lhs_read = false;
+	std::thread lhs_reader([&]() { is_lhs_read = read_tracks(lhs_filename, lhs_tracks); });
+
+	acl_sjson::track_array rhs_tracks;
+	const bool is_rhs_read = read_tracks(rhs_filename, rhs_tracks);
+
+	lhs_reader.join();
+
+	if (!is_lhs_read || !is_rhs_read)
+		return false;
+
+	acl_sjson::clip_diff result;
+	acl_sjson::diff_tracks(lhs_tracks, rhs_tracks, options.diff, result);
+
+	if (result.is_equal())
+	{
+		printf("Clips are identical\n");
+		return true;
+	}
+
+	if (!result.structure_mismatch.empty())
+	{
+		printf("Clips differ: %s\n", result.structure_mismatch.c_str());
+		return false;
+	}
+
+	if (options.diff.stop_on_first_mismatch)
+	{
+		const acl_sjson::track_diff& track_diff = result.tracks[0];
+		printf("Clips differ, first mismatch found in track %u (%s)\n", track_diff.track_index, lhs_tracks[track_diff.track_index].get_name());
+		return false;
+	}
+
+	printf("Clips differ, %u / %u tracks diverge\n", static_cast<uint32_t>(result.tracks.size()), static_cast<uint32_t>(lhs_tracks.get_num_tracks()));
+
+	for (const acl_sjson::track_diff& track_diff : result.tracks)
+	{
+		const char* track_name = lhs_tracks[track_diff.track_index].get_name();
+
+		if (track_diff.reason == acl_sjson::track_diff_reason::sample_type)
+		{
+			printf("Track %u (%s): sample types differ: %s vs %s\n", track_diff.track_index, track_name,
+				acl_sjson::to_string(track_diff.lhs_type), acl_sjson::to_string(track_diff.rhs_type));
+			continue;
+		}
+
+		printf("Track %u (%s): %u / %u frames differ, max error: %g\n", track_diff.track_index, track_name,
+			track_diff.num_mismatched_frames, static_cast<uint32_t>(lhs_tracks.get_num_samples_per_track()), track_diff.max_error);
+
+		printf("    Frames:");
+		for (const uint32_t frame : track_diff.frames)
+			printf(" %u", frame);
+
+		if (track_diff.num_mismatched_frames > track_diff.frames.size())
+			printf(" ...");
+
+		printf("\n");
+	}
+
+	return false;
+}
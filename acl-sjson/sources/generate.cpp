@@ -0,0 +1,58 @@
+////////////////////////////////////////////////////////////////////////////////
+// The MIT License (MIT)
+//
+// Copyright (c) 2022 Nicholas Frechette
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+////////////////////////////////////////////////////////////////////////////////
+
+#include "command_line_options.h"
+#include "convert.h"
+
+#include <acl-sjson/generator.h>
+#include <acl-sjson/track_array.h>
+
+#include <cstdio>
+#include <vector>
+
+bool generate(const command_line_options& options)
+{
+	std::vector<command_line_output> outputs;
+	if (!get_outputs(options, outputs))
+		return false;
+
+	const acl_sjson::generator_settings& settings = options.generator;
+
+	printf("Generating %u bones with a depth of %u, %u samples at %.2f FPS (seed %llu)\n",
+		settings.num_bones, settings.hierarchy_depth, settings.num_samples, settings.sample_rate,
+		static_cast<unsigned long long>(settings.seed));
+
+	acl_sjson::track_array tracks;
+	if (!acl_sjson::generate_clip(settings, tracks))
+	{
+		printf("Invalid generator settings\n");
+		return false;
+	}
+
+	if (!write_outputs(outputs, tracks, options.binary_exact))
+		return false;
+
+	// Done!
+	return true;
+}
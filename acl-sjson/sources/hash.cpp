@@ -0,0 +1,70 @@
+////////////////////////////////////////////////////////////////////////////////
+// The MIT License (MIT)
+//
+// Copyright (c) 2022 Nicholas Frechette
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+////////////////////////////////////////////////////////////////////////////////
+
+#include "command_line_options.h"
+#include "utils.h"
+
+#include <acl-sjson/hash.h>
+#include <acl-sjson/parallel.h>
+#include <acl-sjson/track_array.h>
+
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+bool hash(const command_line_options& options)
+{
+	const size_t num_files = options.input_filenames.size();
+
+	std::vector<uint64_t> hashes(num_files, 0);
+	std::vector<char> is_hashed(num_files, 0);
+
+	// Every file is independent, reading dominates so each one counts as a large work item
+	const size_t work_per_file = 1024 * 1024;
+	acl_sjson::parallel_for(num_files, work_per_file, [&](size_t file_index)
+		{
+			acl_sjson::track_array tracks;
+			if (!read_tracks(options.input_filenames[file_index].c_str(), tracks))
+				return;
+
+			hashes[file_index] = acl_sjson::hash_tracks(tracks);
+			is_hashed[file_index] = 1;
+		});
+
+	bool success = true;
+	for (size_t file_index = 0; file_index < num_files; ++file_index)
+	{
+		const char* filename = options.input_filenames[file_index].c_str();
+		if (is_hashed[file_index] == 0)
+		{
+			printf("Failed to hash: %s\n", filename);
+			success = false;
+			continue;
+		}
+
+		printf("%016llx  %s\n", static_cast<unsigned long long>(hashes[file_index]), filename);
+	}
+
+	return success;
+}
@@ -0,0 +1,277 @@
+////////////////////////////////////////////////////////////////////////////////
+// The MIT License (MIT)
+//
+// Copyright (c) 2022 Nicholas Frechette
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+////////////////////////////////////////////////////////////////////////////////
+
+#include "command_line_options.h"
+#include "utils.h"
+
+#include <acl-sjson/hash.h>
+#include <acl-sjson/io.h>
+#include <acl-sjson/parallel.h>
+#include <acl-sjson/track.h>
+#include <acl-sjson/track_array.h>
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace
+{
+	// Every value is pre-formatted, strings are quoted and escaped
+	using index_entry = std::vector<std::pair<const char*, std::string>>;
+
+	enum class index_format
+	{
+		json,
+		sjson,
+	};
+
+	static std::string format_string(const char* value)
+	{
+		std::string result = "\"";
+		for (const char* ptr = value; *ptr != '\0'; ++ptr)
+		{
+			const unsigned char c = static_cast<unsigned char>(*ptr);
+			if (c < 0x20)
+			{
+				// Control characters must be escaped in JSON strings
+				char escaped[8];
+				snprintf(escaped, sizeof(escaped), "\\u%04x", c);
+				result += escaped;
+				continue;
+			}
+
+			if (c == '"' || c == '\\')
+				result += '\\';
+
+			result += *ptr;
+		}
+
+		result += '"';
+		return result;
+	}
+
+	static std::string format_uint(uint64_t value)
+	{
+		char buffer[32];
+		snprintf(buffer, sizeof(buffer), "%llu", static_cast<unsigned long long>(value));
+		return buffer;
+	}
+
+	static std::string format_float(float value)
+	{
+		char buffer[32];
+		snprintf(buffer, sizeof(buffer), "%.9g", value);
+		return buffer;
+	}
+
+	static std::string format_hash(uint64_t value)
+	{
+		char buffer[32];
+		snprintf(buffer, sizeof(buffer), "\"%016llx\"", static_cast<unsigned long long>(value));
+		return buffer;
+	}
+
+	static index_entry make_entry(const std::string& filename, const acl_sjson::track_array& tracks)
+	{
+		const acl_sjson::metadata_t& metadata = tracks.get_metadata();
+
+		uint32_t num_constant_tracks = 0;
+		for (size_t track_index = 0; track_index < tracks.get_num_tracks(); ++track_index)
+		{
+			if (tracks[track_index].is_collapsed())
+				++num_constant_tracks;
+		}
+
+		index_entry entry;
+		entry.emplace_back("filename", format_string(filename.c_str()));
+		entry.emplace_back("name", format_string(metadata.name.c_str()));
+		entry.emplace_back("version", format_string(acl_sjson::to_string(tracks.get_version())));
+		entry.emplace_back("track_variant", format_string(acl_sjson::to_string(metadata.track_variant)));
+		entry.emplace_back("sample_type", format_string(acl_sjson::to_string(tracks.get_type())));
+		entry.emplace_back("num_tracks", format_uint(tracks.get_num_tracks()));
+		entry.emplace_back("num_constant_tracks", format_uint(num_constant_tracks));
+		entry.emplace_back("num_samples_per_track", format_uint(tracks.get_num_samples_per_track()));
+		entry.emplace_back("sample_rate", format_float(tracks.get_sample_rate()));
+		entry.emplace_back("duration", format_float(tracks.get_duration()));
+		entry.emplace_back("size", format_uint(metadata.size));
+
+		if (metadata.track_variant == acl_sjson::track_variant_t::transform)
+		{
+			const acl_sjson::transform_metadata_t& transform = metadata.variant.transform;
+			entry.emplace_back("rotation_format", format_string(acl_sjson::to_string(transform.rotation_format)));
+			entry.emplace_back("translation_format", format_string(acl_sjson::to_string(transform.translation_format)));
+			entry.emplace_back("scale_format", format_string(acl_sjson::to_string(transform.scale_format)));
+			entry.emplace_back("num_segments", format_uint(transform.num_segments));
+		}
+
+		entry.emplace_back("hash", format_hash(acl_sjson::hash_tracks(tracks)));
+		return entry;
+	}
+
+	static bool write_index(const char* filename, index_format format, const std::vector<index_entry>& entries)
+	{
+		std::ofstream file_stream(filename, std::ios_base::out | std::ios_base::trunc);
+		if (!file_stream.is_open() || !file_stream.good())
+		{
+			printf("Failed to open output file for writing: %s\n", filename);
+			return false;
+		}
+
+		// JSON separates values with commas and quotes keys, SJSON does neither
+		const bool is_json = format == index_format::json;
+		const char* assignment = is_json ? ": " : " = ";
+
+		const auto write_key = [&](const char* indent, const char* key)
+		{
+			file_stream << indent;
+			if (is_json)
+				file_stream << '"' << key << '"';
+			else
+				file_stream << key;
+			file_stream << assignment;
+		};
+
+		if (is_json)
+			file_stream << "{\n";
+
+		const char* root_indent = is_json ? "\t" : "";
+		const char* entry_indent = is_json ? "\t\t" : "\t";
+		const char* field_indent = is_json ? "\t\t\t" : "\t\t";
+
+		write_key(root_indent, "version");
+		file_stream << 1 << (is_json ? ",\n" : "\n");
+		write_key(root_indent, "clips");
+		file_stream << "[\n";
+
+		for (size_t entry_index = 0; entry_index < entries.size(); ++entry_index)
+		{
+			const index_entry& entry = entries[entry_index];
+
+			file_stream << entry_indent << "{\n";
+			for (size_t field_index = 0; field_index < entry.size(); ++field_index)
+			{
+				write_key(field_indent, entry[field_index].first);
+				file_stream << entry[field_index].second;
+
+				if (is_json && field_index + 1 < entry.size())
+					file_stream << ',';
+				file_stream << '\n';
+			}
+
+			file_stream << entry_indent << '}';
+			if (is_json && entry_index + 1 < entries.size())
+				file_stream << ',';
+			file_stream << '\n';
+		}
+
+		file_stream << root_indent << "]\n";
+
+		if (is_json)
+			file_stream << "}\n";
+
+		if (!file_stream.good())
+		{
+			printf("Failed to write output file: %s\n", filename);
+			return false;
+		}
+
+		return true;
+	}
+
+	static bool ends_with(const std::string& value, const char* suffix)
+	{
+		const size_t suffix_length = std::strlen(suffix);
+		return value.size() >= suffix_length && value.compare(value.size() - suffix_length, suffix_length, suffix) == 0;
+	}
+}
+
+bool build_index(const command_line_options& options)
+{
+	index_format format;
+	if (ends_with(options.output_filename, ".sjson"))
+		format = index_format::sjson;
+	else if (ends_with(options.output_filename, ".json"))
+		format = index_format::json;
+	else
+	{
+		printf("The index must be a *.json or *.sjson file\n");
+		return false;
+	}
+
+	std::vector<std::string> filenames;
+	if (!acl_sjson::list_files(options.input_filename.c_str(), true, filenames))
+		return false;
+
+	std::vector<std::string> clip_filenames;
+	for (const std::string& filename : filenames)
+	{
+		if (acl_sjson::is_acl_bin_file(filename.c_str()) || acl_sjson::is_acl_sjson_file(filename.c_str()))
+			clip_filenames.push_back(filename);
+	}
+
+	const size_t num_clips = clip_filenames.size();
+	const size_t input_path_length = options.input_filename.size();
+
+	std::vector<index_entry> entries(num_clips);
+	std::vector<char> is_indexed(num_clips, 0);
+
+	// Every clip is independent, reading dominates so each one counts as a large work item
+	const size_t work_per_clip = 1024 * 1024;
+	acl_sjson::parallel_for(num_clips, work_per_clip, [&](size_t clip_index)
+		{
+			const std::string& filename = clip_filenames[clip_index];
+
+			acl_sjson::track_array tracks;
+			if (!read_tracks(filename.c_str(), tracks))
+				return;
+
+			// Paths are relative to the indexed directory
+			size_t relative_path_offset = input_path_length;
+			while (relative_path_offset < filename.size() && (filename[relative_path_offset] == '/' || filename[relative_path_offset] == '\\'))
+				++relative_path_offset;
+
+			entries[clip_index] = make_entry(filename.substr(relative_path_offset), tracks);
+			is_indexed[clip_index] = 1;
+		});
+
+	std::vector<index_entry> indexed_entries;
+	indexed_entries.reserve(num_clips);
+	for (size_t clip_index = 0; clip_index < num_clips; ++clip_index)
+	{
+		if (is_indexed[clip_index] != 0)
+			indexed_entries.push_back(std::move(entries[clip_index]));
+		else
+			printf("Skipping clip that failed to read: %s\n", clip_filenames[clip_index].c_str());
+	}
+
+	if (!write_index(options.output_filename.c_str(), format, indexed_entries))
+		return false;
+
+	printf("Indexed %u clips\n", static_cast<uint32_t>(indexed_entries.size()));
+	return true;
+}
@@ -27,6 +27,7 @@
 
 #include <acl-sjson/api_v20.h>
 #include <acl-sjson/api_v21.h>
+#include <acl-sjson/resample.h>
 #include <acl-sjson/track_array.h>
 
 #include <cstdio>
@@ -56,9 +57,22 @@ bool info(const command_line_options& options)
 	printf("Num tracks: %u\n", static_cast<uint32_t>(tracks.get_num_tracks()));
 	printf("Num samples per track: %u\n", static_cast<uint32_t>(tracks.get_num_samples_per_track()));
 	printf("Sample rate: %.2f FPS\n", tracks.get_sample_rate());
+
+	const float native_sample_rate = acl_sjson::find_native_sample_rate(tracks);
+	if (native_sample_rate != tracks.get_sample_rate())
+		printf("Native sample rate: %.2f FPS (duplicated frames detected)\n", native_sample_rate);
 	printf("Duration: %.2f seconds\n", tracks.get_duration());
 	printf("Sample type: %s\n", acl_sjson::to_string(tracks.get_type()));
 
+	uint32_t num_constant_tracks = 0;
+	for (size_t track_index = 0; track_index < tracks.get_num_tracks(); ++track_index)
+	{
+		if (tracks[track_index].is_collapsed())
+			++num_constant_tracks;
+	}
+
+	printf("Num constant tracks: %u\n", num_constant_tracks);
+
 	if (tracks.get_type() == acl_sjson::sample_type::qvv)
 	{
 		// QVV
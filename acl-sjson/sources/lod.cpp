@@ -0,0 +1,130 @@
+////////////////////////////////////////////////////////////////////////////////
+// The MIT License (MIT)
+//
+// Copyright (c) 2022 Nicholas Frechette
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+////////////////////////////////////////////////////////////////////////////////
+
+#include "command_line_options.h"
+#include "lod.h"
+#include "utils.h"
+#include "validate.h"
+
+#include <acl-sjson/io.h>
+#include <acl-sjson/lod.h>
+#include <acl-sjson/parallel.h>
+#include <acl-sjson/track.h>
+#include <acl-sjson/track_array.h>
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+static uint32_t count_outputs(const acl_sjson::track_array& tracks)
+{
+	const size_t num_tracks = tracks.get_num_tracks();
+	uint32_t num_outputs = 0;
+	for (size_t track_index = 0; track_index < num_tracks; ++track_index)
+	{
+		if (tracks[track_index].get_output_index() != acl_sjson::k_invalid_track_index)
+			num_outputs++;
+	}
+
+	return num_outputs;
+}
+
+bool lod(const command_line_options& options)
+{
+	std::vector<acl_sjson::lod_variant_t> variants;
+	if (!acl_sjson::read_lod_variants(options.lod_variants_filename.c_str(), variants))
+		return false;
+
+	if (variants.empty())
+	{
+		printf("No variants found in %s\n", options.lod_variants_filename.c_str());
+		return false;
+	}
+
+	acl_sjson::track_array tracks;
+	if (!read_tracks(options.input_filename.c_str(), tracks))
+	{
+		printf("Failed to read input file: %s\n", options.input_filename.c_str());
+		return false;
+	}
+
+	// Stripping only changes output indices, validating the source once covers every variant
+	if (!validate_before_compression(options.input_filename.c_str(), tracks))
+		return false;
+
+	// Variants are named after the clip without its extension
+	std::string clip_name = get_filename(options.input_filename.c_str());
+	const size_t extension_offset = clip_name.find(".acl");
+	if (extension_offset != std::string::npos)
+		clip_name.resize(extension_offset);
+
+	if (!acl_sjson::create_directory(options.output_filename.c_str()))
+		return false;
+
+	const size_t num_variants = variants.size();
+	std::vector<std::string> output_filenames(num_variants);
+	std::vector<uint32_t> num_outputs(num_variants, 0);
+	std::vector<char> is_written(num_variants, 0);
+
+	// Every variant is compressed independently, compression dominates so each one counts as a large work item
+	const size_t work_per_variant = 1024 * 1024;
+	acl_sjson::parallel_for(num_variants, work_per_variant, [&](size_t variant_index)
+		{
+			const acl_sjson::lod_variant_t& variant = variants[variant_index];
+
+			acl_sjson::track_array variant_tracks;
+			if (!acl_sjson::make_lod_variant(tracks, variant, variant_tracks))
+				return;
+
+			output_filenames[variant_index] = options.output_filename + "/" + clip_name + "_" + variant.name + ".acl";
+			num_outputs[variant_index] = count_outputs(variant_tracks);
+
+			if (!write_tracks(output_filenames[variant_index].c_str(), variant_tracks, options.output_version, options.binary_exact))
+				return;
+
+			is_written[variant_index] = 1;
+		});
+
+	const uint32_t num_tracks = static_cast<uint32_t>(tracks.get_num_tracks());
+	const uint32_t num_source_outputs = count_outputs(tracks);
+
+	bool success = true;
+	for (size_t variant_index = 0; variant_index < num_variants; ++variant_index)
+	{
+		const char* variant_name = variants[variant_index].name.c_str();
+		if (is_written[variant_index] == 0)
+		{
+			printf("Failed to write variant '%s'\n", variant_name);
+			success = false;
+			continue;
+		}
+
+		printf("Variant '%s': %u / %u tracks output, %u stripped: %s\n", variant_name, num_outputs[variant_index], num_tracks,
+			num_source_outputs - num_outputs[variant_index], output_filenames[variant_index].c_str());
+	}
+
+	return success;
+}
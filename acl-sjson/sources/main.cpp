@@ -23,8 +23,21 @@
 ////////////////////////////////////////////////////////////////////////////////
 
 #include "convert.h"
+#include "diff.h"
 #include "command_line_options.h"
+#include "database.h"
+#include "generate.h"
+#include "hash.h"
+#include "index.h"
 #include "info.h"
+#include "lod.h"
+#include "matrix.h"
+#include "memory_report.h"
+#include "pack.h"
+#include "validate.h"
+
+#include <acl-sjson/cpu_dispatch.h>
+#include <acl-sjson/parallel.h>
 
 int main(int argc, char* argv[])
 {
@@ -33,6 +46,14 @@ int main(int argc, char* argv[])
 	if (!arguments_valid)
 		return 1;
 
+	acl_sjson::set_max_num_threads(options.num_threads);
+
+	if (options.force_cpu_isa && !acl_sjson::set_cpu_isa(options.cpu_isa))
+	{
+		printf("The %s instruction set is not supported, the most capable one is %s\n", acl_sjson::to_string(options.cpu_isa), acl_sjson::to_string(acl_sjson::get_supported_cpu_isa()));
+		return 1;
+	}
+
 	int exit_code = 0;
 	switch (options.action)
 	{
@@ -48,7 +69,40 @@ int main(int argc, char* argv[])
 	case command_line_action::info:
 		exit_code = info(options) ? 0 : 1;
 		break;
+	case command_line_action::pack:
+		exit_code = pack(options) ? 0 : 1;
+		break;
+	case command_line_action::unpack:
+		exit_code = unpack(options) ? 0 : 1;
+		break;
+	case command_line_action::generate:
+		exit_code = generate(options) ? 0 : 1;
+		break;
+	case command_line_action::diff:
+		exit_code = diff(options) ? 0 : 1;
+		break;
+	case command_line_action::hash:
+		exit_code = hash(options) ? 0 : 1;
+		break;
+	case command_line_action::index:
+		exit_code = build_index(options) ? 0 : 1;
+		break;
+	case command_line_action::matrix:
+		exit_code = matrix(options) ? 0 : 1;
+		break;
+	case command_line_action::validate:
+		exit_code = validate(options) ? 0 : 1;
+		break;
+	case command_line_action::lod:
+		exit_code = lod(options) ? 0 : 1;
+		break;
+	case command_line_action::database:
+		exit_code = build_database(options) ? 0 : 1;
+		break;
 	}
 
+	if (options.print_memory_report)
+		print_memory_report();
+
 	return exit_code;
 }
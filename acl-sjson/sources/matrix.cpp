@@ -0,0 +1,304 @@
+////////////////////////////////////////////////////////////////////////////////
+// The MIT License (MIT)
+//
+// Copyright (c) 2022 Nicholas Frechette
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+////////////////////////////////////////////////////////////////////////////////
+
+#include "command_line_options.h"
+#include "utils.h"
+#include "validate.h"
+
+#include <acl-sjson/api_v20.h>
+#include <acl-sjson/api_v21.h>
+#include <acl-sjson/compression_settings.h>
+#include <acl-sjson/parallel.h>
+#include <acl-sjson/regression_metadata.h>
+#include <acl-sjson/track_array.h>
+
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace
+{
+	enum class matrix_status
+	{
+		compressed,
+		failed,
+
+		// The clip has errors that compression cannot handle
+		invalid,
+	};
+
+	struct matrix_entry
+	{
+		acl_sjson::acl_version version;
+		size_t config_index;
+		size_t clip_index;
+
+		matrix_status status;
+		acl_sjson::compression_stats_t stats;
+	};
+
+	static const char* to_string(matrix_status status)
+	{
+		switch (status)
+		{
+		case matrix_status::compressed:	return "compressed";
+		case matrix_status::failed:		return "failed";
+		case matrix_status::invalid:	return "invalid";
+		default:						return "unknown";
+		}
+	}
+
+	// Returns the directory part of a path, including its trailing separator
+	static std::string get_directory(const std::string& path)
+	{
+		const size_t separator_offset = path.find_last_of("/\\");
+		return separator_offset != std::string::npos ? path.substr(0, separator_offset + 1) : std::string();
+	}
+
+	static bool compress_tracks(acl_sjson::acl_version version, const acl_sjson::track_array& tracks, const acl_sjson::compression_settings_t& settings, acl_sjson::compression_stats_t& out_stats)
+	{
+		switch (version)
+		{
+		case acl_sjson::acl_version::v02_00_00:
+			return acl_sjson_v20::compress_tracks(tracks, settings, out_stats);
+		case acl_sjson::acl_version::v02_01_00:
+			return acl_sjson_v21::compress_tracks(tracks, settings, out_stats);
+		default:
+			printf("Unsupported version\n");
+			return false;
+		}
+	}
+
+	static std::string format_string(const std::string& value)
+	{
+		std::string result = "\"";
+		for (const char c : value)
+		{
+			if (c == '"' || c == '\\')
+				result += '\\';
+
+			result += c;
+		}
+
+		result += '"';
+		return result;
+	}
+
+	static void print_table(const std::vector<matrix_entry>& entries, const std::vector<acl_sjson::compression_settings_t>& configs, const std::vector<std::string>& clip_names)
+	{
+		printf("%-8s %-48s %-32s %12s %16s %16s %12s\n", "Version", "Config", "Clip", "Size", "Compression ms", "Decompression ms", "Max error");
+
+		for (const matrix_entry& entry : entries)
+		{
+			const char* config_name = configs[entry.config_index].name.c_str();
+			const char* clip_name = clip_names[entry.clip_index].c_str();
+
+			if (entry.status != matrix_status::compressed)
+			{
+				printf("%-8s %-48s %-32s %12s\n", acl_sjson::to_string(entry.version), config_name, clip_name, to_string(entry.status));
+				continue;
+			}
+
+			const acl_sjson::compression_stats_t& stats = entry.stats;
+			printf("%-8s %-48s %-32s %12zu %16.3f %16.3f %12.6f\n", acl_sjson::to_string(entry.version), config_name, clip_name,
+				stats.compressed_size, stats.compression_time_ms, stats.decompression_time_ms, stats.max_error);
+		}
+	}
+
+	static bool write_report(const char* filename, const std::vector<matrix_entry>& entries, const std::vector<acl_sjson::compression_settings_t>& configs, const std::vector<std::string>& clip_names)
+	{
+		std::ofstream file_stream(filename, std::ios_base::out | std::ios_base::trunc);
+		if (!file_stream.is_open() || !file_stream.good())
+		{
+			printf("Failed to open output file for writing: %s\n", filename);
+			return false;
+		}
+
+		// Floats are written with enough digits to round trip
+		file_stream.precision(9);
+
+		file_stream << "{\n";
+		file_stream << "\t\"version\": 1,\n";
+		file_stream << "\t\"results\": [\n";
+
+		for (size_t entry_index = 0; entry_index < entries.size(); ++entry_index)
+		{
+			const matrix_entry& entry = entries[entry_index];
+			const acl_sjson::compression_settings_t& config = configs[entry.config_index];
+
+			file_stream << "\t\t{\n";
+			file_stream << "\t\t\t\"version\": " << format_string(acl_sjson::to_string(entry.version)) << ",\n";
+			file_stream << "\t\t\t\"config\": " << format_string(config.name) << ",\n";
+			file_stream << "\t\t\t\"clip\": " << format_string(clip_names[entry.clip_index]) << ",\n";
+			file_stream << "\t\t\t\"status\": " << format_string(to_string(entry.status));
+
+			if (entry.status == matrix_status::compressed)
+			{
+				const acl_sjson::compression_stats_t& stats = entry.stats;
+				file_stream << ",\n";
+				file_stream << "\t\t\t\"level\": " << format_string(acl_sjson::to_string(config.level)) << ",\n";
+				file_stream << "\t\t\t\"error_metric\": " << format_string(acl_sjson::to_string(config.error_metric)) << ",\n";
+				file_stream << "\t\t\t\"compressed_size\": " << stats.compressed_size << ",\n";
+				file_stream << "\t\t\t\"compression_time_ms\": " << stats.compression_time_ms << ",\n";
+				file_stream << "\t\t\t\"decompression_time_ms\": " << stats.decompression_time_ms << ",\n";
+				file_stream << "\t\t\t\"max_error\": " << stats.max_error << ",\n";
+				file_stream << "\t\t\t\"max_error_track_index\": " << stats.max_error_track_index << ",\n";
+				file_stream << "\t\t\t\"max_error_sample_time\": " << stats.max_error_sample_time;
+			}
+
+			file_stream << "\n\t\t}";
+			if (entry_index + 1 < entries.size())
+				file_stream << ',';
+			file_stream << '\n';
+		}
+
+		file_stream << "\t]\n";
+		file_stream << "}\n";
+
+		if (!file_stream.good())
+		{
+			printf("Failed to write output file: %s\n", filename);
+			return false;
+		}
+
+		return true;
+	}
+}
+
+bool matrix(const command_line_options& options)
+{
+	acl_sjson::regression_metadata_t metadata;
+	if (!acl_sjson::read_regression_metadata(options.input_filename.c_str(), metadata))
+		return false;
+
+	// Configs and clips live next to the metadata file
+	const std::string directory = get_directory(options.input_filename);
+
+	bool success = true;
+
+	std::vector<acl_sjson::compression_settings_t> configs;
+	for (const std::string& config_filename : metadata.configs)
+	{
+		acl_sjson::compression_settings_t settings;
+		if (!acl_sjson::read_compression_settings((directory + config_filename).c_str(), settings))
+		{
+			printf("Skipping config that failed to read: %s\n", config_filename.c_str());
+			success = false;
+			continue;
+		}
+
+		configs.push_back(settings);
+	}
+
+	// Clips are read once and shared by every config and version
+	const size_t num_clips = metadata.clips.size();
+	std::vector<acl_sjson::track_array> clips(num_clips);
+	std::vector<char> is_clip_read(num_clips, 0);
+	std::vector<char> is_clip_valid(num_clips, 0);
+
+	// Every clip is independent, reading dominates so each one counts as a large work item
+	// Clips are validated once, every config would otherwise fail on them one at a time
+	const size_t work_per_clip = 1024 * 1024;
+	acl_sjson::parallel_for(num_clips, work_per_clip, [&](size_t clip_index)
+		{
+			const std::string clip_filename = directory + metadata.clips[clip_index];
+			if (!read_tracks(clip_filename.c_str(), clips[clip_index]))
+				return;
+
+			is_clip_read[clip_index] = 1;
+			is_clip_valid[clip_index] = validate_before_compression(clip_filename.c_str(), clips[clip_index]);
+		});
+
+	std::vector<std::string> clip_names(num_clips);
+	for (size_t clip_index = 0; clip_index < num_clips; ++clip_index)
+	{
+		const std::string& clip_filename = metadata.clips[clip_index];
+		clip_names[clip_index] = clip_filename.substr(0, clip_filename.find('.'));
+
+		if (is_clip_read[clip_index] == 0)
+		{
+			printf("Skipping clip that failed to read: %s\n", clip_filename.c_str());
+			success = false;
+		}
+	}
+
+	std::vector<acl_sjson::acl_version> versions;
+	if (options.output_version != acl_sjson::acl_version::unknown)
+		versions.push_back(options.output_version);
+	else
+	{
+		versions.push_back(acl_sjson::acl_version::v02_00_00);
+		versions.push_back(acl_sjson::acl_version::v02_01_00);
+	}
+
+	std::vector<matrix_entry> entries;
+	for (const acl_sjson::acl_version version : versions)
+	{
+		for (size_t config_index = 0; config_index < configs.size(); ++config_index)
+		{
+			for (size_t clip_index = 0; clip_index < num_clips; ++clip_index)
+			{
+				if (is_clip_read[clip_index] == 0)
+					continue;
+
+				matrix_entry entry;
+				entry.version = version;
+				entry.config_index = config_index;
+				entry.clip_index = clip_index;
+				entry.status = is_clip_valid[clip_index] != 0 ? matrix_status::failed : matrix_status::invalid;
+				entries.push_back(entry);
+			}
+		}
+	}
+
+	// Every pair is compressed concurrently, timings are comparable within a run but include
+	// contention between threads, use --num_threads 1 for stable timings
+	const size_t work_per_entry = 1024 * 1024;
+	acl_sjson::parallel_for(entries.size(), work_per_entry, [&](size_t entry_index)
+		{
+			matrix_entry& entry = entries[entry_index];
+			const acl_sjson::compression_settings_t& config = configs[entry.config_index];
+
+			if (entry.status == matrix_status::invalid)
+				return;
+
+			if (compress_tracks(entry.version, clips[entry.clip_index], config, entry.stats))
+				entry.status = matrix_status::compressed;
+		});
+
+	for (const matrix_entry& entry : entries)
+	{
+		if (entry.status == matrix_status::failed || entry.status == matrix_status::invalid)
+			success = false;
+	}
+
+	print_table(entries, configs, clip_names);
+
+	if (!write_report(options.output_filename.c_str(), entries, configs, clip_names))
+		return false;
+
+	return success;
+}
@@ -0,0 +1,89 @@
+////////////////////////////////////////////////////////////////////////////////
+// The MIT License (MIT)
+//
+// Copyright (c) 2022 Nicholas Frechette
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+////////////////////////////////////////////////////////////////////////////////
+
+#include "memory_report.h"
+
+#include <acl-sjson/memory_tracker.h>
+
+#include <cstdint>
+#include <cstdio>
+
+static void format_size(uint64_t size, char* buffer, size_t buffer_size)
+{
+	if (size >= 1024 * 1024)
+		snprintf(buffer, buffer_size, "%.3f MB", double(size) / (1024.0 * 1024.0));
+	else if (size >= 1024)
+		snprintf(buffer, buffer_size, "%.2f KB", double(size) / 1024.0);
+	else
+		snprintf(buffer, buffer_size, "%u Bytes", uint32_t(size));
+}
+
+static void print_memory_stats(const char* name, const acl_sjson::memory_stats& stats)
+{
+	char allocated[32];
+	char peak_live[32];
+	char live[32];
+	format_size(stats.total_allocated_bytes, allocated, sizeof(allocated));
+	format_size(stats.peak_live_bytes, peak_live, sizeof(peak_live));
+	format_size(stats.live_bytes, live, sizeof(live));
+
+	printf("%s: %llu allocations, %s allocated, %s peak live, %s live\n", name,
+		static_cast<unsigned long long>(stats.num_allocations), allocated, peak_live, live);
+
+	for (uint32_t bucket = 0; bucket < acl_sjson::k_num_allocation_size_buckets; ++bucket)
+	{
+		const uint64_t num_allocations = stats.allocation_size_histogram[bucket];
+		if (num_allocations == 0)
+			continue;
+
+		char min_size[32];
+		format_size(uint64_t(1) << bucket, min_size, sizeof(min_size));
+
+		if (bucket + 1 < acl_sjson::k_num_allocation_size_buckets)
+		{
+			char max_size[32];
+			format_size(uint64_t(1) << (bucket + 1), max_size, sizeof(max_size));
+			printf("    [%s, %s): %llu\n", min_size, max_size, static_cast<unsigned long long>(num_allocations));
+		}
+		else
+			printf("    [%s, ...): %llu\n", min_size, static_cast<unsigned long long>(num_allocations));
+	}
+}
+
+void print_memory_report()
+{
+	printf("Memory report:\n");
+
+	for (uint32_t phase_index = 0; phase_index < static_cast<uint32_t>(acl_sjson::memory_phase::count); ++phase_index)
+	{
+		const acl_sjson::memory_phase phase = static_cast<acl_sjson::memory_phase>(phase_index);
+		const acl_sjson::memory_stats stats = acl_sjson::get_memory_stats(phase);
+		if (stats.num_allocations == 0)
+			continue;	// Skip phases that did not run
+
+		print_memory_stats(acl_sjson::to_string(phase), stats);
+	}
+
+	print_memory_stats("total", acl_sjson::get_total_memory_stats());
+}
@@ -0,0 +1,97 @@
+////////////////////////////////////////////////////////////////////////////////
+// The MIT License (MIT)
+//
+// Copyright (c) 2022 Nicholas Frechette
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+////////////////////////////////////////////////////////////////////////////////
+
+#include "command_line_options.h"
+#include "utils.h"
+
+#include <acl-sjson/io.h>
+#include <acl-sjson/track_array.h>
+#include <acl-sjson/track_store.h>
+
+#include <cstdio>
+#include <string>
+
+bool pack(const command_line_options& options)
+{
+	acl_sjson::track_store store;
+
+	for (const std::string& input_filename : options.input_filenames)
+	{
+		if (input_filename == options.output_filename)
+		{
+			printf("Input and output cannot be the same file\n");
+			return false;
+		}
+
+		acl_sjson::track_array tracks;
+		if (!read_tracks(input_filename.c_str(), tracks))
+		{
+			printf("Failed to read input file: %s\n", input_filename.c_str());
+			return false;
+		}
+
+		if (tracks.get_version() == acl_sjson::acl_version::unknown)
+		{
+			printf("Unknown ACL version used in input file: %s\n", input_filename.c_str());
+			return false;
+		}
+
+		store.add_clip(get_filename(input_filename.c_str()), tracks);
+	}
+
+	if (!store.write(options.output_filename.c_str()))
+		return false;
+
+	printf("Packed %u clips with %u tracks, %u unique tracks\n",
+		static_cast<uint32_t>(store.get_num_clips()),
+		static_cast<uint32_t>(store.get_num_track_references()),
+		static_cast<uint32_t>(store.get_num_unique_tracks()));
+
+	return true;
+}
+
+bool unpack(const command_line_options& options)
+{
+	acl_sjson::track_store store;
+	if (!store.read(options.input_filename.c_str()))
+		return false;
+
+	if (!acl_sjson::create_directory(options.output_filename.c_str()))
+		return false;
+
+	const size_t num_clips = store.get_num_clips();
+	for (size_t clip_index = 0; clip_index < num_clips; ++clip_index)
+	{
+		acl_sjson::track_array tracks;
+		if (!store.make_clip(clip_index, tracks))
+			return false;
+
+		const std::string output_filename = options.output_filename + "/" + store.get_clip_name(clip_index);
+
+		if (!write_tracks(output_filename.c_str(), tracks, options.output_version, options.binary_exact))
+			return false;
+	}
+
+	return true;
+}
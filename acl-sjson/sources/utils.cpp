@@ -24,7 +24,14 @@
 
 #include "utils.h"
 
+#include <acl-sjson/api_v20.h>
 #include <acl-sjson/api_v21.h>
+#include <acl-sjson/io.h>
+#include <acl-sjson/sjson_writer.h>
+#include <acl-sjson/track_array.h>
+
+#include <cstdio>
+#include <cstring>
 
 bool read_tracks(const char* filename, acl_sjson::track_array& out_tracks)
 {
@@ -34,3 +41,51 @@ bool read_tracks(const char* filename, acl_sjson::track_array& out_tracks)
 
 	return false;
 }
+
+bool read_tracks(const char* filename, float start_time, float end_time, acl_sjson::track_array& out_tracks)
+{
+	// Always read with latest version, we are backwards compatible
+	if (acl_sjson_v21::read_tracks(filename, start_time, end_time, out_tracks))
+		return true;
+
+	return false;
+}
+
+bool write_tracks(const char* filename, const acl_sjson::track_array& tracks, acl_sjson::acl_version version, bool binary_exact)
+{
+	// By default, if no target version is specified, we maintain the source version
+	if (version == acl_sjson::acl_version::unknown)
+		version = tracks.get_version();
+
+	// Decimals cannot represent every value, ACL writes those in hexadecimal
+	if (acl_sjson::is_acl_sjson_file(filename) && !binary_exact)
+	{
+		if (acl_sjson::can_write_sjson_decimal(tracks))
+			return acl_sjson::write_sjson_tracks(filename, tracks, version);
+
+		printf("Samples that aren't finite require binary exact output: %s\n", filename);
+	}
+
+	switch (version)
+	{
+	case acl_sjson::acl_version::v02_00_00:
+		return acl_sjson_v20::write_tracks(filename, tracks);
+	case acl_sjson::acl_version::v02_01_00:
+		return acl_sjson_v21::write_tracks(filename, tracks);
+	default:
+		printf("Unsupported source version\n");
+		return false;
+	}
+}
+
+const char* get_filename(const char* path)
+{
+	const char* filename = path;
+	for (const char* ptr = path; *ptr != '\0'; ++ptr)
+	{
+		if (*ptr == '/' || *ptr == '\\')
+			filename = ptr + 1;
+	}
+
+	return filename;
+}
@@ -24,9 +24,19 @@
 // SOFTWARE.
 ////////////////////////////////////////////////////////////////////////////////
 
+#include <acl-sjson/acl_version.h>
+
 namespace acl_sjson
 {
 	class track_array;
 }
 
 bool read_tracks(const char* filename, acl_sjson::track_array& out_tracks);
+bool read_tracks(const char* filename, float start_time, float end_time, acl_sjson::track_array& out_tracks);
+
+// Writes the tracks with the provided version, if the version is unknown, the source version is maintained
+// SJSON files store floats as the shortest decimal that reads back exactly unless binary exact output is requested
+bool write_tracks(const char* filename, const acl_sjson::track_array& tracks, acl_sjson::acl_version version, bool binary_exact);
+
+// Returns the filename part of a path
+const char* get_filename(const char* path);
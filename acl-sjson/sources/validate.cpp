@@ -0,0 +1,139 @@
+////////////////////////////////////////////////////////////////////////////////
+// The MIT License (MIT)
+//
+// Copyright (c) 2022 Nicholas Frechette
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+////////////////////////////////////////////////////////////////////////////////
+
+#include "command_line_options.h"
+#include "utils.h"
+#include "validate.h"
+
+#include <acl-sjson/parallel.h>
+#include <acl-sjson/track.h>
+#include <acl-sjson/track_array.h>
+#include <acl-sjson/validation.h>
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+std::string format_validation(const acl_sjson::track_array& tracks, const acl_sjson::clip_validation& validation, bool include_warnings)
+{
+	std::string result;
+	char line[512];
+
+	const uint32_t num_samples = static_cast<uint32_t>(tracks.get_num_samples_per_track());
+	for (const acl_sjson::validation_issue& issue : validation.issues)
+	{
+		const acl_sjson::validation_severity severity = acl_sjson::get_severity(issue.type);
+		if (severity == acl_sjson::validation_severity::warning && !include_warnings)
+			continue;
+
+		const acl_sjson::track& track_ = tracks[issue.track_index];
+
+		if (issue.sample_index == acl_sjson::k_invalid_track_index)
+		{
+			snprintf(line, sizeof(line), "    Track %u (%s): %s: %s %u\n", issue.track_index, track_.get_name(),
+				acl_sjson::to_string(severity), acl_sjson::to_string(issue.type), issue.index);
+		}
+		else if (issue.type == acl_sjson::validation_issue_type::non_normalized_rotation)
+		{
+			snprintf(line, sizeof(line), "    Track %u (%s): %s: %s at sample %u, squared length %.9g, %u / %u samples\n", issue.track_index, track_.get_name(),
+				acl_sjson::to_string(severity), acl_sjson::to_string(issue.type), issue.sample_index, issue.value, issue.num_samples, num_samples);
+		}
+		else
+		{
+			snprintf(line, sizeof(line), "    Track %u (%s): %s: %s at sample %u, %s = %.9g, %u / %u samples\n", issue.track_index, track_.get_name(),
+				acl_sjson::to_string(severity), acl_sjson::to_string(issue.type), issue.sample_index,
+				acl_sjson::get_component_name(track_.get_type(), issue.component_index), issue.value, issue.num_samples, num_samples);
+		}
+
+		result += line;
+	}
+
+	return result;
+}
+
+bool validate_before_compression(const char* filename, const acl_sjson::track_array& tracks)
+{
+	acl_sjson::validation_settings settings;
+	settings.stop_on_first_error = true;
+
+	acl_sjson::clip_validation validation;
+	acl_sjson::validate_tracks(tracks, settings, validation);
+
+	if (!validation.has_errors())
+		return true;
+
+	printf("Invalid clip cannot be compressed: %s\n%s", filename, format_validation(tracks, validation, false).c_str());
+	return false;
+}
+
+bool validate(const command_line_options& options)
+{
+	const size_t num_files = options.input_filenames.size();
+
+	// Reports are formatted by each worker, clips do not need to be retained to be printed in order
+	std::vector<std::string> reports(num_files);
+	std::vector<acl_sjson::clip_validation> validations(num_files);
+	std::vector<char> is_validated(num_files, 0);
+
+	// Every file is independent, reading dominates so each one counts as a large work item
+	const size_t work_per_file = 1024 * 1024;
+	acl_sjson::parallel_for(num_files, work_per_file, [&](size_t file_index)
+		{
+			acl_sjson::track_array tracks;
+			if (!read_tracks(options.input_filenames[file_index].c_str(), tracks))
+				return;
+
+			acl_sjson::validate_tracks(tracks, acl_sjson::validation_settings(), validations[file_index]);
+			reports[file_index] = format_validation(tracks, validations[file_index], true);
+			is_validated[file_index] = 1;
+		});
+
+	bool success = true;
+	for (size_t file_index = 0; file_index < num_files; ++file_index)
+	{
+		const char* filename = options.input_filenames[file_index].c_str();
+		if (is_validated[file_index] == 0)
+		{
+			printf("Failed to validate: %s\n", filename);
+			success = false;
+			continue;
+		}
+
+		const acl_sjson::clip_validation& validation = validations[file_index];
+		if (validation.issues.empty())
+		{
+			printf("Valid: %s\n", filename);
+			continue;
+		}
+
+		printf("%s: %s, %u errors, %u warnings\n", validation.has_errors() ? "Invalid" : "Valid", filename, validation.num_errors, validation.num_warnings);
+		printf("%s", reports[file_index].c_str());
+
+		if (validation.has_errors())
+			success = false;
+	}
+
+	return success;
+}
@@ -24,13 +24,33 @@
 // SOFTWARE.
 ////////////////////////////////////////////////////////////////////////////////
 
+#include <cstddef>
+
 namespace acl_sjson
 {
+	struct compression_settings_t;
+	struct compression_stats_t;
+	struct database_stats_t;
 	class track_array;
 }
 
 namespace acl_sjson_v20
 {
 	bool read_tracks(const char* filename, acl_sjson::track_array& out_tracks);
+
+	// Reads only the samples within [start_time, end_time] in seconds
+	// Compressed inputs only decompress the poses within the range
+	bool read_tracks(const char* filename, float start_time, float end_time, acl_sjson::track_array& out_tracks);
+
 	bool write_tracks(const char* filename, const acl_sjson::track_array& tracks);
+
+	// Compresses the tracks in memory with the provided settings then measures the
+	// compressed size, the compression and decompression times, and the max error
+	bool compress_tracks(const acl_sjson::track_array& tracks, const acl_sjson::compression_settings_t& settings, acl_sjson::compression_stats_t& out_stats);
+
+	// Compresses every clip then builds a database with their medium and low importance tiers
+	// Clips are bound to the database and written to their filename, the database is written without its bulk data
+	// The bulk data of each tier is written next to the database with a .medium and .low extension
+	// Tiers are then streamed back from those files and out again to measure the error at every quality level
+	bool write_database(const acl_sjson::track_array* const* clips, const char* const* clip_filenames, size_t num_clips, const acl_sjson::compression_settings_t& settings, const char* database_filename, acl_sjson::database_stats_t& out_stats);
 }
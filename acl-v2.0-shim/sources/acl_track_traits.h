@@ -0,0 +1,109 @@
+#pragma once
+
+////////////////////////////////////////////////////////////////////////////////
+// The MIT License (MIT)
+//
+// Copyright (c) 2022 Nicholas Frechette
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+////////////////////////////////////////////////////////////////////////////////
+
+#include <acl-sjson/sample.h>
+#include <acl-sjson/sample_traits.h>
+#include <acl-sjson/track_description.h>
+
+#include <acl/compression/track.h>
+#include <acl/core/track_types.h>
+
+namespace acl_sjson_v20
+{
+	//////////////////////////////////////////////////////////////////////////
+	// Maps every sample type to its matching ACL track type.
+	// Sample types without an ACL equivalent have no members.
+	template<acl_sjson::sample_type type>
+	struct acl_track_traits
+	{
+	};
+
+	struct acl_scalar_track_traits
+	{
+		static acl_sjson::scalar_track_description& get_description(acl_sjson::track_description& desc) { return desc.scalar; }
+		static const acl_sjson::scalar_track_description& get_description(const acl_sjson::track_description& desc) { return desc.scalar; }
+	};
+
+	struct acl_transform_track_traits
+	{
+		static acl_sjson::transform_track_description& get_description(acl_sjson::track_description& desc) { return desc.transform; }
+		static const acl_sjson::transform_track_description& get_description(const acl_sjson::track_description& desc) { return desc.transform; }
+	};
+
+	template<>
+	struct acl_track_traits<acl_sjson::sample_type::float1> : acl_scalar_track_traits
+	{
+		using track_type = acl::track_float1f;
+	};
+
+	template<>
+	struct acl_track_traits<acl_sjson::sample_type::float2> : acl_scalar_track_traits
+	{
+		using track_type = acl::track_float2f;
+	};
+
+	template<>
+	struct acl_track_traits<acl_sjson::sample_type::float3> : acl_scalar_track_traits
+	{
+		using track_type = acl::track_float3f;
+	};
+
+	template<>
+	struct acl_track_traits<acl_sjson::sample_type::float4> : acl_scalar_track_traits
+	{
+		using track_type = acl::track_float4f;
+	};
+
+	template<>
+	struct acl_track_traits<acl_sjson::sample_type::vector4> : acl_scalar_track_traits
+	{
+		using track_type = acl::track_vector4f;
+	};
+
+	template<>
+	struct acl_track_traits<acl_sjson::sample_type::qvv> : acl_transform_track_traits
+	{
+		using track_type = acl::track_qvvf;
+	};
+
+	//////////////////////////////////////////////////////////////////////////
+	// Calls the functor with the acl_sjson::sample_traits instance that matches the provided ACL track type.
+	// See acl_sjson::visit_sample_type(..) for details.
+	template<typename functor_type>
+	inline auto visit_track_type(acl::track_type8 type, functor_type&& functor) -> decltype(functor(acl_sjson::sample_traits<acl_sjson::sample_type::unknown>()))
+	{
+		switch (type)
+		{
+		case acl::track_type8::float1f:		return functor(acl_sjson::sample_traits<acl_sjson::sample_type::float1>());
+		case acl::track_type8::float2f:		return functor(acl_sjson::sample_traits<acl_sjson::sample_type::float2>());
+		case acl::track_type8::float3f:		return functor(acl_sjson::sample_traits<acl_sjson::sample_type::float3>());
+		case acl::track_type8::float4f:		return functor(acl_sjson::sample_traits<acl_sjson::sample_type::float4>());
+		case acl::track_type8::vector4f:	return functor(acl_sjson::sample_traits<acl_sjson::sample_type::vector4>());
+		case acl::track_type8::qvvf:		return functor(acl_sjson::sample_traits<acl_sjson::sample_type::qvv>());
+		default:							return functor(acl_sjson::sample_traits<acl_sjson::sample_type::unknown>());
+		}
+	}
+}
@@ -23,20 +23,27 @@
 ////////////////////////////////////////////////////////////////////////////////
 
 #include "acl-sjson/api_v20.h"
+#include "acl_track_traits.h"
+#include "pose_writer.h"
+#include "tracking_allocator.h"
 
 #include <acl-sjson/io.h>
+#include <acl-sjson/memory_tracker.h>
+#include <acl-sjson/parallel.h>
 #include <acl-sjson/sample.h>
+#include <acl-sjson/sample_range.h>
+#include <acl-sjson/sample_traits.h>
 #include <acl-sjson/track.h>
 #include <acl-sjson/track_array.h>
 
 #include <sjson/parser.h>
 
-#include <acl/compression/convert.h>
-#include <acl/core/ansi_allocator.h>
 #include <acl/core/compressed_tracks.h>
+#include <acl/decompression/decompress.h>
 #include <acl/io/clip_reader.h>
 
 #include <cstdio>
+#include <vector>
 
 namespace
 {
@@ -104,27 +111,6 @@ namespace
 		return success;
 	}
 
-	static acl_sjson::sample_type get_sample_type(acl::track_type8 type)
-	{
-		switch (type)
-		{
-		default:
-			return acl_sjson::sample_type::unknown;
-		case acl::track_type8::float1f:
-			return acl_sjson::sample_type::float1;
-		case acl::track_type8::float2f:
-			return acl_sjson::sample_type::float2;
-		case acl::track_type8::float3f:
-			return acl_sjson::sample_type::float3;
-		case acl::track_type8::float4f:
-			return acl_sjson::sample_type::float4;
-		case acl::track_type8::vector4f:
-			return acl_sjson::sample_type::vector4;
-		case acl::track_type8::qvvf:
-			return acl_sjson::sample_type::qvv;
-		}
-	}
-
 	static acl_sjson::scalar_track_description get_description(const acl::track_desc_scalarf& desc)
 	{
 		acl_sjson::scalar_track_description out_desc;
@@ -136,6 +122,10 @@ namespace
 	static acl_sjson::transform_track_description get_description(const acl::track_desc_transformf& desc)
 	{
 		acl_sjson::transform_track_description out_desc;
+
+		// Default sub-tracks do not exist in 2.0, they are always the identity
+		const rtm::qvvf default_value = rtm::qvv_identity();
+		std::memcpy(&out_desc.default_value, &default_value, sizeof(rtm::qvvf));
 		out_desc.output_index = desc.output_index;
 		out_desc.parent_index = desc.parent_index;
 		out_desc.precision = desc.precision;
@@ -146,58 +136,156 @@ namespace
 		return out_desc;
 	}
 
-	static acl_sjson::track_description get_description(const acl::track& track)
+	template<acl_sjson::sample_type type>
+	static acl_sjson::track convert_track(const acl::track& input_track)
 	{
-		acl_sjson::track_description desc;
+		using traits = acl_sjson::sample_traits<type>;
+		using acl_traits = acl_sjson_v20::acl_track_traits<type>;
+		using track_type = typename acl_traits::track_type;
+
+		const track_type& typed_track = acl::track_cast<track_type>(input_track);
+
+		acl_sjson::track out_track(type, typed_track.get_sample_rate(), typed_track.get_name().c_str());
+		acl_traits::get_description(out_track.get_description()) = get_description(typed_track.get_description());
 
-		switch (track.get_type())
+		const uint32_t num_samples = typed_track.get_num_samples();
+		out_track.reserve(num_samples);
+
+		for (uint32_t sample_index = 0; sample_index < num_samples; ++sample_index)
 		{
-		case acl::track_type8::float1f:
-		case acl::track_type8::float2f:
-		case acl::track_type8::float3f:
-		case acl::track_type8::float4f:
-		case acl::track_type8::vector4f:
-		default:
-			desc.scalar = get_description(track.get_description<acl::track_desc_scalarf>());
-			break;
-		case acl::track_type8::qvvf:
-			desc.transform = get_description(track.get_description<acl::track_desc_transformf>());
-			break;
+			acl_sjson::sample smpl;
+			std::memcpy(&smpl, &typed_track[sample_index], traits::k_size);
+
+			out_track.emplace_back(std::move(smpl));
 		}
 
-		return desc;
+		return out_track;
 	}
 
+	struct convert_track_functor
+	{
+		const acl::track& input_track;
+
+		template<typename traits_type>
+		acl_sjson::track operator()(traits_type) const
+		{
+			return convert_track<traits_type::k_type>(input_track);
+		}
+
+		acl_sjson::track operator()(acl_sjson::sample_traits<acl_sjson::sample_type::unknown>) const
+		{
+			return acl_sjson::track(acl_sjson::sample_type::unknown, input_track.get_sample_rate(), input_track.get_name().c_str());
+		}
+	};
+
 	static acl_sjson::track_array convert_tracks(const acl::track_array& input_tracks, const acl_sjson::metadata_t& metadata)
 	{
 		acl_sjson::track_array out_tracks(input_tracks.get_name().c_str(), metadata);
 
-		for (const acl::track& track_ : input_tracks)
+		const uint32_t num_tracks = input_tracks.get_num_tracks();
+
+		// Tracks are converted in parallel into their own slot and added in order once done
+		std::vector<acl_sjson::track> tracks;
+		tracks.reserve(num_tracks);
+		for (uint32_t track_index = 0; track_index < num_tracks; ++track_index)
+			tracks.emplace_back(acl_sjson::sample_type::unknown, 0.0F, "");
+
+		const size_t work_per_track = input_tracks.get_num_samples_per_track() * sizeof(acl_sjson::sample);
+		acl_sjson::parallel_for(num_tracks, work_per_track, [&](size_t track_index)
+			{
+				const acl::track& track_ = input_tracks[static_cast<uint32_t>(track_index)];
+				tracks[track_index] = acl_sjson_v20::visit_track_type(track_.get_type(), convert_track_functor{ track_ });
+			});
+
+		for (acl_sjson::track& track_ : tracks)
+			out_tracks.emplace_back(std::move(track_));
+
+		return out_tracks;
+	}
+
+	// A time range to extract, in seconds
+	struct time_range
+	{
+		float start_time;
+		float end_time;
+	};
+
+	// Creates an empty track from the compressed track metadata
+	struct make_track_functor
+	{
+		const acl::compressed_tracks& tracks;
+		uint32_t track_index;
+
+		template<typename traits_type>
+		acl_sjson::track operator()(traits_type) const
 		{
-			const acl_sjson::sample_type type = get_sample_type(track_.get_type());
-			const float sample_rate = track_.get_sample_rate();
-			const char* name = track_.get_name().c_str();
+			using acl_traits = acl_sjson_v20::acl_track_traits<traits_type::k_type>;
+			using desc_type = typename acl_traits::track_type::desc_type;
 
-			acl_sjson::track out_track(type, sample_rate, name);
-			out_track.get_description() = get_description(track_);
+			const char* name = tracks.get_track_name(track_index);
+			acl_sjson::track out_track(traits_type::k_type, tracks.get_sample_rate(), name != nullptr ? name : "");
 
-			const uint32_t num_samples = track_.get_num_samples();
-			const uint32_t sample_size = track_.get_sample_size();
+			// Without metadata, the description retains its default values
+			desc_type desc;
+			tracks.get_track_description(track_index, desc);
 
-			for (uint32_t sample_index = 0; sample_index < num_samples; ++sample_index)
-			{
-				const void* sample_ptr = track_[sample_index];
+			// Compressed tracks are stored in output order
+			desc.output_index = track_index;
+
+			acl_traits::get_description(out_track.get_description()) = get_description(desc);
+			return out_track;
+		}
 
-				acl_sjson::sample smpl;
-				std::memcpy(&smpl, sample_ptr, sample_size);
+		acl_sjson::track operator()(acl_sjson::sample_traits<acl_sjson::sample_type::unknown>) const
+		{
+			return acl_sjson::track(acl_sjson::sample_type::unknown, tracks.get_sample_rate(), "");
+		}
+	};
 
-				out_track.emplace_back(std::move(smpl));
-			}
+	// Decompresses every pose within the range, samples are staged one pose at a time
+	// by our track writer and appended to their track
+	template<class decompression_settings_type>
+	static bool decompress_range(const acl::compressed_tracks& tracks, const acl_sjson::sample_range& range, acl_sjson::track_array& out_tracks)
+	{
+		acl::decompression_context<decompression_settings_type> context;
+		if (!context.initialize(tracks))
+		{
+			printf("Failed to initialize the decompression context\n");
+			return false;
+		}
 
-			out_tracks.emplace_back(std::move(out_track));
+		const uint32_t num_tracks = tracks.get_num_tracks();
+		const float sample_rate = tracks.get_sample_rate();
+
+		std::vector<acl_sjson::track> output_tracks;
+		output_tracks.reserve(num_tracks);
+		for (uint32_t track_index = 0; track_index < num_tracks; ++track_index)
+		{
+			output_tracks.push_back(acl_sjson_v20::visit_track_type(tracks.get_track_type(), make_track_functor{ tracks, track_index }));
+			output_tracks.back().reserve(range.num_samples);
 		}
 
-		return out_tracks;
+		std::vector<acl_sjson::sample> pose(num_tracks);
+		acl_sjson_v20::pose_writer writer(pose);
+
+		// Only the poses within the range are decompressed, each one lands exactly on a sample
+		for (size_t sample_offset = 0; sample_offset < range.num_samples; ++sample_offset)
+		{
+			const float sample_time = float(range.first_sample_index + sample_offset) / sample_rate;
+			context.seek(sample_time, acl::sample_rounding_policy::nearest);
+			context.decompress_tracks(writer);
+
+			for (uint32_t track_index = 0; track_index < num_tracks; ++track_index)
+			{
+				acl_sjson::sample smpl = pose[track_index];
+				output_tracks[track_index].emplace_back(std::move(smpl));
+			}
+		}
+
+		for (acl_sjson::track& track_ : output_tracks)
+			out_tracks.emplace_back(std::move(track_));
+
+		return true;
 	}
 
 	static acl_sjson::acl_version get_version(acl::compressed_tracks_version16 version)
@@ -238,13 +326,12 @@ namespace
 			return acl_sjson::vector_format_t::unknown;
 		}
 	}
-}
 
-namespace acl_sjson_v20
-{
-	bool read_tracks(const char* filename, acl_sjson::track_array& out_tracks)
+	static bool read_tracks_impl(const char* filename, const time_range* range, acl_sjson::track_array& out_tracks)
 	{
-		acl::ansi_allocator allocator;
+		acl_sjson::scoped_memory_phase read_phase(acl_sjson::memory_phase::read);
+
+		acl_sjson_v20::tracking_allocator allocator;
 
 		acl::track_array input_tracks;
 
@@ -259,11 +346,12 @@ namespace acl_sjson_v20
 			if (!read_acl_bin_file(filename, tracks))
 				return false;
 
-			// Convert the compressed data into a raw track array
-			const acl::error_result result = acl::convert_track_list(allocator, *tracks, input_tracks);
-			if (result.any())
+			acl_sjson::sample_range samples;
+			samples.num_samples = tracks->get_num_samples_per_track();
+
+			if (range != nullptr && !acl_sjson::get_sample_range(tracks->get_sample_rate(), tracks->get_num_samples_per_track(), range->start_time, range->end_time, samples))
 			{
-				printf("Failed to convert input binary track list: %s\n", result.c_str());
+				printf("No samples within the requested time range\n");
 				acl_sjson::free_file_memory(reinterpret_cast<char*>(tracks));
 				return false;
 			}
@@ -299,8 +387,21 @@ namespace acl_sjson_v20
 				}
 			}
 
+			// Decompress straight into our tracks without an intermediate raw track array
+			// With a time range, only the poses we need are decompressed instead of the whole clip
+			out_tracks = acl_sjson::track_array(metadata.name.c_str(), metadata);
+
+			bool success;
+			{
+				acl_sjson::scoped_memory_phase convert_phase(acl_sjson::memory_phase::convert);
+				success = tracks->get_track_type() == acl::track_type8::qvvf ?
+					decompress_range<acl::debug_transform_decompression_settings>(*tracks, samples, out_tracks) :
+					decompress_range<acl::debug_scalar_decompression_settings>(*tracks, samples, out_tracks);
+			}
+
 			// Release the compressed data, no longer needed
 			acl_sjson::free_file_memory(reinterpret_cast<char*>(tracks));
+			return success;
 		}
 		else if (acl_sjson::is_acl_sjson_file(filename))
 		{
@@ -361,8 +462,31 @@ namespace acl_sjson_v20
 			return false;
 		}
 
-		out_tracks = convert_tracks(input_tracks, metadata);
+		{
+			acl_sjson::scoped_memory_phase convert_phase(acl_sjson::memory_phase::convert);
+			out_tracks = convert_tracks(input_tracks, metadata);
+		}
+
+		if (range != nullptr && !acl_sjson::extract_range(out_tracks, range->start_time, range->end_time))
+		{
+			printf("No samples within the requested time range\n");
+			return false;
+		}
 
 		return true;
 	}
 }
+
+namespace acl_sjson_v20
+{
+	bool read_tracks(const char* filename, acl_sjson::track_array& out_tracks)
+	{
+		return read_tracks_impl(filename, nullptr, out_tracks);
+	}
+
+	bool read_tracks(const char* filename, float start_time, float end_time, acl_sjson::track_array& out_tracks)
+	{
+		const time_range range = { start_time, end_time };
+		return read_tracks_impl(filename, &range, out_tracks);
+	}
+}
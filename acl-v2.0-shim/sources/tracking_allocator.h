@@ -0,0 +1,95 @@
+#pragma once
+
+////////////////////////////////////////////////////////////////////////////////
+// The MIT License (MIT)
+//
+// Copyright (c) 2022 Nicholas Frechette
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+////////////////////////////////////////////////////////////////////////////////
+
+#include <acl-sjson/memory_tracker.h>
+
+#include <acl/core/ansi_allocator.h>
+#include <acl/core/iallocator.h>
+
+#include <algorithm>
+#include <cstdint>
+
+namespace acl_sjson_v20
+{
+	//////////////////////////////////////////////////////////////////////////
+	// An allocator that records every allocation with the memory tracker.
+	// A small header precedes every allocation to retain the phase it is attributed to.
+	class tracking_allocator final : public acl::iallocator
+	{
+	public:
+		tracking_allocator() = default;
+
+		tracking_allocator(const tracking_allocator&) = delete;
+		tracking_allocator& operator=(const tracking_allocator&) = delete;
+
+		virtual void* allocate(size_t size, size_t alignment = k_default_alignment) override
+		{
+			// The header size is a multiple of the alignment to keep the allocation aligned
+			const size_t header_size = std::max<size_t>(alignment, sizeof(allocation_header));
+
+			uint8_t* buffer = static_cast<uint8_t*>(m_allocator.allocate(size + header_size, alignment));
+			if (buffer == nullptr)
+				return nullptr;
+
+			uint8_t* ptr = buffer + header_size;
+
+			allocation_header* header = reinterpret_cast<allocation_header*>(ptr - sizeof(allocation_header));
+			header->size = size;
+			header->header_size = static_cast<uint32_t>(header_size);
+			header->phase = acl_sjson::track_allocation(size);
+
+			return ptr;
+		}
+
+		virtual void deallocate(void* ptr, size_t size) override
+		{
+			if (ptr == nullptr)
+				return;
+
+			uint8_t* ptr_u8 = static_cast<uint8_t*>(ptr);
+			const allocation_header* header = reinterpret_cast<const allocation_header*>(ptr_u8 - sizeof(allocation_header));
+			ACL_ASSERT(header->size == size, "Unexpected allocation size");
+			(void)size;
+
+			// Use the recorded size, it is what was allocated
+			const size_t allocation_size = static_cast<size_t>(header->size);
+			const size_t header_size = header->header_size;
+			acl_sjson::track_deallocation(header->phase, allocation_size);
+
+			m_allocator.deallocate(ptr_u8 - header_size, allocation_size + header_size);
+		}
+
+	private:
+		struct allocation_header
+		{
+			uint64_t size;
+			uint32_t header_size;
+			acl_sjson::memory_phase phase;
+		};
+
+		acl::ansi_allocator m_allocator;
+	};
+}
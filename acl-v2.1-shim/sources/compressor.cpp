@@ -0,0 +1,513 @@
+////////////////////////////////////////////////////////////////////////////////
+// The MIT License (MIT)
+//
+// Copyright (c) 2022 Nicholas Frechette
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+////////////////////////////////////////////////////////////////////////////////
+
+#include "acl-sjson/api_v21.h"
+#include "file_database_streamer.h"
+#include "pose_writer.h"
+#include "track_conversion.h"
+#include "tracking_allocator.h"
+
+#include <acl-sjson/compression_settings.h>
+#include <acl-sjson/memory_tracker.h>
+#include <acl-sjson/parallel.h>
+#include <acl-sjson/sample.h>
+#include <acl-sjson/track_array.h>
+
+#include <acl/compression/compress.h>
+#include <acl/compression/track_array.h>
+#include <acl/compression/track_error.h>
+#include <acl/compression/transform_error_metrics.h>
+#include <acl/core/compressed_database.h>
+#include <acl/core/compressed_tracks.h>
+#include <acl/decompression/database/database.h>
+#include <acl/decompression/decompress.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace
+{
+	using clock_type = std::chrono::high_resolution_clock;
+
+	static double get_elapsed_ms(clock_type::time_point start_time)
+	{
+		return std::chrono::duration<double, std::milli>(clock_type::now() - start_time).count();
+	}
+
+	static acl::compression_level8 get_compression_level(acl_sjson::compression_level_t level)
+	{
+		switch (level)
+		{
+		case acl_sjson::compression_level_t::lowest:
+			return acl::compression_level8::lowest;
+		case acl_sjson::compression_level_t::low:
+			return acl::compression_level8::low;
+		case acl_sjson::compression_level_t::medium:
+		default:
+			return acl::compression_level8::medium;
+		case acl_sjson::compression_level_t::high:
+			return acl::compression_level8::high;
+		case acl_sjson::compression_level_t::highest:
+			return acl::compression_level8::highest;
+		case acl_sjson::compression_level_t::automatic:
+			return acl::compression_level8::automatic;
+		}
+	}
+
+	static acl::rotation_format8 get_rotation_format(acl_sjson::rotation_format_t format)
+	{
+		switch (format)
+		{
+		case acl_sjson::rotation_format_t::quatf_full:
+			return acl::rotation_format8::quatf_full;
+		case acl_sjson::rotation_format_t::quatf_drop_w_full:
+			return acl::rotation_format8::quatf_drop_w_full;
+		case acl_sjson::rotation_format_t::quatf_drop_w_variable:
+		default:
+			return acl::rotation_format8::quatf_drop_w_variable;
+		}
+	}
+
+	static acl::vector_format8 get_vector_format(acl_sjson::vector_format_t format)
+	{
+		switch (format)
+		{
+		case acl_sjson::vector_format_t::vector3f_full:
+			return acl::vector_format8::vector3f_full;
+		case acl_sjson::vector_format_t::vector3f_variable:
+		default:
+			return acl::vector_format8::vector3f_variable;
+		}
+	}
+
+	static acl::compression_settings get_compression_settings(const acl_sjson::compression_settings_t& settings, acl::qvvf_transform_error_metric& qvv_error_metric, acl::qvvf_matrix3x4f_transform_error_metric& matrix_error_metric)
+	{
+		acl::compression_settings compression_settings = acl::get_default_compression_settings();
+		compression_settings.level = get_compression_level(settings.level);
+		compression_settings.rotation_format = get_rotation_format(settings.rotation_format);
+		compression_settings.translation_format = get_vector_format(settings.translation_format);
+		compression_settings.scale_format = get_vector_format(settings.scale_format);
+		compression_settings.enable_database_support = settings.enable_database;
+
+		if (settings.error_metric == acl_sjson::error_metric_t::matrix3x4)
+			compression_settings.error_metric = &matrix_error_metric;
+		else
+			compression_settings.error_metric = &qvv_error_metric;
+
+		return compression_settings;
+	}
+
+	static acl::compression_database_settings get_database_settings(const acl_sjson::database_settings_t& settings)
+	{
+		acl::compression_database_settings database_settings;
+		database_settings.medium_importance_tier_proportion = settings.medium_importance_tier_proportion;
+		database_settings.low_importance_tier_proportion = settings.low_importance_tier_proportion;
+		database_settings.max_chunk_size = settings.max_chunk_size;
+		return database_settings;
+	}
+
+	// Only transform tracks can be streamed from a database
+	struct database_decompression_settings final : public acl::debug_transform_decompression_settings
+	{
+		using database_settings_type = acl::debug_database_settings;
+	};
+
+	using database_context = acl::database_context<acl::debug_database_settings>;
+
+	static bool stream_in(database_context& context, acl::quality_tier tier)
+	{
+		// Our streamers complete synchronously, once dispatched the request is done
+		const acl::database_stream_request_result result = context.stream_in(tier);
+		if (result == acl::database_stream_request_result::done || result == acl::database_stream_request_result::dispatched)
+			return true;
+
+		printf("Failed to stream in the database\n");
+		return false;
+	}
+
+	static bool stream_out(database_context& context, acl::quality_tier tier)
+	{
+		const acl::database_stream_request_result result = context.stream_out(tier);
+		if (result == acl::database_stream_request_result::done || result == acl::database_stream_request_result::dispatched)
+			return true;
+
+		printf("Failed to stream out the database\n");
+		return false;
+	}
+
+	static bool write_file(const std::string& filename, const void* buffer, size_t buffer_size)
+	{
+		std::ofstream output_file_stream(filename.c_str(), std::ios_base::out | std::ios_base::binary | std::ios_base::trunc);
+		if (!output_file_stream.is_open() || !output_file_stream.good())
+		{
+			printf("Failed to open output file for writing: %s\n", filename.c_str());
+			return false;
+		}
+
+		output_file_stream.write(static_cast<const char*>(buffer), buffer_size);
+		output_file_stream.close();
+
+		if (!output_file_stream.good())
+		{
+			printf("Failed to write output file: %s\n", filename.c_str());
+			return false;
+		}
+
+		return true;
+	}
+
+	// The error metric runs inside ACL with the SIMD width ACL was built for, the runtime kernels don't apply
+	static acl::track_error calculate_error(acl::iallocator& allocator, const acl::track_array& raw_tracks, acl::decompression_context<acl::debug_transform_decompression_settings>& context, const acl::itransform_error_metric& error_metric)
+	{
+		return acl::calculate_compression_error(allocator, acl::track_array_cast<acl::track_array_qvvf>(raw_tracks), context, error_metric);
+	}
+
+	static acl::track_error calculate_error(acl::iallocator& allocator, const acl::track_array& raw_tracks, acl::decompression_context<acl::debug_scalar_decompression_settings>& context, const acl::itransform_error_metric& error_metric)
+	{
+		(void)error_metric;
+		return acl::calculate_compression_error(allocator, raw_tracks, context);
+	}
+
+	static acl::track_error calculate_error(acl::iallocator& allocator, const acl::track_array& raw_tracks, acl::decompression_context<database_decompression_settings>& context, const acl::itransform_error_metric& error_metric)
+	{
+		return acl::calculate_compression_error(allocator, acl::track_array_cast<acl::track_array_qvvf>(raw_tracks), context, error_metric);
+	}
+
+	// The debug settings support every format, the timings are comparable between configs but not with a runtime build
+	template<class decompression_settings_type>
+	static bool measure_decompression(acl::iallocator& allocator, const acl::track_array& raw_tracks, const acl::compressed_tracks& tracks, acl::decompression_context<decompression_settings_type>& context, const acl::itransform_error_metric& error_metric, acl_sjson::compression_stats_t& out_stats)
+	{
+		std::vector<acl_sjson::sample> pose(tracks.get_num_tracks());
+		acl_sjson_v21::pose_writer writer(pose);
+
+		const uint32_t num_samples = tracks.get_num_samples_per_track();
+		const float sample_rate = tracks.get_sample_rate();
+
+		const clock_type::time_point decompression_start_time = clock_type::now();
+		for (uint32_t sample_index = 0; sample_index < num_samples; ++sample_index)
+		{
+			const float sample_time = float(sample_index) / sample_rate;
+			context.seek(sample_time, acl::sample_rounding_policy::nearest);
+			context.decompress_tracks(writer);
+		}
+		out_stats.decompression_time_ms = get_elapsed_ms(decompression_start_time);
+
+		const acl::track_error error = calculate_error(allocator, raw_tracks, context, error_metric);
+		out_stats.max_error = error.error;
+		out_stats.max_error_track_index = error.index;
+		out_stats.max_error_sample_time = error.sample_time;
+		return true;
+	}
+
+	template<class decompression_settings_type>
+	static bool measure_decompression(acl::iallocator& allocator, const acl::track_array& raw_tracks, const acl::compressed_tracks& tracks, const acl::itransform_error_metric& error_metric, acl_sjson::compression_stats_t& out_stats)
+	{
+		acl::decompression_context<decompression_settings_type> context;
+		if (!context.initialize(tracks))
+		{
+			printf("Failed to initialize the decompression context\n");
+			return false;
+		}
+
+		return measure_decompression(allocator, raw_tracks, tracks, context, error_metric, out_stats);
+	}
+
+	// A database with a single clip where every tier is streamed in measures the runtime decompression path
+	static bool measure_database_decompression(acl::iallocator& allocator, const acl::track_array& raw_tracks, const acl::compressed_tracks& tracks, const acl_sjson::database_settings_t& settings, const acl::itransform_error_metric& error_metric, acl_sjson::compression_stats_t& out_stats)
+	{
+		const acl::compressed_tracks* input_tracks = &tracks;
+		acl::compressed_tracks* database_tracks = nullptr;
+		acl::compressed_database* database = nullptr;
+
+		const acl::error_result result = acl::build_database(allocator, get_database_settings(settings), &input_tracks, 1, &database_tracks, database);
+		if (result.any())
+		{
+			printf("Failed to build the database: %s\n", result.c_str());
+			return false;
+		}
+
+		bool success = false;
+		{
+			database_context db_context;
+			acl::decompression_context<database_decompression_settings> context;
+
+			if (!db_context.initialize(allocator, *database))
+				printf("Failed to initialize the database context\n");
+			else if (stream_in(db_context, acl::quality_tier::medium_importance) && stream_in(db_context, acl::quality_tier::lowest_importance))
+			{
+				if (context.initialize(*database_tracks, db_context))
+					success = measure_decompression(allocator, raw_tracks, *database_tracks, context, error_metric, out_stats);
+				else
+					printf("Failed to initialize the decompression context\n");
+			}
+		}
+
+		// The bulk data is inline, the database size includes every tier
+		out_stats.compressed_size = database_tracks->get_size() + database->get_size();
+
+		allocator.deallocate(database_tracks, database_tracks->get_size());
+		allocator.deallocate(database, database->get_size());
+		return success;
+	}
+
+	// Measures the max error of every clip bound to a database with the tiers currently streamed in
+	static bool measure_database_error(acl::iallocator& allocator, const std::vector<acl::track_array>& raw_tracks, const std::vector<acl::compressed_tracks*>& database_tracks, const database_context& db_context, const acl::itransform_error_metric& error_metric, float& out_max_error)
+	{
+		float max_error = 0.0F;
+		for (size_t clip_index = 0; clip_index < database_tracks.size(); ++clip_index)
+		{
+			acl::decompression_context<database_decompression_settings> context;
+			if (!context.initialize(*database_tracks[clip_index], db_context))
+			{
+				printf("Failed to initialize the decompression context\n");
+				return false;
+			}
+
+			const acl::track_error error = calculate_error(allocator, raw_tracks[clip_index], context, error_metric);
+			max_error = std::max(max_error, error.error);
+		}
+
+		out_max_error = max_error;
+		return true;
+	}
+}
+
+namespace acl_sjson_v21
+{
+	bool compress_tracks(const acl_sjson::track_array& tracks, const acl_sjson::compression_settings_t& settings, acl_sjson::compression_stats_t& out_stats)
+	{
+		if (settings.enable_database && tracks.get_type() != acl_sjson::sample_type::qvv)
+		{
+			printf("Only transform tracks can be compressed with a database: %s\n", settings.name.c_str());
+			return false;
+		}
+
+		acl_sjson::scoped_memory_phase compress_phase(acl_sjson::memory_phase::compress);
+
+		acl_sjson_v21::tracking_allocator allocator;
+
+		acl::track_array raw_tracks;
+		{
+			acl_sjson::scoped_memory_phase convert_phase(acl_sjson::memory_phase::convert);
+			raw_tracks = convert_tracks(allocator, tracks);
+		}
+
+		acl::qvvf_transform_error_metric qvv_error_metric;
+		acl::qvvf_matrix3x4f_transform_error_metric matrix_error_metric;
+
+		const acl::compression_settings compression_settings = get_compression_settings(settings, qvv_error_metric, matrix_error_metric);
+
+		acl_sjson::compression_stats_t stats;
+
+		acl::compressed_tracks* compressed_tracks = nullptr;
+		acl::output_stats compression_stats;
+
+		const clock_type::time_point compression_start_time = clock_type::now();
+		const acl::error_result result = acl::compress_track_list(allocator, raw_tracks, compression_settings, compressed_tracks, compression_stats);
+		stats.compression_time_ms = get_elapsed_ms(compression_start_time);
+
+		if (result.any())
+		{
+			printf("Failed to compress tracks: %s\n", result.c_str());
+			return false;
+		}
+
+		stats.compressed_size = compressed_tracks->get_size();
+
+		bool is_measured;
+		if (settings.enable_database)
+			is_measured = measure_database_decompression(allocator, raw_tracks, *compressed_tracks, settings.database, *compression_settings.error_metric, stats);
+		else if (compressed_tracks->get_track_type() == acl::track_type8::qvvf)
+			is_measured = measure_decompression<acl::debug_transform_decompression_settings>(allocator, raw_tracks, *compressed_tracks, *compression_settings.error_metric, stats);
+		else
+			is_measured = measure_decompression<acl::debug_scalar_decompression_settings>(allocator, raw_tracks, *compressed_tracks, *compression_settings.error_metric, stats);
+
+		allocator.deallocate(compressed_tracks, compressed_tracks->get_size());
+
+		if (!is_measured)
+			return false;
+
+		out_stats = stats;
+		return true;
+	}
+
+	bool write_database(const acl_sjson::track_array* const* clips, const char* const* clip_filenames, size_t num_clips, const acl_sjson::compression_settings_t& settings, const char* database_filename, acl_sjson::database_stats_t& out_stats)
+	{
+		for (size_t clip_index = 0; clip_index < num_clips; ++clip_index)
+		{
+			if (clips[clip_index]->get_type() != acl_sjson::sample_type::qvv)
+			{
+				printf("Only transform tracks can be compressed with a database: %s\n", clip_filenames[clip_index]);
+				return false;
+			}
+		}
+
+		acl_sjson::scoped_memory_phase compress_phase(acl_sjson::memory_phase::compress);
+
+		acl_sjson_v21::tracking_allocator allocator;
+
+		acl::qvvf_transform_error_metric qvv_error_metric;
+		acl::qvvf_matrix3x4f_transform_error_metric matrix_error_metric;
+
+		acl_sjson::compression_settings_t clip_settings = settings;
+		clip_settings.enable_database = true;
+
+		const acl::compression_settings compression_settings = get_compression_settings(clip_settings, qvv_error_metric, matrix_error_metric);
+
+		// Raw tracks are retained to measure the error of each tier once the database is built
+		std::vector<acl::track_array> raw_tracks(num_clips);
+		std::vector<acl::compressed_tracks*> compressed_clips(num_clips, nullptr);
+
+		const clock_type::time_point compression_start_time = clock_type::now();
+
+		// Clips are compressed independently, they are only bound together when the database is built
+		const size_t work_per_clip = 1024 * 1024;
+		acl_sjson::parallel_for(num_clips, work_per_clip, [&](size_t clip_index)
+			{
+				{
+					acl_sjson::scoped_memory_phase convert_phase(acl_sjson::memory_phase::convert);
+					raw_tracks[clip_index] = convert_tracks(allocator, *clips[clip_index]);
+				}
+
+				acl::output_stats compression_stats;
+				const acl::error_result result = acl::compress_track_list(allocator, raw_tracks[clip_index], compression_settings, compressed_clips[clip_index], compression_stats);
+				if (result.any())
+				{
+					printf("Failed to compress tracks: %s: %s\n", clip_filenames[clip_index], result.c_str());
+					compressed_clips[clip_index] = nullptr;
+				}
+			});
+
+		std::vector<acl::compressed_tracks*> database_tracks(num_clips, nullptr);
+		acl::compressed_database* database = nullptr;
+
+		bool success = std::find(compressed_clips.begin(), compressed_clips.end(), nullptr) == compressed_clips.end();
+		if (success)
+		{
+			const acl::error_result result = acl::build_database(allocator, get_database_settings(settings.database), compressed_clips.data(), static_cast<uint32_t>(num_clips), database_tracks.data(), database);
+			if (result.any())
+			{
+				printf("Failed to build the database: %s\n", result.c_str());
+				success = false;
+			}
+		}
+
+		acl_sjson::database_stats_t stats;
+		stats.compression_time_ms = get_elapsed_ms(compression_start_time);
+		stats.num_clips = num_clips;
+
+		// Clips bound to the database are copies, the originals are no longer needed
+		for (acl::compressed_tracks* compressed_clip : compressed_clips)
+		{
+			if (compressed_clip != nullptr)
+				allocator.deallocate(compressed_clip, compressed_clip->get_size());
+		}
+
+		if (!success)
+			return false;
+
+		// The medium and low importance tiers are split from the database to be streamed from their own file
+		acl::compressed_database* split_database = nullptr;
+		uint8_t* medium_bulk_data = nullptr;
+		uint8_t* low_bulk_data = nullptr;
+
+		const uint32_t medium_tier_size = database->get_bulk_data_size(acl::quality_tier::medium_importance);
+		const uint32_t low_tier_size = database->get_bulk_data_size(acl::quality_tier::lowest_importance);
+
+		const acl::error_result split_result = acl::split_database_bulk_data(allocator, *database, split_database, medium_bulk_data, low_bulk_data);
+		allocator.deallocate(database, database->get_size());
+
+		if (split_result.any())
+		{
+			printf("Failed to split the database bulk data: %s\n", split_result.c_str());
+			success = false;
+		}
+
+		const std::string medium_tier_filename = std::string(database_filename) + ".medium";
+		const std::string low_tier_filename = std::string(database_filename) + ".low";
+
+		if (success)
+		{
+			acl_sjson::scoped_memory_phase write_phase(acl_sjson::memory_phase::write);
+
+			for (size_t clip_index = 0; clip_index < num_clips && success; ++clip_index)
+			{
+				success = write_file(clip_filenames[clip_index], database_tracks[clip_index], database_tracks[clip_index]->get_size());
+				stats.clips_size += database_tracks[clip_index]->get_size();
+			}
+
+			success = success && write_file(database_filename, split_database, split_database->get_size());
+			success = success && write_file(medium_tier_filename, medium_bulk_data, medium_tier_size);
+			success = success && write_file(low_tier_filename, low_bulk_data, low_tier_size);
+
+			stats.database_size = split_database->get_size();
+			stats.medium_tier_size = medium_tier_size;
+			stats.low_tier_size = low_tier_size;
+		}
+
+		if (success)
+		{
+			// Tiers are streamed back from the files that were written, least important tiers are streamed out first
+			const acl::itransform_error_metric& error_metric = *compression_settings.error_metric;
+
+			file_database_streamer medium_streamer(allocator, medium_tier_filename.c_str(), medium_tier_size);
+			file_database_streamer low_streamer(allocator, low_tier_filename.c_str(), low_tier_size);
+
+			database_context db_context;
+			if (!db_context.initialize(allocator, *split_database, medium_streamer, low_streamer))
+			{
+				printf("Failed to initialize the database context\n");
+				success = false;
+			}
+
+			success = success && stream_in(db_context, acl::quality_tier::medium_importance) && stream_in(db_context, acl::quality_tier::lowest_importance);
+			success = success && measure_database_error(allocator, raw_tracks, database_tracks, db_context, error_metric, stats.max_error_with_every_tier);
+
+			success = success && stream_out(db_context, acl::quality_tier::lowest_importance);
+			success = success && measure_database_error(allocator, raw_tracks, database_tracks, db_context, error_metric, stats.max_error_without_low_tier);
+
+			success = success && stream_out(db_context, acl::quality_tier::medium_importance);
+			success = success && measure_database_error(allocator, raw_tracks, database_tracks, db_context, error_metric, stats.max_error_with_high_tier_only);
+		}
+
+		for (acl::compressed_tracks* database_clip : database_tracks)
+			allocator.deallocate(database_clip, database_clip->get_size());
+
+		if (split_database != nullptr)
+			allocator.deallocate(split_database, split_database->get_size());
+
+		allocator.deallocate(medium_bulk_data, medium_tier_size);
+		allocator.deallocate(low_bulk_data, low_tier_size);
+
+		if (!success)
+			return false;
+
+		out_stats = stats;
+		return true;
+	}
+}
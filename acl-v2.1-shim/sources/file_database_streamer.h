@@ -0,0 +1,104 @@
+#pragma once
+
+////////////////////////////////////////////////////////////////////////////////
+// The MIT License (MIT)
+//
+// Copyright (c) 2022 Nicholas Frechette
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+////////////////////////////////////////////////////////////////////////////////
+
+#include <acl/core/iallocator.h>
+#include <acl/decompression/database/idatabase_streamer.h>
+
+#include <cstdint>
+#include <cstdio>
+#include <functional>
+
+namespace acl_sjson_v21
+{
+	//////////////////////////////////////////////////////////////////////////
+	// Streams the bulk data of a database tier from a file on disk.
+	// Requests complete synchronously on the calling thread, which is enough to test
+	// and measure streaming locally. A runtime would dispatch them to its own IO system.
+	class file_database_streamer final : public acl::idatabase_streamer
+	{
+	public:
+		file_database_streamer(acl::iallocator& allocator, const char* filename, uint32_t bulk_data_size)
+			: m_allocator(allocator)
+			, m_file(nullptr)
+			, m_bulk_data(nullptr)
+			, m_bulk_data_size(bulk_data_size)
+		{
+			// Empty tiers have no file to stream from
+			if (bulk_data_size != 0)
+				m_file = std::fopen(filename, "rb");
+		}
+
+		~file_database_streamer()
+		{
+			if (m_bulk_data != nullptr)
+				m_allocator.deallocate(m_bulk_data, m_bulk_data_size);
+
+			if (m_file != nullptr)
+				std::fclose(m_file);
+		}
+
+		file_database_streamer(const file_database_streamer&) = delete;
+		file_database_streamer& operator=(const file_database_streamer&) = delete;
+
+		virtual bool is_initialized() const override { return m_file != nullptr || m_bulk_data_size == 0; }
+
+		virtual const uint8_t* get_bulk_data() const override { return m_bulk_data; }
+
+		virtual void stream_in(uint32_t offset, uint32_t size, bool can_allocate_bulk_data, const std::function<void(bool success)>& continuation) override
+		{
+			// The bulk data is allocated by the first request, chunks are then read in place
+			if (can_allocate_bulk_data && m_bulk_data == nullptr)
+				m_bulk_data = static_cast<uint8_t*>(m_allocator.allocate(m_bulk_data_size));
+
+			const bool is_in_range = uint64_t(offset) + uint64_t(size) <= uint64_t(m_bulk_data_size);
+			const bool success = m_file != nullptr && m_bulk_data != nullptr && is_in_range
+				&& std::fseek(m_file, static_cast<long>(offset), SEEK_SET) == 0
+				&& std::fread(m_bulk_data + offset, 1, size, m_file) == size;
+
+			continuation(success);
+		}
+
+		virtual void stream_out(uint32_t offset, uint32_t size, bool can_deallocate_bulk_data, const std::function<void(bool success)>& continuation) override
+		{
+			(void)offset;
+			(void)size;
+
+			if (can_deallocate_bulk_data && m_bulk_data != nullptr)
+			{
+				m_allocator.deallocate(m_bulk_data, m_bulk_data_size);
+				m_bulk_data = nullptr;
+			}
+
+			continuation(true);
+		}
+
+	private:
+		acl::iallocator&	m_allocator;
+		std::FILE*			m_file;
+		uint8_t*			m_bulk_data;
+		uint32_t			m_bulk_data_size;
+	};
+}
@@ -0,0 +1,56 @@
+#pragma once
+
+////////////////////////////////////////////////////////////////////////////////
+// The MIT License (MIT)
+//
+// Copyright (c) 2022 Nicholas Frechette
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+////////////////////////////////////////////////////////////////////////////////
+
+#include <acl-sjson/sample.h>
+
+#include <acl/core/track_writer.h>
+
+#include <rtm/types.h>
+
+#include <cstdint>
+#include <vector>
+
+namespace acl_sjson_v21
+{
+	//////////////////////////////////////////////////////////////////////////
+	// Writes decompressed samples into a pose buffer, one sample per track.
+	struct pose_writer final : public acl::track_writer
+	{
+		explicit pose_writer(std::vector<acl_sjson::sample>& pose_) : pose(pose_) {}
+
+		void RTM_SIMD_CALL write_float1(uint32_t track_index, rtm::scalarf_arg0 value) { rtm::scalar_store(value, &pose[track_index].f1.x); }
+		void RTM_SIMD_CALL write_float2(uint32_t track_index, rtm::vector4f_arg0 value) { rtm::vector_store2(value, &pose[track_index].f2.x); }
+		void RTM_SIMD_CALL write_float3(uint32_t track_index, rtm::vector4f_arg0 value) { rtm::vector_store3(value, &pose[track_index].f3.x); }
+		void RTM_SIMD_CALL write_float4(uint32_t track_index, rtm::vector4f_arg0 value) { rtm::vector_store(value, &pose[track_index].f4.x); }
+		void RTM_SIMD_CALL write_vector4(uint32_t track_index, rtm::vector4f_arg0 value) { rtm::vector_store(value, &pose[track_index].v4.x); }
+
+		void RTM_SIMD_CALL write_rotation(uint32_t track_index, rtm::quatf_arg0 rotation) { rtm::quat_store(rotation, &pose[track_index].transform.rotation.x); }
+		void RTM_SIMD_CALL write_translation(uint32_t track_index, rtm::vector4f_arg0 translation) { rtm::vector_store(translation, &pose[track_index].transform.translation.x); }
+		void RTM_SIMD_CALL write_scale(uint32_t track_index, rtm::vector4f_arg0 scale) { rtm::vector_store(scale, &pose[track_index].transform.scale.x); }
+
+		std::vector<acl_sjson::sample>& pose;
+	};
+}
@@ -23,17 +23,23 @@
 ////////////////////////////////////////////////////////////////////////////////
 
 #include "acl-sjson/api_v21.h"
+#include "acl_track_traits.h"
+#include "track_conversion.h"
+#include "tracking_allocator.h"
 
 #include <acl-sjson/io.h>
+#include <acl-sjson/memory_tracker.h>
+#include <acl-sjson/parallel.h>
 #include <acl-sjson/sample.h>
+#include <acl-sjson/sample_traits.h>
 #include <acl-sjson/track.h>
 #include <acl-sjson/track_array.h>
 
 #include <sjson/writer.h>
 
 #include <acl/compression/convert.h>
-#include <acl/core/ansi_allocator.h>
 #include <acl/core/compressed_tracks.h>
+#include <acl/core/memory_utils.h>
 #include <acl/io/clip_writer.h>
 
 #include <rtm/types.h>
@@ -42,29 +48,6 @@
 
 namespace
 {
-	static uint32_t get_sample_size(acl_sjson::sample_type type)
-	{
-		switch (type)
-		{
-		default:
-			return 0;
-		case acl_sjson::sample_type::float1:
-			return sizeof(float);
-		case acl_sjson::sample_type::float2:
-			return sizeof(rtm::float2f);
-		case acl_sjson::sample_type::float3:
-			return sizeof(rtm::float3f);
-		case acl_sjson::sample_type::float4:
-			return sizeof(rtm::float4f);
-		case acl_sjson::sample_type::vector4:
-			return sizeof(rtm::vector4f);
-		case acl_sjson::sample_type::quat:
-			return sizeof(rtm::quatf);
-		case acl_sjson::sample_type::qvv:
-			return sizeof(rtm::qvvf);
-		}
-	}
-
 	static acl::track_desc_scalarf get_description(const acl_sjson::scalar_track_description& desc)
 	{
 		acl::track_desc_scalarf out_desc;
@@ -86,85 +69,112 @@ namespace
 		return out_desc;
 	}
 
-	static acl::track make_track(acl::iallocator& allocator, const acl_sjson::track& track)
+	template<acl_sjson::sample_type type>
+	static acl::track convert_track(acl::iallocator& allocator, const acl_sjson::track& input_track)
+	{
+		using traits = acl_sjson::sample_traits<type>;
+		using acl_traits = acl_sjson_v21::acl_track_traits<type>;
+		using track_type = typename acl_traits::track_type;
+		using acl_sample_type = typename track_type::sample_type;
+
+		static_assert(sizeof(acl_sample_type) <= sizeof(acl_sjson::sample), "ACL samples must fit within our samples to be referenced");
+
+		const uint32_t num_samples = static_cast<uint32_t>(input_track.get_num_samples());
+		const float sample_rate = input_track.get_sample_rate();
+		const typename track_type::desc_type desc = get_description(acl_traits::get_description(input_track.get_description()));
+
+		acl::track out_track;
+
+		// When every sample is stored individually, ACL can reference them in place with our sample size as its stride
+		// Collapsed tracks only store a single sample and must be expanded into a copy
+		const bool can_reference = num_samples != 0 && !input_track.is_collapsed() && acl::is_aligned_to(&input_track[0], alignof(acl_sample_type));
+		if (can_reference)
+		{
+			const acl_sample_type* samples = reinterpret_cast<const acl_sample_type*>(&input_track[0]);
+			out_track = track_type::make_ref(desc, samples, num_samples, sample_rate, sizeof(acl_sjson::sample));
+		}
+		else
+		{
+			out_track = track_type::make_reserve(desc, allocator, num_samples, sample_rate);
+
+			track_type& typed_track = acl::track_cast<track_type>(out_track);
+			for (uint32_t sample_index = 0; sample_index < num_samples; ++sample_index)
+				std::memcpy(&typed_track[sample_index], &input_track[sample_index], traits::k_size);
+		}
+
+		out_track.set_name(acl::string(allocator, input_track.get_name()));
+		return out_track;
+	}
+
+	struct convert_track_functor
 	{
-		const acl_sjson::track_description& desc = track.get_description();
-		const acl_sjson::sample_type type = track.get_type();
-		const uint32_t num_samples = static_cast<uint32_t>(track.get_num_samples());
-		const float sample_rate = track.get_sample_rate();
+		acl::iallocator& allocator;
+		const acl_sjson::track& input_track;
+
+		template<typename traits_type>
+		acl::track operator()(traits_type) const
+		{
+			return convert_track<traits_type::k_type>(allocator, input_track);
+		}
 
-		switch (type)
+		acl::track operator()(acl_sjson::sample_traits<acl_sjson::sample_type::quat>) const
 		{
-		case acl_sjson::sample_type::float1:
-			return acl::track_float1f::make_reserve(get_description(desc.scalar), allocator, num_samples, sample_rate);
-		case acl_sjson::sample_type::float2:
-			return acl::track_float2f::make_reserve(get_description(desc.scalar), allocator, num_samples, sample_rate);
-		case acl_sjson::sample_type::float3:
-			return acl::track_float3f::make_reserve(get_description(desc.scalar), allocator, num_samples, sample_rate);
-		case acl_sjson::sample_type::float4:
-			return acl::track_float4f::make_reserve(get_description(desc.scalar), allocator, num_samples, sample_rate);
-		case acl_sjson::sample_type::vector4:
-			return acl::track_vector4f::make_reserve(get_description(desc.scalar), allocator, num_samples, sample_rate);
-		case acl_sjson::sample_type::quat:
 			ACL_ASSERT(false, "Unsupported type");
 			return acl::track();
-		case acl_sjson::sample_type::qvv:
-			return acl::track_qvvf::make_reserve(get_description(desc.transform), allocator, num_samples, sample_rate);
-		default:
+		}
+
+		acl::track operator()(acl_sjson::sample_traits<acl_sjson::sample_type::unknown>) const
+		{
 			ACL_ASSERT(false, "Unsupported type");
 			return acl::track();
 		}
-	}
+	};
+}
 
-	static acl::track_array convert_tracks(acl::iallocator& allocator, const acl_sjson::track_array& input_tracks)
+namespace acl_sjson_v21
+{
+	acl::track_array convert_tracks(acl::iallocator& allocator, const acl_sjson::track_array& input_tracks)
 	{
 		const uint32_t num_tracks = static_cast<uint32_t>(input_tracks.get_num_tracks());
 
 		acl::track_array out_tracks(allocator, num_tracks);
 		out_tracks.set_name(acl::string(allocator, input_tracks.get_name()));
 
-		for (uint32_t track_index = 0; track_index < num_tracks; ++track_index)
-		{
-			const acl_sjson::track& track_ = input_tracks[track_index];
-
-			acl::track out_track = make_track(allocator, track_);
-			out_track.set_name(acl::string(allocator, track_.get_name()));
-
-			const uint32_t num_samples = static_cast<uint32_t>(track_.get_num_samples());
-			const uint32_t sample_size = get_sample_size(track_.get_type());
-
-			for (uint32_t sample_index = 0; sample_index < num_samples; ++sample_index)
+		// Every track is converted independently into its own output slot
+		const size_t work_per_track = input_tracks.get_num_samples_per_track() * sizeof(acl_sjson::sample);
+		acl_sjson::parallel_for(num_tracks, work_per_track, [&](size_t track_index)
 			{
-				const acl_sjson::sample& smpl = track_[sample_index];
-				void* sample_ptr = out_track[sample_index];
-
-				std::memcpy(sample_ptr, &smpl, sample_size);
-			}
-
-			out_tracks[track_index] = std::move(out_track);
-		}
+				const acl_sjson::track& track_ = input_tracks[track_index];
+				out_tracks[static_cast<uint32_t>(track_index)] = acl_sjson::visit_sample_type(track_.get_type(), convert_track_functor{ allocator, track_ });
+			});
 
 		return out_tracks;
 	}
-}
 
-namespace acl_sjson_v21
-{
 	bool write_tracks(const char* filename, const acl_sjson::track_array& tracks)
 	{
-		acl::ansi_allocator allocator;
+		acl_sjson::scoped_memory_phase write_phase(acl_sjson::memory_phase::write);
 
-		const acl::track_array input_tracks = convert_tracks(allocator, tracks);
+		acl_sjson_v21::tracking_allocator allocator;
+
+		acl::track_array input_tracks;
+		{
+			acl_sjson::scoped_memory_phase convert_phase(acl_sjson::memory_phase::convert);
+			input_tracks = convert_tracks(allocator, tracks);
+		}
 
 		if (acl_sjson::is_acl_bin_file(filename))
 		{
 			// Convert our input tracks into a compressed_tracks instance
 			acl::compressed_tracks* output_tracks = nullptr;
-			const acl::error_result result = acl::convert_track_list(allocator, input_tracks, output_tracks);
-			if (result.any())
 			{
-				printf("Failed to convert tracks: %s\n", result.c_str());
-				return false;
+				acl_sjson::scoped_memory_phase compress_phase(acl_sjson::memory_phase::compress);
+				const acl::error_result result = acl::convert_track_list(allocator, input_tracks, output_tracks);
+				if (result.any())
+				{
+					printf("Failed to convert tracks: %s\n", result.c_str());
+					return false;
+				}
 			}
 
 #ifdef _WIN32
@@ -20,7 +20,7 @@ def parse_argv():
 	actions.add_argument('-package', action='store_true', help="Packages the regression tests into zip files for each target version")
 	actions.add_argument('-input')
 	actions.add_argument('-output')
-	actions.add_argument('-target')
+	actions.add_argument('-target', help='Target version(s), comma separated (e.g. 2.0,2.1). Multiple targets are written in sub-directories of \'-output\'')
 
 	target = parser.add_argument_group(title='Target')
 	target.add_argument('-compiler', choices=['vs2019', 'clang14', 'gcc11', 'osx'], help='Defaults to the host system\'s default compiler')
@@ -202,6 +202,12 @@ def print_progress(iteration, total, prefix='', suffix='', decimals = 1, bar_len
 	if iteration == total:
 		sys.stdout.write('\n')
 
+def get_target_output_dir(output_dir, target, targets):
+	# With multiple targets, each one is written in its own sub-directory
+	if len(targets) > 1:
+		return os.path.join(output_dir, 'v{}'.format(target))
+	return output_dir
+
 def do_convert(args, root_dir):
 	old_cwd = os.getcwd()
 	os.chdir(root_dir)
@@ -225,7 +231,9 @@ def do_convert(args, root_dir):
 		print('acl-sjson executable not found: {}'.format(tool_path))
 		sys.exit(1)
 
-	# Grab all the clips to convert
+	targets = args.target.split(',') if args.target else [None]
+
+	# Grab all the clips to convert, each clip is read once and written once per target
 	conversion_clips = []
 	if os.path.isfile(args.input):
 		if not args.input.endswith('.acl.sjson') and not args.input.endswith('.acl'):
@@ -236,13 +244,17 @@ def do_convert(args, root_dir):
 			print('Expected an ACL file format as output: {}'.format(args.output))
 			sys.exit(1)
 
+		if len(targets) > 1:
+			print('Multiple targets require an input directory')
+			sys.exit(1)
+
 		input_filename = os.path.abspath(args.input)
 		output_filename = os.path.abspath(args.output)
 
 		if not os.path.exists(output_filename):
 			os.makedirs(output_filename)
 
-		conversion_clips.append((input_filename, output_filename))
+		conversion_clips.append((input_filename, [(output_filename, targets[0])]))
 	elif os.path.isdir(args.input):
 		for (dirpath, dirnames, filenames) in os.walk(args.input):
 			for filename in filenames:
@@ -253,20 +265,25 @@ def do_convert(args, root_dir):
 				if filename == 'format_reference.acl.sjson':
 					continue
 
-				input_filename = os.path.join(dirpath, filename)
-				# Always convert to binary
-				output_filename = os.path.join(args.output, filename.replace('.acl.sjson', '.acl'))
+				input_filename = os.path.abspath(os.path.join(dirpath, filename))
 
-				input_filename = os.path.abspath(input_filename)
-				output_filename = os.path.abspath(output_filename)
+				outputs = []
+				for target in targets:
+					output_dir = get_target_output_dir(args.output, target, targets)
 
-				conversion_clips.append((input_filename, output_filename))
+					# Always convert to binary
+					output_filename = os.path.join(output_dir, filename.replace('.acl.sjson', '.acl'))
+					outputs.append((os.path.abspath(output_filename), target))
+
+				conversion_clips.append((input_filename, outputs))
 
 		if os.path.exists(args.output):
 			shutil.rmtree(args.output)
 
-		if not os.path.exists(args.output):
-			os.makedirs(args.output)
+		for target in targets:
+			output_dir = get_target_output_dir(args.output, target, targets)
+			if not os.path.exists(output_dir):
+				os.makedirs(output_dir)
 	else:
 		print('Unexpected input found: {}'.format(args.input))
 		sys.exit(1)
@@ -279,11 +296,17 @@ def do_convert(args, root_dir):
 	num_processed = 0
 	print_progress(num_processed, len(conversion_clips), 'Converting clips:', '{} / {}'.format(num_processed, len(conversion_clips)))
 	conversion_failed = False
-	for (input_filename, output_filename) in conversion_clips:
-		cmd = '"{}" --convert "{}" "{}"'.format(tool_path, input_filename, output_filename)
+	for (input_filename, outputs) in conversion_clips:
+		cmd = '"{}" --convert "{}"'.format(tool_path, input_filename)
+
+		for (output_index, (output_filename, target)) in enumerate(outputs):
+			if output_index == 0:
+				cmd = '{} "{}"'.format(cmd, output_filename)
+			else:
+				cmd = '{} --output "{}"'.format(cmd, output_filename)
 
-		if args.target:
-			cmd = "{} --target {}".format(cmd, args.target)
+			if target:
+				cmd = "{} --target {}".format(cmd, target)
 
 		if platform.system() == 'Windows':
 			cmd = cmd.replace('/', '\\')
@@ -317,10 +340,16 @@ def do_package(args, root_dir):
 	do_convert(args, root_dir)
 
 	readme_path = os.path.join(args.input, 'README.md')
-	shutil.copyfile(readme_path, os.path.join(args.output, 'README.md'))
+	targets = args.target.split(',') if args.target else [None]
+	for target in targets:
+		output_dir = get_target_output_dir(args.output, target, targets)
+		shutil.copyfile(readme_path, os.path.join(output_dir, 'README.md'))
+
+		zip_filename = os.path.join(root_dir, 'acl_regression_tests_v' + REGRESSION_TEST_DATA_VERSION)
+		if len(targets) > 1:
+			zip_filename = '{}_acl_v{}'.format(zip_filename, target)
 
-	zip_filename = os.path.join(root_dir, 'acl_regression_tests_v' + REGRESSION_TEST_DATA_VERSION)
-	shutil.make_archive(zip_filename, 'zip', args.output)
+		shutil.make_archive(zip_filename, 'zip', output_dir)
 
 	os.chdir(old_cwd)
 
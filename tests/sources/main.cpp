@@ -0,0 +1,80 @@
+////////////////////////////////////////////////////////////////////////////////
+// The MIT License (MIT)
+//
+// Copyright (c) 2022 Nicholas Frechette
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+////////////////////////////////////////////////////////////////////////////////
+
+#include "test_framework.h"
+
+#include <vector>
+
+namespace acl_sjson_tests
+{
+	namespace
+	{
+		struct test_case
+		{
+			const char* name;
+			test_func func;
+		};
+
+		static std::vector<test_case>& get_test_cases()
+		{
+			// Registration happens during static initialization, the list must exist before the first one
+			static std::vector<test_case> s_test_cases;
+			return s_test_cases;
+		}
+
+		static int s_num_failures = 0;
+	}
+
+	void register_test_case(const char* name, test_func func)
+	{
+		get_test_cases().push_back(test_case{ name, func });
+	}
+
+	void report_failure(const char* file, int line, const char* expression)
+	{
+		printf("%s(%d): check failed: %s\n", file, line, expression);
+		++s_num_failures;
+	}
+}
+
+int main()
+{
+	using namespace acl_sjson_tests;
+
+	int num_failed_test_cases = 0;
+	for (const test_case& test : get_test_cases())
+	{
+		const int num_failures = s_num_failures;
+		test.func();
+
+		const bool is_success = s_num_failures == num_failures;
+		printf("[%s] %s\n", is_success ? "PASS" : "FAIL", test.name);
+
+		if (!is_success)
+			++num_failed_test_cases;
+	}
+
+	printf("%d of %d test cases failed\n", num_failed_test_cases, static_cast<int>(get_test_cases().size()));
+	return num_failed_test_cases == 0 ? 0 : 1;
+}
@@ -0,0 +1,219 @@
+////////////////////////////////////////////////////////////////////////////////
+// The MIT License (MIT)
+//
+// Copyright (c) 2022 Nicholas Frechette
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+////////////////////////////////////////////////////////////////////////////////
+
+#include "test_framework.h"
+
+#include <acl-sjson/diff.h>
+#include <acl-sjson/metadata.h>
+#include <acl-sjson/track.h>
+#include <acl-sjson/track_array.h>
+#include <acl-sjson/track_description.h>
+
+#include <cstring>
+
+using namespace acl_sjson;
+
+namespace
+{
+	static constexpr size_t k_num_samples = 100;
+
+	// A constant track followed by an animated one, both qvv
+	static track_array make_clip()
+	{
+		metadata_t metadata;
+		track_array tracks("clip", metadata);
+
+		for (uint32_t track_index = 0; track_index < 2; ++track_index)
+		{
+			track track_(sample_type::qvv, 30.0F, track_index == 0 ? "constant" : "animated");
+
+			track_description& desc = track_.get_description();
+			std::memset(&desc, 0, sizeof(desc));
+			desc.transform.output_index = track_index;
+			desc.transform.parent_index = k_invalid_track_index;
+
+			for (size_t sample_index = 0; sample_index < k_num_samples; ++sample_index)
+			{
+				sample sample_;
+				std::memset(&sample_, 0, sizeof(sample_));
+				sample_.transform.rotation.w = 1.0F;
+				sample_.transform.translation.x = track_index == 0 ? 10.0F : float(sample_index);
+				sample_.transform.scale = vector4{ 1.0F, 1.0F, 1.0F, 0.0F };
+				track_.emplace_back(std::move(sample_));
+			}
+
+			tracks.emplace_back(std::move(track_));
+		}
+
+		return tracks;
+	}
+
+	// Offsets the translation of a sample by the provided amount
+	static void offset_sample(track& track_, size_t sample_index, float offset)
+	{
+		const track& const_track = track_;
+		sample sample_ = const_track[sample_index];
+		sample_.transform.translation.x += offset;
+		track_.set_sample(sample_index, sample_);
+	}
+}
+
+TEST_CASE(diff_identical_clips)
+{
+	const track_array lhs = make_clip();
+	const track_array rhs = make_clip();
+	CHECK(lhs[0].is_collapsed());
+
+	clip_diff result;
+	diff_tracks(lhs, rhs, diff_settings(), result);
+	CHECK(result.is_equal());
+}
+
+TEST_CASE(diff_ignores_padding)
+{
+	const track_array lhs = make_clip();
+	track_array rhs = make_clip();
+
+	// Binary and SJSON readers leave different values in the w component of translations and scales
+	for (size_t track_index = 0; track_index < 2; ++track_index)
+	{
+		sample* samples = rhs[track_index].get_mutable_samples();
+		for (size_t sample_index = 0; sample_index < k_num_samples; ++sample_index)
+		{
+			samples[sample_index].transform.translation.w = 1.0F;
+			samples[sample_index].transform.scale.w = -2.0F;
+		}
+	}
+
+	clip_diff result;
+	diff_tracks(lhs, rhs, diff_settings(), result);
+	CHECK(result.is_equal());
+}
+
+TEST_CASE(diff_collapsed_against_expanded)
+{
+	const track_array lhs = make_clip();
+	track_array rhs = make_clip();
+
+	// The same constant samples stored individually still match
+	rhs[0].expand();
+	CHECK(lhs[0].is_collapsed() && !rhs[0].is_collapsed());
+
+	clip_diff result;
+	diff_tracks(lhs, rhs, diff_settings(), result);
+	CHECK(result.is_equal());
+
+	diff_tracks(rhs, lhs, diff_settings(), result);
+	CHECK(result.is_equal());
+
+	// A single sample that differs from the repeating one is reported at its frame
+	offset_sample(rhs[0], 42, 1.0F);
+	diff_tracks(lhs, rhs, diff_settings(), result);
+	CHECK(result.tracks.size() == 1);
+	CHECK(!result.tracks.empty() && result.tracks[0].track_index == 0);
+	CHECK(!result.tracks.empty() && result.tracks[0].num_mismatched_frames == 1);
+	CHECK(!result.tracks.empty() && result.tracks[0].frames.size() == 1 && result.tracks[0].frames[0] == 42);
+	CHECK(!result.tracks.empty() && result.tracks[0].max_error == 1.0F);
+
+	// Two collapsed tracks with different repeating samples mismatch at every frame
+	track_array other = make_clip();
+	sample sample_ = lhs[0][0];
+	sample_.transform.translation.x = 11.0F;
+	for (size_t sample_index = 0; sample_index < k_num_samples; ++sample_index)
+		other[0].set_sample(sample_index, sample_);
+	CHECK(other[0].collapse());
+
+	diff_tracks(lhs, other, diff_settings(), result);
+	CHECK(result.tracks.size() == 1);
+	CHECK(!result.tracks.empty() && result.tracks[0].num_mismatched_frames == k_num_samples);
+	CHECK(!result.tracks.empty() && result.tracks[0].frames.size() == diff_settings().max_reported_frames);
+}
+
+TEST_CASE(diff_tolerances)
+{
+	const track_array lhs = make_clip();
+	track_array rhs = make_clip();
+
+	// An error of 0.5 on a value of 80.5
+	offset_sample(rhs[1], 80, 0.5F);
+
+	diff_settings settings;
+	clip_diff result;
+	diff_tracks(lhs, rhs, settings, result);
+	CHECK(result.tracks.size() == 1);
+	CHECK(!result.tracks.empty() && result.tracks[0].track_index == 1 && result.tracks[0].frames.size() == 1 && result.tracks[0].frames[0] == 80);
+
+	settings.absolute_tolerance = 0.25F;
+	diff_tracks(lhs, rhs, settings, result);
+	CHECK(!result.is_equal());
+
+	settings.absolute_tolerance = 0.5F;
+	diff_tracks(lhs, rhs, settings, result);
+	CHECK(result.is_equal());
+
+	// The relative tolerance scales with the largest magnitude of the two values
+	settings.absolute_tolerance = 0.0F;
+	settings.relative_tolerance = 0.001F;
+	diff_tracks(lhs, rhs, settings, result);
+	CHECK(!result.is_equal());
+
+	settings.relative_tolerance = 0.01F;
+	diff_tracks(lhs, rhs, settings, result);
+	CHECK(result.is_equal());
+}
+
+TEST_CASE(diff_stops_on_first_mismatch)
+{
+	const track_array lhs = make_clip();
+	track_array rhs = make_clip();
+
+	offset_sample(rhs[1], 10, 1.0F);
+	offset_sample(rhs[1], 20, 1.0F);
+	offset_sample(rhs[0], 30, 1.0F);
+
+	clip_diff result;
+	diff_tracks(lhs, rhs, diff_settings(), result);
+	CHECK(result.tracks.size() == 2);
+	CHECK(result.tracks.size() == 2 && result.tracks[1].num_mismatched_frames == 2);
+
+	// Only a yes/no answer is needed, a single mismatch is retained
+	diff_settings settings;
+	settings.stop_on_first_mismatch = true;
+	diff_tracks(lhs, rhs, settings, result);
+	CHECK(result.tracks.size() == 1);
+	CHECK(!result.tracks.empty() && result.tracks[0].num_mismatched_frames == 1);
+}
+
+TEST_CASE(diff_structure_mismatch)
+{
+	const track_array lhs = make_clip();
+
+	metadata_t metadata;
+	track_array rhs("clip", metadata);
+
+	clip_diff result;
+	diff_tracks(lhs, rhs, diff_settings(), result);
+	CHECK(!result.structure_mismatch.empty());
+	CHECK(!result.is_equal());
+}
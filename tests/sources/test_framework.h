@@ -0,0 +1,50 @@
+#pragma once
+
+////////////////////////////////////////////////////////////////////////////////
+// The MIT License (MIT)
+//
+// Copyright (c) 2022 Nicholas Frechette
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+////////////////////////////////////////////////////////////////////////////////
+
+#include <cstdio>
+
+// A minimal test runner, every test case registers itself and main() runs them in order
+// Checks report their location and keep going, a test case fails if any check fails
+namespace acl_sjson_tests
+{
+	using test_func = void (*)();
+
+	void register_test_case(const char* name, test_func func);
+	void report_failure(const char* file, int line, const char* expression);
+
+	struct test_case_registrar
+	{
+		test_case_registrar(const char* name, test_func func) { register_test_case(name, func); }
+	};
+}
+
+#define TEST_CASE(name) \
+	static void name(); \
+	static acl_sjson_tests::test_case_registrar name##_registrar(#name, name); \
+	static void name()
+
+#define CHECK(expression) \
+	do { if (!(expression)) acl_sjson_tests::report_failure(__FILE__, __LINE__, #expression); } while (false)
@@ -0,0 +1,46 @@
+////////////////////////////////////////////////////////////////////////////////
+// The MIT License (MIT)
+//
+// Copyright (c) 2022 Nicholas Frechette
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+////////////////////////////////////////////////////////////////////////////////
+
+#include "test_framework.h"
+
+#include <acl-sjson/generator.h>
+#include <acl-sjson/hash.h>
+#include <acl-sjson/track_array.h>
+
+using namespace acl_sjson;
+
+TEST_CASE(generated_clips_are_deterministic)
+{
+	// These hashes must match on every platform, a change here means generated clips changed
+	generator_settings settings;
+	track_array tracks;
+	CHECK(generate_clip(settings, tracks));
+	CHECK(hash_tracks(tracks) == 0xcb4047ce495fb6e5ULL);
+
+	settings.seed = 42;
+	settings.num_bones = 8;
+	settings.num_samples = 31;
+	CHECK(generate_clip(settings, tracks));
+	CHECK(hash_tracks(tracks) == 0x2ac1e7ec010792e8ULL);
+}
@@ -0,0 +1,127 @@
+////////////////////////////////////////////////////////////////////////////////
+// The MIT License (MIT)
+//
+// Copyright (c) 2022 Nicholas Frechette
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+////////////////////////////////////////////////////////////////////////////////
+
+#include "test_framework.h"
+
+#include <acl-sjson/hash.h>
+#include <acl-sjson/metadata.h>
+#include <acl-sjson/track.h>
+#include <acl-sjson/track_array.h>
+#include <acl-sjson/track_description.h>
+
+#include <cstring>
+
+using namespace acl_sjson;
+
+namespace
+{
+	// A root and a child transform track with their output order reversed
+	static track_array make_clip(const char* name)
+	{
+		metadata_t metadata;
+		track_array tracks(name, metadata);
+
+		for (uint32_t track_index = 0; track_index < 2; ++track_index)
+		{
+			track track_(sample_type::qvv, 30.0F, track_index == 0 ? "root" : "child");
+
+			track_description& desc = track_.get_description();
+			std::memset(&desc, 0, sizeof(desc));
+			desc.transform.output_index = 1 - track_index;
+			desc.transform.parent_index = track_index == 0 ? k_invalid_track_index : 0;
+			desc.transform.precision = 0.01F;
+			desc.transform.shell_distance = 3.0F;
+			desc.transform.default_value.rotation.w = 1.0F;
+			desc.transform.default_value.scale = vector4{ 1.0F, 1.0F, 1.0F, 0.0F };
+
+			for (size_t sample_index = 0; sample_index < 10; ++sample_index)
+			{
+				sample sample_;
+				std::memset(&sample_, 0, sizeof(sample_));
+				sample_.transform.rotation.w = 1.0F;
+				sample_.transform.translation.x = float(sample_index * (track_index + 1));
+				sample_.transform.scale = vector4{ 1.0F, 1.0F, 1.0F, 0.0F };
+				track_.emplace_back(std::move(sample_));
+			}
+
+			tracks.emplace_back(std::move(track_));
+		}
+
+		return tracks;
+	}
+}
+
+TEST_CASE(hash_ignores_descriptions)
+{
+	// Readers and binary files without metadata do not retain every setting
+	const uint64_t reference_hash = hash_tracks(make_clip("clip"));
+
+	track_array tracks = make_clip("renamed clip");
+	transform_track_description& desc = tracks[1].get_description().transform;
+	desc.precision = 0.5F;
+	desc.shell_distance = 100.0F;
+	desc.constant_rotation_threshold_angle = 0.1F;
+	desc.default_value.translation.y = 7.0F;
+
+	CHECK(hash_tracks(tracks) == reference_hash);
+}
+
+TEST_CASE(hash_includes_samples_and_hierarchy)
+{
+	const uint64_t reference_hash = hash_tracks(make_clip("clip"));
+
+	track_array tracks = make_clip("clip");
+	sample sample_ = tracks[1][3];
+	sample_.transform.translation.x += 1.0F;
+	tracks[1].set_sample(3, sample_);
+	CHECK(hash_tracks(tracks) != reference_hash);
+
+	tracks = make_clip("clip");
+	tracks[1].get_description().transform.parent_index = k_invalid_track_index;
+	CHECK(hash_tracks(tracks) != reference_hash);
+
+	tracks = make_clip("clip");
+	tracks[0].get_description().transform.output_index = 0;
+	tracks[1].get_description().transform.output_index = 1;
+	CHECK(hash_tracks(tracks) != reference_hash);
+}
+
+TEST_CASE(hash_ignores_padding)
+{
+	// Readers leave different values in the w component of translations and scales
+	const uint64_t reference_hash = hash_tracks(make_clip("clip"));
+
+	track_array tracks = make_clip("clip");
+	sample* samples = tracks[1].get_mutable_samples();
+	for (size_t sample_index = 0; sample_index < tracks[1].get_num_samples(); ++sample_index)
+	{
+		samples[sample_index].transform.translation.w = float(sample_index);
+		samples[sample_index].transform.scale.w = 1.0F;
+	}
+
+	CHECK(hash_tracks(tracks) == reference_hash);
+
+	samples[2].transform.scale.z = 2.0F;
+	CHECK(hash_tracks(tracks) != reference_hash);
+}
@@ -0,0 +1,233 @@
+////////////////////////////////////////////////////////////////////////////////
+// The MIT License (MIT)
+//
+// Copyright (c) 2022 Nicholas Frechette
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+////////////////////////////////////////////////////////////////////////////////
+
+#include "test_framework.h"
+
+#include <acl-sjson/hierarchy.h>
+#include <acl-sjson/metadata.h>
+#include <acl-sjson/track.h>
+#include <acl-sjson/track_array.h>
+#include <acl-sjson/track_description.h>
+
+#include <cstring>
+#include <vector>
+
+using namespace acl_sjson;
+
+namespace
+{
+	struct bone
+	{
+		const char* name;
+		uint32_t parent_index;
+	};
+
+	// Two roots with children listed before their parents, like 09_02_multi_root once shuffled
+	static const bone k_bones[] =
+	{
+		{ "rThumb1", 3 },
+		{ "hip", k_invalid_track_index },
+		{ "chest", 4 },
+		{ "rHand", k_invalid_track_index },
+		{ "abdomen", 1 },
+		{ "rIndex1", 3 },
+		{ "head", 2 },
+		{ "rThumb2", 0 },
+	};
+	static constexpr uint32_t k_num_bones = sizeof(k_bones) / sizeof(k_bones[0]);
+
+	static const uint32_t k_breadth_first_order[k_num_bones] = { 1, 3, 4, 0, 5, 2, 7, 6 };
+	static const uint32_t k_depth_first_order[k_num_bones] = { 1, 4, 2, 6, 3, 0, 7, 5 };
+
+	// Output indices differ from the track indices to detect if they are remapped
+	static uint32_t get_output_index(uint32_t track_index)
+	{
+		return k_num_bones - track_index - 1;
+	}
+
+	static track_array make_hierarchy(const bone* bones, uint32_t num_bones)
+	{
+		metadata_t metadata;
+		track_array tracks("clip", metadata);
+		for (uint32_t track_index = 0; track_index < num_bones; ++track_index)
+		{
+			track track_(sample_type::qvv, 30.0F, bones[track_index].name);
+
+			track_description& desc = track_.get_description();
+			std::memset(&desc, 0, sizeof(desc));
+			desc.transform.output_index = get_output_index(track_index);
+			desc.transform.parent_index = bones[track_index].parent_index;
+
+			// The translation identifies the track
+			sample sample_;
+			std::memset(&sample_, 0, sizeof(sample_));
+			sample_.transform.rotation = quat{ 0.0F, 0.0F, 0.0F, 1.0F };
+			sample_.transform.translation = vector4{ float(track_index), 0.0F, 0.0F, 0.0F };
+			sample_.transform.scale = vector4{ 1.0F, 1.0F, 1.0F, 0.0F };
+			track_.emplace_back(std::move(sample_));
+
+			tracks.emplace_back(std::move(track_));
+		}
+
+		return tracks;
+	}
+
+	static bool has_parents_first(const track_array& tracks, const std::vector<uint32_t>& order)
+	{
+		std::vector<bool> is_visited(tracks.get_num_tracks(), false);
+		for (const uint32_t track_index : order)
+		{
+			const uint32_t parent_index = tracks[track_index].get_description().transform.parent_index;
+			if (parent_index != k_invalid_track_index && !is_visited[parent_index])
+				return false;
+
+			is_visited[track_index] = true;
+		}
+
+		return true;
+	}
+
+	static bool has_track_order(const track_array& tracks, const uint32_t* order)
+	{
+		for (uint32_t track_index = 0; track_index < tracks.get_num_tracks(); ++track_index)
+		{
+			if (std::strcmp(tracks[track_index].get_name(), k_bones[order[track_index]].name) != 0)
+				return false;
+		}
+
+		return true;
+	}
+
+	static void check_reordered(const track_array& tracks, const uint32_t* expected_order)
+	{
+		CHECK(tracks.get_num_tracks() == k_num_bones);
+		CHECK(has_track_order(tracks, expected_order));
+
+		for (uint32_t track_index = 0; track_index < k_num_bones; ++track_index)
+		{
+			const uint32_t source_index = expected_order[track_index];
+			const track& track_ = tracks[track_index];
+
+			// Samples and output indices follow their track
+			CHECK(track_[0].transform.translation.x == float(source_index));
+			CHECK(track_.get_output_index() == get_output_index(source_index));
+
+			// Parent indices are remapped to the new order, parents come first
+			const uint32_t parent_index = track_.get_description().transform.parent_index;
+			const uint32_t source_parent_index = k_bones[source_index].parent_index;
+			if (source_parent_index == k_invalid_track_index)
+			{
+				CHECK(parent_index == k_invalid_track_index);
+			}
+			else
+			{
+				CHECK(parent_index < track_index);
+				CHECK(std::strcmp(tracks[parent_index].get_name(), k_bones[source_parent_index].name) == 0);
+			}
+		}
+	}
+}
+
+TEST_CASE(hierarchy_topological_order)
+{
+	const track_array tracks = make_hierarchy(k_bones, k_num_bones);
+
+	std::vector<uint32_t> order;
+	CHECK(get_topological_order(tracks, hierarchy_order::breadth_first, order));
+	CHECK(order == std::vector<uint32_t>(k_breadth_first_order, k_breadth_first_order + k_num_bones));
+	CHECK(has_parents_first(tracks, order));
+
+	CHECK(get_topological_order(tracks, hierarchy_order::depth_first, order));
+	CHECK(order == std::vector<uint32_t>(k_depth_first_order, k_depth_first_order + k_num_bones));
+	CHECK(has_parents_first(tracks, order));
+}
+
+TEST_CASE(hierarchy_reorder)
+{
+	track_array breadth_first_tracks = make_hierarchy(k_bones, k_num_bones);
+	CHECK(reorder_hierarchy(breadth_first_tracks, hierarchy_order::breadth_first));
+	check_reordered(breadth_first_tracks, k_breadth_first_order);
+
+	track_array depth_first_tracks = make_hierarchy(k_bones, k_num_bones);
+	CHECK(reorder_hierarchy(depth_first_tracks, hierarchy_order::depth_first));
+	check_reordered(depth_first_tracks, k_depth_first_order);
+
+	// Names are looked up in the new order
+	CHECK(depth_first_tracks.find("rThumb2") == 6);
+
+	// A sorted hierarchy is left as it is
+	std::vector<uint32_t> order;
+	CHECK(get_topological_order(depth_first_tracks, hierarchy_order::depth_first, order));
+	for (uint32_t track_index = 0; track_index < k_num_bones; ++track_index)
+		CHECK(order[track_index] == track_index);
+}
+
+TEST_CASE(hierarchy_rejects_invalid_parents)
+{
+	const bone cycle_bones[] = { { "root", k_invalid_track_index }, { "a", 2 }, { "b", 1 } };
+	const bone self_parent_bones[] = { { "root", k_invalid_track_index }, { "a", 1 } };
+	const bone out_of_range_bones[] = { { "root", k_invalid_track_index }, { "a", 2 } };
+
+	const bone* invalid_bones[] = { cycle_bones, self_parent_bones, out_of_range_bones };
+	const uint32_t num_invalid_bones[] = { 3, 2, 2 };
+
+	for (uint32_t hierarchy_index = 0; hierarchy_index < 3; ++hierarchy_index)
+	{
+		track_array tracks = make_hierarchy(invalid_bones[hierarchy_index], num_invalid_bones[hierarchy_index]);
+
+		std::vector<uint32_t> order;
+		CHECK(!get_topological_order(tracks, hierarchy_order::breadth_first, order));
+		CHECK(!get_topological_order(tracks, hierarchy_order::depth_first, order));
+		CHECK(order.empty());
+
+		// The tracks are left untouched
+		CHECK(!reorder_hierarchy(tracks, hierarchy_order::breadth_first));
+		CHECK(tracks.get_num_tracks() == num_invalid_bones[hierarchy_index]);
+		for (uint32_t track_index = 0; track_index < tracks.get_num_tracks(); ++track_index)
+		{
+			CHECK(std::strcmp(tracks[track_index].get_name(), invalid_bones[hierarchy_index][track_index].name) == 0);
+			CHECK(tracks[track_index].get_description().transform.parent_index == invalid_bones[hierarchy_index][track_index].parent_index);
+		}
+	}
+}
+
+TEST_CASE(hierarchy_ignores_scalar_tracks)
+{
+	metadata_t metadata;
+	track_array tracks("clip", metadata);
+	for (uint32_t track_index = 0; track_index < 3; ++track_index)
+	{
+		track track_(sample_type::float1, 30.0F, k_bones[track_index].name);
+		std::memset(&track_.get_description(), 0, sizeof(track_description));
+		track_.get_description().scalar.output_index = track_index;
+		tracks.emplace_back(std::move(track_));
+	}
+
+	std::vector<uint32_t> order;
+	CHECK(get_topological_order(tracks, hierarchy_order::breadth_first, order));
+	CHECK(order == std::vector<uint32_t>({ 0, 1, 2 }));
+
+	CHECK(reorder_hierarchy(tracks, hierarchy_order::depth_first));
+	CHECK(has_track_order(tracks, order.data()));
+}
@@ -0,0 +1,255 @@
+////////////////////////////////////////////////////////////////////////////////
+// The MIT License (MIT)
+//
+// Copyright (c) 2022 Nicholas Frechette
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+////////////////////////////////////////////////////////////////////////////////
+
+#include "test_framework.h"
+
+#include "interpolation.h"
+
+#include <acl-sjson/metadata.h>
+#include <acl-sjson/track.h>
+#include <acl-sjson/track_array.h>
+#include <acl-sjson/track_description.h>
+
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <vector>
+
+using namespace acl_sjson;
+
+namespace
+{
+	static constexpr float k_sample_rate = 30.0F;
+	static constexpr size_t k_num_samples = 11;
+
+	static bool are_keys_equal(const interpolation_keys& keys, size_t key0, size_t key1, float alpha)
+	{
+		return keys.key0 == key0 && keys.key1 == key1 && std::fabs(keys.alpha - alpha) < 0.0001F;
+	}
+
+	// Values that do not survive a round trip through arithmetic, exact keys must be returned as they are
+	static sample make_sample(size_t sample_index)
+	{
+		const float value = float(sample_index);
+
+		sample sample_;
+		std::memset(&sample_, 0, sizeof(sample_));
+		sample_.f3 = float3{ value, std::sin(value), 1.0F / (value + 3.0F) };
+		return sample_;
+	}
+
+	static track make_track(size_t num_samples)
+	{
+		track track_(sample_type::float3, k_sample_rate, "values");
+		std::memset(&track_.get_description(), 0, sizeof(track_description));
+		for (size_t sample_index = 0; sample_index < num_samples; ++sample_index)
+			track_.emplace_back(make_sample(sample_index));
+
+		return track_;
+	}
+
+	static bool is_bit_equal(const sample& lhs, const sample& rhs)
+	{
+		return std::memcmp(&lhs.f3, &rhs.f3, sizeof(float3)) == 0;
+	}
+
+	static bool is_near(const sample& lhs, const sample& rhs)
+	{
+		return std::fabs(lhs.f3.x - rhs.f3.x) < 0.0001F && std::fabs(lhs.f3.y - rhs.f3.y) < 0.0001F && std::fabs(lhs.f3.z - rhs.f3.z) < 0.0001F;
+	}
+
+	static sample lerp(const sample& start, const sample& end, float alpha)
+	{
+		sample result;
+		std::memset(&result, 0, sizeof(result));
+		result.f3 = float3{ start.f3.x + (end.f3.x - start.f3.x) * alpha, start.f3.y + (end.f3.y - start.f3.y) * alpha, start.f3.z + (end.f3.z - start.f3.z) * alpha };
+		return result;
+	}
+
+	// A rotation around the Z axis
+	static quat make_rotation(float angle)
+	{
+		return quat{ 0.0F, 0.0F, std::sin(angle * 0.5F), std::cos(angle * 0.5F) };
+	}
+}
+
+TEST_CASE(interpolation_keys_clamp)
+{
+	const float nan = std::numeric_limits<float>::quiet_NaN();
+	const float infinity = std::numeric_limits<float>::infinity();
+
+	CHECK(are_keys_equal(find_interpolation_keys(5, 2.5F, sample_wrap_policy::clamp), 2, 3, 0.5F));
+	CHECK(are_keys_equal(find_interpolation_keys(5, 0.0F, sample_wrap_policy::clamp), 0, 1, 0.0F));
+	CHECK(are_keys_equal(find_interpolation_keys(5, -1.0F, sample_wrap_policy::clamp), 0, 1, 0.0F));
+	CHECK(are_keys_equal(find_interpolation_keys(5, -infinity, sample_wrap_policy::clamp), 0, 1, 0.0F));
+	CHECK(are_keys_equal(find_interpolation_keys(5, nan, sample_wrap_policy::clamp), 0, 1, 0.0F));
+	CHECK(are_keys_equal(find_interpolation_keys(5, 4.0F, sample_wrap_policy::clamp), 4, 4, 0.0F));
+	CHECK(are_keys_equal(find_interpolation_keys(5, 10.0F, sample_wrap_policy::clamp), 4, 4, 0.0F));
+	CHECK(are_keys_equal(find_interpolation_keys(5, infinity, sample_wrap_policy::clamp), 4, 4, 0.0F));
+
+	// Within rounding error of a sample, the position snaps to it
+	CHECK(find_interpolation_keys(5, 2.00001F, sample_wrap_policy::clamp).alpha == 0.0F);
+	CHECK(are_keys_equal(find_interpolation_keys(5, 1.99999F, sample_wrap_policy::clamp), 2, 3, 0.0F));
+	CHECK(are_keys_equal(find_interpolation_keys(5, 3.99999F, sample_wrap_policy::clamp), 4, 4, 0.0F));
+
+	// Without two samples, there is nothing to interpolate
+	CHECK(are_keys_equal(find_interpolation_keys(0, 2.5F, sample_wrap_policy::clamp), 0, 0, 0.0F));
+	CHECK(are_keys_equal(find_interpolation_keys(1, 2.5F, sample_wrap_policy::loop), 0, 0, 0.0F));
+	CHECK(are_keys_equal(find_interpolation_keys(1, 2.5F, sample_wrap_policy::wrap), 0, 0, 0.0F));
+}
+
+TEST_CASE(interpolation_keys_loop)
+{
+	// The last sample repeats the first, the period is 4 samples
+	CHECK(are_keys_equal(find_interpolation_keys(5, 1.5F, sample_wrap_policy::loop), 1, 2, 0.5F));
+	CHECK(are_keys_equal(find_interpolation_keys(5, 5.5F, sample_wrap_policy::loop), 1, 2, 0.5F));
+	CHECK(are_keys_equal(find_interpolation_keys(5, 4.0F, sample_wrap_policy::loop), 0, 1, 0.0F));
+	CHECK(are_keys_equal(find_interpolation_keys(5, 3.5F, sample_wrap_policy::loop), 3, 4, 0.5F));
+	CHECK(are_keys_equal(find_interpolation_keys(5, -0.5F, sample_wrap_policy::loop), 3, 4, 0.5F));
+	CHECK(are_keys_equal(find_interpolation_keys(5, -4.0F, sample_wrap_policy::loop), 0, 1, 0.0F));
+	CHECK(are_keys_equal(find_interpolation_keys(5, std::numeric_limits<float>::quiet_NaN(), sample_wrap_policy::loop), 0, 1, 0.0F));
+	CHECK(are_keys_equal(find_interpolation_keys(5, std::numeric_limits<float>::infinity(), sample_wrap_policy::loop), 0, 1, 0.0F));
+
+	// Just short of the period, the position snaps to the last sample
+	CHECK(are_keys_equal(find_interpolation_keys(5, 3.99999F, sample_wrap_policy::loop), 4, 4, 0.0F));
+}
+
+TEST_CASE(interpolation_keys_wrap)
+{
+	// The last sample interpolates back to the first, the period is 5 samples
+	CHECK(are_keys_equal(find_interpolation_keys(5, 4.5F, sample_wrap_policy::wrap), 4, 0, 0.5F));
+	CHECK(are_keys_equal(find_interpolation_keys(5, 4.0F, sample_wrap_policy::wrap), 4, 0, 0.0F));
+	CHECK(are_keys_equal(find_interpolation_keys(5, 5.0F, sample_wrap_policy::wrap), 0, 1, 0.0F));
+	CHECK(are_keys_equal(find_interpolation_keys(5, 7.25F, sample_wrap_policy::wrap), 2, 3, 0.25F));
+	CHECK(are_keys_equal(find_interpolation_keys(5, -0.25F, sample_wrap_policy::wrap), 4, 0, 0.75F));
+	CHECK(are_keys_equal(find_interpolation_keys(5, -std::numeric_limits<float>::infinity(), sample_wrap_policy::wrap), 0, 1, 0.0F));
+	CHECK(are_keys_equal(find_interpolation_keys(5, 4.99999F, sample_wrap_policy::wrap), 0, 1, 0.0F));
+}
+
+TEST_CASE(interpolation_track_sample_at)
+{
+	const track track_ = make_track(k_num_samples);
+	const sample& first_sample = track_[0];
+	const sample& last_sample = track_[k_num_samples - 1];
+
+	// Every key is returned bit for bit even if time * sample_rate is not exactly an integer
+	for (size_t sample_index = 0; sample_index < k_num_samples; ++sample_index)
+	{
+		const float time = float(sample_index) / k_sample_rate;
+		CHECK(is_bit_equal(track_.sample_at(time), track_[sample_index]));
+		CHECK(is_bit_equal(track_.sample_at(time, rotation_interpolation::slerp, sample_wrap_policy::loop), track_[sample_index == k_num_samples - 1 ? 0 : sample_index]));
+	}
+
+	CHECK(is_near(track_.sample_at(2.25F / k_sample_rate), lerp(track_[2], track_[3], 0.25F)));
+
+	// Clamped
+	CHECK(is_bit_equal(track_.sample_at(-1.0F), first_sample));
+	CHECK(is_bit_equal(track_.sample_at(std::numeric_limits<float>::quiet_NaN()), first_sample));
+	CHECK(is_bit_equal(track_.sample_at(100.0F), last_sample));
+
+	// Looping, the period is the duration
+	const float duration = float(k_num_samples - 1) / k_sample_rate;
+	CHECK(is_near(track_.sample_at(duration + (0.5F / k_sample_rate), rotation_interpolation::nlerp, sample_wrap_policy::loop), lerp(track_[0], track_[1], 0.5F)));
+	CHECK(is_near(track_.sample_at(-0.5F / k_sample_rate, rotation_interpolation::nlerp, sample_wrap_policy::loop), lerp(track_[k_num_samples - 2], last_sample, 0.5F)));
+
+	// Wrapping, the last sample interpolates back to the first
+	CHECK(is_near(track_.sample_at(duration + (0.5F / k_sample_rate), rotation_interpolation::nlerp, sample_wrap_policy::wrap), lerp(last_sample, first_sample, 0.5F)));
+	CHECK(is_bit_equal(track_.sample_at(duration + (1.0F / k_sample_rate), rotation_interpolation::nlerp, sample_wrap_policy::wrap), first_sample));
+
+	// Tracks without samples return a zeroed sample
+	const track empty_track = make_track(0);
+	const sample empty_sample = empty_track.sample_at(0.0F);
+	CHECK(empty_sample.f3.x == 0.0F && empty_sample.f3.y == 0.0F && empty_sample.f3.z == 0.0F);
+
+	// Collapsed tracks return their sample as it is
+	track constant_track(sample_type::float3, k_sample_rate, "constant");
+	for (size_t sample_index = 0; sample_index < k_num_samples; ++sample_index)
+		constant_track.emplace_back(make_sample(7));
+
+	CHECK(constant_track.is_collapsed());
+	CHECK(is_bit_equal(constant_track.sample_at(2.5F / k_sample_rate), make_sample(7)));
+	CHECK(is_bit_equal(constant_track.sample_at(duration + (0.5F / k_sample_rate), rotation_interpolation::nlerp, sample_wrap_policy::wrap), make_sample(7)));
+}
+
+TEST_CASE(interpolation_rotations)
+{
+	track track_(sample_type::quat, k_sample_rate, "rotation");
+	std::memset(&track_.get_description(), 0, sizeof(track_description));
+	for (size_t sample_index = 0; sample_index < 3; ++sample_index)
+	{
+		sample sample_;
+		sample_.q = make_rotation(float(sample_index));
+		track_.emplace_back(std::move(sample_));
+	}
+
+	// Keys are exact with either interpolation
+	const quat slerp_key = track_.sample_at(1.0F / k_sample_rate, rotation_interpolation::slerp).q;
+	const quat nlerp_key = track_.sample_at(1.0F / k_sample_rate, rotation_interpolation::nlerp).q;
+	CHECK(std::memcmp(&slerp_key, &track_[1].q, sizeof(quat)) == 0);
+	CHECK(std::memcmp(&nlerp_key, &track_[1].q, sizeof(quat)) == 0);
+
+	// Slerp has a constant angular velocity, nlerp is only normalized
+	const quat expected = make_rotation(0.25F);
+	const quat slerp_rotation = track_.sample_at(0.25F / k_sample_rate, rotation_interpolation::slerp).q;
+	CHECK(std::fabs(slerp_rotation.z - expected.z) < 0.00001F && std::fabs(slerp_rotation.w - expected.w) < 0.00001F);
+
+	const quat nlerp_rotation = track_.sample_at(0.25F / k_sample_rate, rotation_interpolation::nlerp).q;
+	CHECK(std::fabs(nlerp_rotation.z * nlerp_rotation.z + nlerp_rotation.w * nlerp_rotation.w - 1.0F) < 0.00001F);
+	CHECK(std::fabs(nlerp_rotation.z - expected.z) > 0.0001F);
+}
+
+TEST_CASE(interpolation_track_array_sample_pose_at)
+{
+	metadata_t metadata;
+	track_array tracks("clip", metadata);
+	tracks.emplace_back(make_track(k_num_samples));
+
+	track constant_track(sample_type::float3, k_sample_rate, "constant");
+	std::memset(&constant_track.get_description(), 0, sizeof(track_description));
+	for (size_t sample_index = 0; sample_index < k_num_samples; ++sample_index)
+		constant_track.emplace_back(make_sample(7));
+	tracks.emplace_back(std::move(constant_track));
+
+	// Every track is sampled as if it was sampled on its own
+	const float times[] = { 0.0F, 3.0F / k_sample_rate, 4.75F / k_sample_rate, -1.0F, 100.0F, std::numeric_limits<float>::quiet_NaN(), (k_num_samples - 0.5F) / k_sample_rate };
+	const sample_wrap_policy wrap_policies[] = { sample_wrap_policy::clamp, sample_wrap_policy::loop, sample_wrap_policy::wrap };
+	for (const sample_wrap_policy wrap_policy : wrap_policies)
+	{
+		for (const float time : times)
+		{
+			sample pose[2];
+			CHECK(tracks.sample_pose_at(time, pose, 2, rotation_interpolation::nlerp, wrap_policy));
+			CHECK(is_bit_equal(pose[0], tracks[0].sample_at(time, rotation_interpolation::nlerp, wrap_policy)));
+			CHECK(is_bit_equal(pose[1], tracks[1].sample_at(time, rotation_interpolation::nlerp, wrap_policy)));
+		}
+	}
+
+	// The pose must hold a sample per track
+	sample pose[2];
+	CHECK(!tracks.sample_pose_at(0.0F, pose, 1));
+
+	// Without tracks there is nothing to sample
+	const track_array empty_tracks;
+	CHECK(empty_tracks.sample_pose_at(0.0F, pose, 0));
+}
@@ -0,0 +1,62 @@
+////////////////////////////////////////////////////////////////////////////////
+// The MIT License (MIT)
+//
+// Copyright (c) 2022 Nicholas Frechette
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+////////////////////////////////////////////////////////////////////////////////
+
+#include "test_framework.h"
+
+#include <acl-sjson/io.h>
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#ifndef _WIN32
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+using namespace acl_sjson;
+
+#ifndef _WIN32
+TEST_CASE(list_files_skips_symlinked_directories)
+{
+	// A link back to the root forms a cycle that must not be followed
+	const std::string root = "list_files_test";
+	mkdir(root.c_str(), 0755);
+	mkdir((root + "/sub").c_str(), 0755);
+	std::fclose(std::fopen((root + "/sub/clip.acl").c_str(), "wb"));
+	CHECK(symlink("..", (root + "/sub/loop").c_str()) == 0);
+	CHECK(symlink("clip.acl", (root + "/sub/link.acl").c_str()) == 0);
+
+	std::vector<std::string> filenames;
+	CHECK(list_files(root.c_str(), true, filenames));
+	CHECK(filenames.size() == 2);
+	CHECK(filenames.size() == 2 && filenames[0] == root + "/sub/clip.acl" && filenames[1] == root + "/sub/link.acl");
+
+	unlink((root + "/sub/link.acl").c_str());
+	unlink((root + "/sub/loop").c_str());
+	unlink((root + "/sub/clip.acl").c_str());
+	rmdir((root + "/sub").c_str());
+	rmdir(root.c_str());
+}
+#endif
@@ -0,0 +1,239 @@
+////////////////////////////////////////////////////////////////////////////////
+// The MIT License (MIT)
+//
+// Copyright (c) 2022 Nicholas Frechette
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+////////////////////////////////////////////////////////////////////////////////
+
+#include "test_framework.h"
+
+#include <acl-sjson/metadata.h>
+#include <acl-sjson/object_space.h>
+#include <acl-sjson/track.h>
+#include <acl-sjson/track_array.h>
+#include <acl-sjson/track_description.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace acl_sjson;
+
+namespace
+{
+	// Spans two sample blocks and is not a multiple of 4, the last batch of every block is partial
+	static constexpr size_t k_num_samples = 70;
+
+	// Children are listed before their parents and two roots are interleaved
+	// Depths: 1 and 5 are roots, 2, 6 and 7 are at depth 1, 3 and 8 at depth 2, 0 at depth 3 and 4 at depth 4
+	static const uint32_t k_parent_indices[] = { 3, k_invalid_track_index, 1, 2, 0, k_invalid_track_index, 5, 1, 6 };
+	static constexpr uint32_t k_num_tracks = sizeof(k_parent_indices) / sizeof(k_parent_indices[0]);
+
+	static quat quat_mul(const quat& lhs, const quat& rhs)
+	{
+		// Same order as rtm::quat_mul: lhs applies first, then rhs
+		return quat
+		{
+			(rhs.w * lhs.x) + (rhs.x * lhs.w) + (rhs.y * lhs.z) - (rhs.z * lhs.y),
+			(rhs.w * lhs.y) - (rhs.x * lhs.z) + (rhs.y * lhs.w) + (rhs.z * lhs.x),
+			(rhs.w * lhs.z) + (rhs.x * lhs.y) - (rhs.y * lhs.x) + (rhs.z * lhs.w),
+			(rhs.w * lhs.w) - (rhs.x * lhs.x) - (rhs.y * lhs.y) - (rhs.z * lhs.z),
+		};
+	}
+
+	static vector4 quat_mul_vector3(const vector4& vector, const quat& rotation)
+	{
+		const quat inv_rotation = quat{ -rotation.x, -rotation.y, -rotation.z, rotation.w };
+		const quat vector_quat = quat{ vector.x, vector.y, vector.z, 0.0F };
+		const quat result = quat_mul(quat_mul(inv_rotation, vector_quat), rotation);
+		return vector4{ result.x, result.y, result.z, 0.0F };
+	}
+
+	// Scalar reference of rtm::qvv_mul(local, parent)
+	static qvv qvv_mul(const qvv& local, const qvv& parent)
+	{
+		const vector4 scaled_translation = vector4{ local.translation.x * parent.scale.x, local.translation.y * parent.scale.y, local.translation.z * parent.scale.z, 0.0F };
+		const vector4 rotated_translation = quat_mul_vector3(scaled_translation, parent.rotation);
+
+		qvv result;
+		result.rotation = quat_mul(local.rotation, parent.rotation);
+		result.translation = vector4{ rotated_translation.x + parent.translation.x, rotated_translation.y + parent.translation.y, rotated_translation.z + parent.translation.z, 0.0F };
+		result.scale = vector4{ local.scale.x * parent.scale.x, local.scale.y * parent.scale.y, local.scale.z * parent.scale.z, 0.0F };
+		return result;
+	}
+
+	static qvv compute_reference(const track_array& tracks, uint32_t track_index, size_t sample_index)
+	{
+		const qvv& local = tracks[track_index][sample_index].transform;
+		const uint32_t parent_index = tracks[track_index].get_description().transform.parent_index;
+		if (parent_index == k_invalid_track_index)
+			return local;
+
+		return qvv_mul(local, compute_reference(tracks, parent_index, sample_index));
+	}
+
+	static sample make_random_transform(std::mt19937& generator)
+	{
+		std::uniform_real_distribution<float> unit_distribution(-1.0F, 1.0F);
+		std::uniform_real_distribution<float> scale_distribution(0.5F, 2.0F);
+
+		quat rotation = quat{ unit_distribution(generator), unit_distribution(generator), unit_distribution(generator), unit_distribution(generator) };
+		const float length = std::sqrt(rotation.x * rotation.x + rotation.y * rotation.y + rotation.z * rotation.z + rotation.w * rotation.w);
+		rotation = quat{ rotation.x / length, rotation.y / length, rotation.z / length, rotation.w / length };
+
+		sample sample_;
+		std::memset(&sample_, 0, sizeof(sample_));
+		sample_.transform.rotation = rotation;
+		sample_.transform.translation = vector4{ unit_distribution(generator), unit_distribution(generator), unit_distribution(generator), 0.0F };
+		sample_.transform.scale = vector4{ scale_distribution(generator), scale_distribution(generator), scale_distribution(generator), 0.0F };
+		return sample_;
+	}
+
+	static track_array make_hierarchy(const uint32_t* parent_indices, uint32_t num_tracks)
+	{
+		std::mt19937 generator(42);
+
+		metadata_t metadata;
+		track_array tracks("clip", metadata);
+		for (uint32_t track_index = 0; track_index < num_tracks; ++track_index)
+		{
+			track track_(sample_type::qvv, 30.0F, ("bone" + std::to_string(track_index)).c_str());
+
+			track_description& desc = track_.get_description();
+			std::memset(&desc, 0, sizeof(desc));
+			desc.transform.output_index = track_index;
+			desc.transform.parent_index = parent_indices[track_index];
+
+			for (size_t sample_index = 0; sample_index < k_num_samples; ++sample_index)
+				track_.emplace_back(make_random_transform(generator));
+
+			tracks.emplace_back(std::move(track_));
+		}
+
+		return tracks;
+	}
+
+	static bool is_near(float value, float reference)
+	{
+		return std::fabs(value - reference) <= 0.00001F * std::max(1.0F, std::fabs(reference));
+	}
+
+	static bool is_near(const qvv& transform, const qvv& reference)
+	{
+		return is_near(transform.rotation.x, reference.rotation.x) && is_near(transform.rotation.y, reference.rotation.y)
+			&& is_near(transform.rotation.z, reference.rotation.z) && is_near(transform.rotation.w, reference.rotation.w)
+			&& is_near(transform.translation.x, reference.translation.x) && is_near(transform.translation.y, reference.translation.y)
+			&& is_near(transform.translation.z, reference.translation.z)
+			&& is_near(transform.scale.x, reference.scale.x) && is_near(transform.scale.y, reference.scale.y) && is_near(transform.scale.z, reference.scale.z);
+	}
+}
+
+TEST_CASE(object_space_matches_reference)
+{
+	const track_array tracks = make_hierarchy(k_parent_indices, k_num_tracks);
+
+	object_space_transforms transforms;
+	CHECK(compute_object_space(tracks, transforms));
+	CHECK(transforms.get_num_transforms() == k_num_tracks);
+	CHECK(transforms.get_num_samples() == k_num_samples);
+
+	size_t num_mismatches = 0;
+	for (uint32_t track_index = 0; track_index < k_num_tracks; ++track_index)
+	{
+		for (size_t sample_index = 0; sample_index < k_num_samples; ++sample_index)
+			num_mismatches += is_near(transforms.get_transform(track_index, sample_index), compute_reference(tracks, track_index, sample_index)) ? 0 : 1;
+	}
+
+	CHECK(num_mismatches == 0);
+
+	// Components are stored per transform, contiguous over samples
+	const float* translation_x = transforms.get_component(qvv_component::translation_x, 4);
+	for (size_t sample_index = 0; sample_index < k_num_samples; ++sample_index)
+		CHECK(translation_x[sample_index] == transforms.get_transform(4, sample_index).translation.x);
+}
+
+TEST_CASE(object_space_pose_matches_reference)
+{
+	const track_array tracks = make_hierarchy(k_parent_indices, k_num_tracks);
+
+	object_space_transforms clip_transforms;
+	CHECK(compute_object_space(tracks, clip_transforms));
+
+	const size_t sample_indices[] = { 0, 37, k_num_samples - 1 };
+	for (const size_t sample_index : sample_indices)
+	{
+		std::vector<sample> local_pose(k_num_tracks);
+		for (uint32_t track_index = 0; track_index < k_num_tracks; ++track_index)
+			local_pose[track_index] = tracks[track_index][sample_index];
+
+		object_space_transforms transforms;
+		CHECK(compute_object_space(tracks, local_pose.data(), transforms));
+		CHECK(transforms.get_num_transforms() == k_num_tracks);
+		CHECK(transforms.get_num_samples() == 1);
+
+		for (uint32_t track_index = 0; track_index < k_num_tracks; ++track_index)
+		{
+			const qvv transform = transforms.get_transform(track_index, 0);
+			CHECK(is_near(transform, compute_reference(tracks, track_index, sample_index)));
+
+			// Both overloads compose the same way regardless of how the transforms are batched
+			const qvv clip_transform = clip_transforms.get_transform(track_index, sample_index);
+			CHECK(std::memcmp(&transform, &clip_transform, sizeof(qvv)) == 0);
+		}
+	}
+}
+
+TEST_CASE(object_space_rejects_invalid_tracks)
+{
+	object_space_transforms transforms;
+
+	// Only qvv tracks have a hierarchy
+	{
+		metadata_t metadata;
+		track_array tracks("clip", metadata);
+		track track_(sample_type::float3, 30.0F, "values");
+		std::memset(&track_.get_description(), 0, sizeof(track_description));
+		track_.emplace_back(sample());
+		tracks.emplace_back(std::move(track_));
+
+		CHECK(!compute_object_space(tracks, transforms));
+		CHECK(!compute_object_space(tracks, &tracks[0][0], transforms));
+	}
+
+	// Parent cycles and out of range parents
+	{
+		const uint32_t cycle_parent_indices[] = { k_invalid_track_index, 2, 1 };
+		const track_array tracks = make_hierarchy(cycle_parent_indices, 3);
+		const sample local_pose[] = { tracks[0][0], tracks[1][0], tracks[2][0] };
+
+		CHECK(!compute_object_space(tracks, transforms));
+		CHECK(!compute_object_space(tracks, local_pose, transforms));
+	}
+
+	{
+		const uint32_t out_of_range_parent_indices[] = { k_invalid_track_index, 3 };
+		const track_array tracks = make_hierarchy(out_of_range_parent_indices, 2);
+
+		CHECK(!compute_object_space(tracks, transforms));
+	}
+}
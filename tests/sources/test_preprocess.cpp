@@ -0,0 +1,290 @@
+////////////////////////////////////////////////////////////////////////////////
+// The MIT License (MIT)
+//
+// Copyright (c) 2022 Nicholas Frechette
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+////////////////////////////////////////////////////////////////////////////////
+
+#include "test_framework.h"
+
+#include <acl-sjson/metadata.h>
+#include <acl-sjson/preprocess.h>
+#include <acl-sjson/track.h>
+#include <acl-sjson/track_array.h>
+#include <acl-sjson/track_description.h>
+
+#include <cmath>
+#include <cstring>
+
+using namespace acl_sjson;
+
+namespace
+{
+	// Not a multiple of 4, the last block of every pass is partial
+	static constexpr size_t k_num_samples = 10;
+
+	static sample make_transform(const quat& rotation, const vector4& translation)
+	{
+		sample sample_;
+		std::memset(&sample_, 0, sizeof(sample_));
+		sample_.transform.rotation = rotation;
+		sample_.transform.translation = translation;
+		sample_.transform.scale = vector4{ 1.0F, 1.0F, 1.0F, 0.0F };
+		return sample_;
+	}
+
+	static track make_transform_track()
+	{
+		track track_(sample_type::qvv, 30.0F, "bone");
+
+		track_description& desc = track_.get_description();
+		std::memset(&desc, 0, sizeof(desc));
+		desc.transform.parent_index = k_invalid_track_index;
+		desc.transform.default_value = make_transform(quat{ 0.0F, 0.0F, 0.0F, 1.0F }, vector4{ 0.0F, 0.0F, 0.0F, 0.0F }).transform;
+		desc.transform.constant_rotation_threshold_angle = 0.00284714461F;
+		desc.transform.constant_translation_threshold = 0.01F;
+		desc.transform.constant_scale_threshold = 0.00001F;
+		return track_;
+	}
+
+	// A rotation around the Z axis
+	static quat make_rotation(float angle)
+	{
+		return quat{ 0.0F, 0.0F, std::sin(angle * 0.5F), std::cos(angle * 0.5F) };
+	}
+
+	static track_array make_array(track&& track_)
+	{
+		metadata_t metadata;
+		track_array tracks("clip", metadata);
+		tracks.emplace_back(std::move(track_));
+		return tracks;
+	}
+
+	static float get_length(const quat& rotation)
+	{
+		return std::sqrt(rotation.x * rotation.x + rotation.y * rotation.y + rotation.z * rotation.z + rotation.w * rotation.w);
+	}
+}
+
+TEST_CASE(preprocess_makes_rotations_continuous)
+{
+	// Every other rotation is in the opposite hemisphere
+	track track_ = make_transform_track();
+	for (size_t sample_index = 0; sample_index < k_num_samples; ++sample_index)
+	{
+		quat rotation = make_rotation(float(sample_index) * 0.1F);
+		if (sample_index % 2 == 1)
+			rotation = quat{ -rotation.x, -rotation.y, -rotation.z, -rotation.w };
+
+		track_.emplace_back(make_transform(rotation, vector4{ float(sample_index), 0.0F, 0.0F, 0.0F }));
+	}
+
+	track_array tracks = make_array(std::move(track_));
+
+	preprocess_settings settings;
+	settings.snap_constant_sub_tracks = false;
+
+	preprocess_stats stats;
+	preprocess_tracks(tracks, settings, stats);
+	CHECK(stats.num_flipped_rotations == k_num_samples / 2);
+
+	const track& result = tracks[0];
+	for (size_t sample_index = 0; sample_index < k_num_samples; ++sample_index)
+	{
+		const quat expected = make_rotation(float(sample_index) * 0.1F);
+		CHECK(std::memcmp(&result[sample_index].transform.rotation, &expected, sizeof(quat)) == 0);
+	}
+}
+
+TEST_CASE(preprocess_normalizes_rotations)
+{
+	// Rotations within the tolerance are rounding noise and are left as they are
+	const quat noisy_rotation = quat{ 0.0F, 0.0F, 0.0F, 1.0000001F };
+
+	track track_ = make_transform_track();
+	for (size_t sample_index = 0; sample_index < k_num_samples; ++sample_index)
+	{
+		const quat rotation = make_rotation(float(sample_index) * 0.1F);
+		const float scale = sample_index % 3 == 0 ? 1.5F : 1.0F;
+		const quat scaled_rotation = quat{ rotation.x * scale, rotation.y * scale, rotation.z * scale, rotation.w * scale };
+
+		track_.emplace_back(make_transform(sample_index == 1 ? noisy_rotation : scaled_rotation, vector4{ float(sample_index), 0.0F, 0.0F, 0.0F }));
+	}
+
+	track_array tracks = make_array(std::move(track_));
+
+	preprocess_settings settings;
+	settings.snap_constant_sub_tracks = false;
+
+	preprocess_stats stats;
+	preprocess_tracks(tracks, settings, stats);
+	CHECK(stats.num_normalized_rotations == 4);
+
+	const track& result = tracks[0];
+	CHECK(std::memcmp(&result[1].transform.rotation, &noisy_rotation, sizeof(quat)) == 0);
+
+	for (size_t sample_index = 0; sample_index < k_num_samples; sample_index += 3)
+		CHECK(std::fabs(get_length(result[sample_index].transform.rotation) - 1.0F) < 0.000001F);
+}
+
+TEST_CASE(preprocess_flushes_denormals)
+{
+	const float denormal = 1.0e-40F;
+
+	track track_(sample_type::float3, 30.0F, "values");
+	std::memset(&track_.get_description(), 0, sizeof(track_description));
+	for (size_t sample_index = 0; sample_index < k_num_samples; ++sample_index)
+	{
+		sample sample_;
+		std::memset(&sample_, 0, sizeof(sample_));
+		sample_.f3 = float3{ denormal, -denormal, float(sample_index) };
+		track_.emplace_back(std::move(sample_));
+	}
+
+	track_array tracks = make_array(std::move(track_));
+
+	preprocess_stats stats;
+	preprocess_tracks(tracks, preprocess_settings(), stats);
+	CHECK(stats.num_flushed_denormals == k_num_samples * 2);
+
+	// The sign is retained
+	const track& result = tracks[0];
+	for (size_t sample_index = 0; sample_index < k_num_samples; ++sample_index)
+	{
+		CHECK(result[sample_index].f3.x == 0.0F && !std::signbit(result[sample_index].f3.x));
+		CHECK(result[sample_index].f3.y == 0.0F && std::signbit(result[sample_index].f3.y));
+		CHECK(result[sample_index].f3.z == float(sample_index));
+	}
+}
+
+TEST_CASE(preprocess_ignores_padding)
+{
+	// The w component of translations is padding, it is neither flushed nor counted
+	track track_ = make_transform_track();
+	for (size_t sample_index = 0; sample_index < k_num_samples; ++sample_index)
+		track_.emplace_back(make_transform(make_rotation(float(sample_index) * 0.1F), vector4{ float(sample_index), 0.0F, 0.0F, 1.0e-40F }));
+
+	track_array tracks = make_array(std::move(track_));
+
+	preprocess_stats stats;
+	preprocess_tracks(tracks, preprocess_settings(), stats);
+	CHECK(stats.num_flushed_denormals == 0);
+
+	const track& result = tracks[0];
+	CHECK(result[0].transform.translation.w == 1.0e-40F);
+}
+
+TEST_CASE(preprocess_keeps_collapsed_tracks_collapsed)
+{
+	track track_(sample_type::float1, 30.0F, "value");
+	std::memset(&track_.get_description(), 0, sizeof(track_description));
+	for (size_t sample_index = 0; sample_index < k_num_samples; ++sample_index)
+	{
+		sample sample_;
+		std::memset(&sample_, 0, sizeof(sample_));
+		sample_.f1.x = -1.0e-40F;
+		track_.emplace_back(std::move(sample_));
+	}
+
+	track_array tracks = make_array(std::move(track_));
+	CHECK(tracks[0].is_collapsed());
+
+	// Every repeated sample counts
+	preprocess_stats stats;
+	preprocess_tracks(tracks, preprocess_settings(), stats);
+	CHECK(stats.num_flushed_denormals == k_num_samples);
+
+	const track& result = tracks[0];
+	CHECK(result.is_collapsed());
+	CHECK(result.get_num_samples() == k_num_samples);
+	CHECK(result[k_num_samples - 1].f1.x == 0.0F && std::signbit(result[k_num_samples - 1].f1.x));
+}
+
+TEST_CASE(preprocess_snaps_constant_sub_tracks)
+{
+	// The translation range is within the threshold, it snaps to the center of the range
+	track track_ = make_transform_track();
+	for (size_t sample_index = 0; sample_index < k_num_samples; ++sample_index)
+		track_.emplace_back(make_transform(quat{ 0.0F, 0.0F, 0.0F, 1.0F }, vector4{ 5.0F + float(sample_index) * 0.001F, 2.0F, 0.0F, 0.0F }));
+
+	track_array tracks = make_array(std::move(track_));
+
+	preprocess_stats stats;
+	preprocess_tracks(tracks, preprocess_settings(), stats);
+	CHECK(stats.num_constant_sub_tracks == 1);
+	CHECK(stats.num_default_sub_tracks == 0);
+	CHECK(stats.num_collapsed_tracks == 1);
+
+	const track& result = tracks[0];
+	CHECK(result.is_collapsed());
+	CHECK(std::fabs(result[0].transform.translation.x - 5.0045F) < 0.00001F);
+	CHECK(result[0].transform.translation.y == 2.0F);
+}
+
+TEST_CASE(preprocess_snaps_to_default_values)
+{
+	// Every translation is within the threshold of the default value, it is used exactly
+	track track_ = make_transform_track();
+	track_.get_description().transform.default_value.translation = vector4{ 5.0F, 2.0F, 0.0F, 0.0F };
+	for (size_t sample_index = 0; sample_index < k_num_samples; ++sample_index)
+		track_.emplace_back(make_transform(make_rotation(float(sample_index) * 0.1F), vector4{ 5.0F + float(sample_index) * 0.001F, 2.0F, 0.0F, 0.0F }));
+
+	track_array tracks = make_array(std::move(track_));
+
+	preprocess_stats stats;
+	preprocess_tracks(tracks, preprocess_settings(), stats);
+	CHECK(stats.num_default_sub_tracks == 1);
+	CHECK(stats.num_constant_sub_tracks == 0);
+
+	// Rotations vary beyond their threshold, the track remains animated
+	const track& result = tracks[0];
+	CHECK(stats.num_collapsed_tracks == 0);
+	CHECK(!result.is_collapsed());
+
+	for (size_t sample_index = 0; sample_index < k_num_samples; ++sample_index)
+	{
+		CHECK(result[sample_index].transform.translation.x == 5.0F);
+		CHECK(result[sample_index].transform.translation.y == 2.0F);
+
+		const quat expected = make_rotation(float(sample_index) * 0.1F);
+		CHECK(std::memcmp(&result[sample_index].transform.rotation, &expected, sizeof(quat)) == 0);
+	}
+}
+
+TEST_CASE(preprocess_only_flushes_non_finite_tracks)
+{
+	const quat scaled_rotation = quat{ 0.0F, 0.0F, 0.0F, 2.0F };
+
+	track track_ = make_transform_track();
+	for (size_t sample_index = 0; sample_index < k_num_samples; ++sample_index)
+		track_.emplace_back(make_transform(scaled_rotation, vector4{ sample_index == 3 ? NAN : 1.0e-40F, 0.0F, 0.0F, 0.0F }));
+
+	track_array tracks = make_array(std::move(track_));
+
+	preprocess_stats stats;
+	preprocess_tracks(tracks, preprocess_settings(), stats);
+	CHECK(stats.num_flushed_denormals == k_num_samples - 1);
+	CHECK(stats.num_normalized_rotations == 0);
+
+	const track& result = tracks[0];
+	CHECK(std::memcmp(&result[0].transform.rotation, &scaled_rotation, sizeof(quat)) == 0);
+	CHECK(std::isnan(result[3].transform.translation.x));
+}
@@ -0,0 +1,103 @@
+////////////////////////////////////////////////////////////////////////////////
+// The MIT License (MIT)
+//
+// Copyright (c) 2022 Nicholas Frechette
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+////////////////////////////////////////////////////////////////////////////////
+
+#include "test_framework.h"
+
+#include <acl-sjson/metadata.h>
+#include <acl-sjson/resample.h>
+#include <acl-sjson/track.h>
+#include <acl-sjson/track_array.h>
+
+#include <cstring>
+#include <functional>
+
+using namespace acl_sjson;
+
+namespace
+{
+	// A clip with a single float1 track whose value at every frame is provided
+	static void make_clip(float sample_rate, size_t num_samples, const std::function<float(size_t)>& get_value, track_array& out_tracks)
+	{
+		metadata_t metadata;
+		track_array tracks("clip", metadata);
+
+		track track_(sample_type::float1, sample_rate, "value");
+		for (size_t sample_index = 0; sample_index < num_samples; ++sample_index)
+		{
+			sample sample_;
+			std::memset(&sample_, 0, sizeof(sample_));
+			sample_.f1.x = get_value(sample_index);
+			track_.emplace_back(std::move(sample_));
+		}
+
+		tracks.emplace_back(std::move(track_));
+		out_tracks = std::move(tracks);
+	}
+}
+
+TEST_CASE(native_sample_rate_of_duplicated_frames)
+{
+	// A 30 FPS animation captured at 120 FPS
+	track_array tracks;
+	make_clip(120.0F, 121, [](size_t sample_index) { return float(sample_index / 4); }, tracks);
+
+	CHECK(find_native_sample_rate(tracks) == 30.0F);
+}
+
+TEST_CASE(native_sample_rate_needs_enough_changes)
+{
+	// Only two frames change, a mostly static clip isn't a 3 FPS animation
+	track_array tracks;
+	make_clip(120.0F, 121, [](size_t sample_index) { return sample_index < 40 ? 0.0F : (sample_index < 80 ? 1.0F : 2.0F); }, tracks);
+
+	CHECK(find_native_sample_rate(tracks) == 120.0F);
+}
+
+TEST_CASE(native_sample_rate_retains_odd_frames)
+{
+	// A one frame blip at frames 3 and 4, resampling at 60 FPS would drop frame 3 and 5 back to back
+	track_array tracks;
+	make_clip(120.0F, 121, [](size_t sample_index) { return sample_index == 3 || sample_index == 4 ? 1.0F : 0.0F; }, tracks);
+
+	CHECK(find_native_sample_rate(tracks) == 120.0F);
+
+	// The same blip repeated every 8 frames changes at a consistent phase that resampling does not keep
+	make_clip(120.0F, 121, [](size_t sample_index) { return (sample_index % 8) == 3 || (sample_index % 8) == 4 ? 1.0F : 0.0F; }, tracks);
+
+	CHECK(find_native_sample_rate(tracks) == 120.0F);
+}
+
+TEST_CASE(native_sample_rate_with_tolerance)
+{
+	// Noise within the tolerance doesn't hide duplication but drift across a block does
+	track_array tracks;
+	make_clip(120.0F, 121, [](size_t sample_index) { return float(sample_index / 4) + float(sample_index % 2) * 0.0001F; }, tracks);
+
+	CHECK(find_native_sample_rate(tracks) == 120.0F);
+	CHECK(find_native_sample_rate(tracks, 0.001F) == 30.0F);
+
+	make_clip(120.0F, 121, [](size_t sample_index) { return float(sample_index / 4) + float(sample_index % 4) * 0.0008F; }, tracks);
+
+	CHECK(find_native_sample_rate(tracks, 0.001F) == 60.0F);
+}
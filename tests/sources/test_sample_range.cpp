@@ -0,0 +1,160 @@
+////////////////////////////////////////////////////////////////////////////////
+// The MIT License (MIT)
+//
+// Copyright (c) 2022 Nicholas Frechette
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+////////////////////////////////////////////////////////////////////////////////
+
+#include "test_framework.h"
+
+#include <acl-sjson/metadata.h>
+#include <acl-sjson/sample_range.h>
+#include <acl-sjson/track.h>
+#include <acl-sjson/track_array.h>
+#include <acl-sjson/track_description.h>
+
+#include <cstring>
+#include <limits>
+
+using namespace acl_sjson;
+
+namespace
+{
+	static constexpr float k_sample_rate = 30.0F;
+	static constexpr size_t k_num_samples = 11;
+
+	static bool is_range(float start_time, float end_time, size_t first_sample_index, size_t num_samples)
+	{
+		sample_range range;
+		return get_sample_range(k_sample_rate, k_num_samples, start_time, end_time, range)
+			&& range.first_sample_index == first_sample_index && range.num_samples == num_samples;
+	}
+
+	static bool is_empty_range(float start_time, float end_time)
+	{
+		sample_range range;
+		return !get_sample_range(k_sample_rate, k_num_samples, start_time, end_time, range);
+	}
+
+	static track make_track(const char* name, bool is_constant)
+	{
+		track track_(sample_type::float1, k_sample_rate, name);
+		std::memset(&track_.get_description(), 0, sizeof(track_description));
+		for (size_t sample_index = 0; sample_index < k_num_samples; ++sample_index)
+		{
+			sample sample_;
+			std::memset(&sample_, 0, sizeof(sample_));
+			sample_.f1.x = is_constant ? 1.0F : float(sample_index);
+			track_.emplace_back(std::move(sample_));
+		}
+
+		return track_;
+	}
+
+	static track_array make_array()
+	{
+		metadata_t metadata;
+		track_array tracks("clip", metadata);
+		tracks.emplace_back(make_track("animated", false));
+		tracks.emplace_back(make_track("constant", true));
+		tracks[1].set_output_index(1);
+		return tracks;
+	}
+}
+
+TEST_CASE(sample_range_within_clip)
+{
+	const float duration = float(k_num_samples - 1) / k_sample_rate;
+
+	CHECK(is_range(0.0F, duration, 0, k_num_samples));
+	CHECK(is_range(1.0F / k_sample_rate, 3.0F / k_sample_rate, 1, 3));
+	CHECK(is_range(4.0F / k_sample_rate, 4.0F / k_sample_rate, 4, 1));
+
+	// Times between samples only retain the samples within the range
+	CHECK(is_range(1.5F / k_sample_rate, 3.5F / k_sample_rate, 2, 2));
+
+	// Times within rounding error of a sample include it
+	CHECK(is_range((1.0F / k_sample_rate) + 0.000001F, (3.0F / k_sample_rate) - 0.000001F, 1, 3));
+	CHECK(is_range(0.1F, 0.2F, 3, 4));
+}
+
+TEST_CASE(sample_range_outside_clip)
+{
+	// Ranges are clamped to the clip
+	CHECK(is_range(-1.0F, 2.0F / k_sample_rate, 0, 3));
+	CHECK(is_range(8.0F / k_sample_rate, 100.0F, 8, 3));
+	CHECK(is_range(8.0F / k_sample_rate, std::numeric_limits<float>::infinity(), 8, 3));
+
+	// Ranges entirely before or after the clip
+	CHECK(is_empty_range(-1.0F, -0.5F));
+	CHECK(is_empty_range(1.0F, 2.0F));
+	CHECK(is_empty_range(11.0F / k_sample_rate, 12.0F / k_sample_rate));
+}
+
+TEST_CASE(sample_range_invalid)
+{
+	const float nan = std::numeric_limits<float>::quiet_NaN();
+
+	// Inverted ranges and ranges between two samples are empty
+	CHECK(is_empty_range(0.2F, 0.1F));
+	CHECK(is_empty_range(1.25F / k_sample_rate, 1.75F / k_sample_rate));
+
+	CHECK(is_empty_range(nan, 0.1F));
+	CHECK(is_empty_range(0.0F, nan));
+
+	// The end of the range can be unbounded but its start must be a time
+	CHECK(is_empty_range(-std::numeric_limits<float>::infinity(), 0.1F));
+	CHECK(is_empty_range(std::numeric_limits<float>::infinity(), std::numeric_limits<float>::infinity()));
+
+	// Clips without samples or with an invalid sample rate
+	sample_range range;
+	CHECK(!get_sample_range(k_sample_rate, 0, 0.0F, 1.0F, range));
+	CHECK(!get_sample_range(0.0F, k_num_samples, 0.0F, 1.0F, range));
+	CHECK(!get_sample_range(-30.0F, k_num_samples, 0.0F, 1.0F, range));
+	CHECK(!get_sample_range(nan, k_num_samples, 0.0F, 1.0F, range));
+}
+
+TEST_CASE(sample_range_extract)
+{
+	track_array tracks = make_array();
+	CHECK(extract_range(tracks, 2.0F / k_sample_rate, 5.0F / k_sample_rate));
+
+	CHECK(tracks.get_num_tracks() == 2);
+	CHECK(tracks.get_num_samples_per_track() == 4);
+	CHECK(std::strcmp(tracks.get_name(), "clip") == 0);
+
+	// Samples are retained as they are, from the first sample in the range
+	const track& animated_track = tracks[0];
+	for (size_t sample_index = 0; sample_index < 4; ++sample_index)
+		CHECK(animated_track[sample_index].f1.x == float(sample_index + 2));
+
+	// Constant tracks remain collapsed, descriptions and names are retained
+	const track& constant_track = tracks[1];
+	CHECK(constant_track.is_collapsed());
+	CHECK(constant_track.get_num_samples() == 4);
+	CHECK(constant_track.get_output_index() == 1);
+	CHECK(tracks.find("constant") == 1);
+
+	// Empty ranges leave the tracks unchanged
+	CHECK(!extract_range(tracks, 1.0F, 2.0F));
+	CHECK(!extract_range(tracks, 0.1F, 0.0F));
+	CHECK(tracks.get_num_samples_per_track() == 4);
+	CHECK(tracks[0][0].f1.x == 2.0F);
+}
@@ -0,0 +1,200 @@
+////////////////////////////////////////////////////////////////////////////////
+// The MIT License (MIT)
+//
+// Copyright (c) 2022 Nicholas Frechette
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+////////////////////////////////////////////////////////////////////////////////
+
+#include "test_framework.h"
+
+#include "simd_kernels.h"
+
+#include <acl-sjson/cpu_dispatch.h>
+#include <acl-sjson/sample.h>
+
+#include <cstdint>
+#include <cstring>
+#include <random>
+#include <vector>
+
+using namespace acl_sjson;
+
+namespace
+{
+	// Odd so that every kernel also processes a partial block
+	static constexpr size_t k_num_samples = 1021;
+
+	static float make_float(uint32_t bits)
+	{
+		float value;
+		std::memcpy(&value, &bits, sizeof(value));
+		return value;
+	}
+
+	// Regular values mixed with NaN, infinities, zeros, denormals, and values that overflow once squared
+	static float make_value(std::mt19937& generator)
+	{
+		const uint32_t special_values[] =
+		{
+			0x7FC00000, 0xFFC00000, 0x7F800001, 0x7FFFFFFF,		// NaN, quiet and signaling, both signs
+			0x7F800000, 0xFF800000,								// Infinities
+			0x00000000, 0x80000000,								// Zeros
+			0x00000001, 0x807FFFFF, 0x00400000,					// Denormals
+			0x00800000, 0x80800000,								// Smallest normals
+			0x5F800000, 0xDF800000, 0x5F7FFFFF, 0x7F7FFFFF,		// Around 2^64 and the largest value
+		};
+		const uint32_t num_special_values = sizeof(special_values) / sizeof(special_values[0]);
+
+		const uint32_t choice = generator() % 4;
+		if (choice == 0)
+			return make_float(special_values[generator() % num_special_values]);
+		else if (choice == 1)
+			return make_float(generator());		// Any bit pattern
+		else
+			return std::uniform_real_distribution<float>(-100.0F, 100.0F)(generator);
+	}
+
+	static std::vector<sample> make_samples(std::mt19937& generator)
+	{
+		std::vector<sample> samples(k_num_samples);
+		for (sample& sample_ : samples)
+		{
+			float* values = &sample_.f1.x;
+			for (uint32_t component_index = 0; component_index < 12; ++component_index)
+				values[component_index] = make_value(generator);
+		}
+
+		return samples;
+	}
+
+	// Identical samples, small differences, and unrelated values, component by component
+	static std::vector<sample> make_other_samples(const std::vector<sample>& samples, std::mt19937& generator)
+	{
+		std::vector<sample> other_samples = samples;
+		for (sample& sample_ : other_samples)
+		{
+			if (generator() % 4 == 0)
+				continue;
+
+			float* values = &sample_.f1.x;
+			for (uint32_t component_index = 0; component_index < 12; ++component_index)
+			{
+				const uint32_t choice = generator() % 4;
+				if (choice == 1)
+					values[component_index] += std::uniform_real_distribution<float>(-0.2F, 0.2F)(generator);
+				else if (choice == 2)
+					values[component_index] *= std::uniform_real_distribution<float>(0.98F, 1.02F)(generator);
+				else if (choice == 3)
+					values[component_index] = make_value(generator);
+			}
+		}
+
+		return other_samples;
+	}
+
+	// Returns every kernel the CPU and this build support, the scalar reference first
+	static std::vector<const simd_kernels*> get_supported_kernels()
+	{
+		const cpu_isa supported_isa = get_supported_cpu_isa();
+
+		const simd_kernels* kernels[] = { get_scalar_kernels(), get_sse2_kernels(), get_avx2_kernels(), get_avx512_kernels() };
+		const cpu_isa isas[] = { cpu_isa::scalar, cpu_isa::sse2, cpu_isa::avx2, cpu_isa::avx512 };
+
+		std::vector<const simd_kernels*> result;
+		for (size_t isa_index = 0; isa_index < 4; ++isa_index)
+		{
+			if (kernels[isa_index] != nullptr && isas[isa_index] <= supported_isa)
+				result.push_back(kernels[isa_index]);
+		}
+
+		return result;
+	}
+
+	static bool are_classes_equal(const sample_classes& lhs, const sample_classes& rhs)
+	{
+		return lhs.non_finite_mask == rhs.non_finite_mask && lhs.denormal_mask == rhs.denormal_mask && lhs.overflowing_mask == rhs.overflowing_mask
+			&& lhs.zero_mask == rhs.zero_mask && lhs.negative_mask == rhs.negative_mask;
+	}
+}
+
+TEST_CASE(simd_kernels_classify_like_scalar)
+{
+	const std::vector<const simd_kernels*> kernels = get_supported_kernels();
+	CHECK(!kernels.empty() && kernels[0] == get_scalar_kernels());
+
+	std::mt19937 generator(1234);
+	const std::vector<sample> samples = make_samples(generator);
+
+	std::vector<sample_classes> reference_classes(k_num_samples);
+	get_scalar_kernels()->classify_samples(samples.data(), k_num_samples, reference_classes.data());
+
+	for (size_t kernel_index = 1; kernel_index < kernels.size(); ++kernel_index)
+	{
+		std::vector<sample_classes> classes(k_num_samples);
+		kernels[kernel_index]->classify_samples(samples.data(), k_num_samples, classes.data());
+
+		size_t num_mismatches = 0;
+		for (size_t sample_index = 0; sample_index < k_num_samples; ++sample_index)
+			num_mismatches += are_classes_equal(classes[sample_index], reference_classes[sample_index]) ? 0 : 1;
+
+		CHECK(num_mismatches == 0);
+	}
+}
+
+TEST_CASE(simd_kernels_compare_like_scalar)
+{
+	const std::vector<const simd_kernels*> kernels = get_supported_kernels();
+
+	std::mt19937 generator(5678);
+	const std::vector<sample> lhs = make_samples(generator);
+	const std::vector<sample> rhs = make_other_samples(lhs, generator);
+
+	const sample_type types[] = { sample_type::float1, sample_type::float2, sample_type::float3, sample_type::float4, sample_type::quat, sample_type::qvv };
+	const float tolerances[][2] = { { 0.0F, 0.0F }, { 0.1F, 0.0F }, { 0.0F, 0.01F }, { 0.05F, 0.005F } };
+	const size_t strides[][2] = { { 1, 1 }, { 0, 1 }, { 1, 0 } };
+
+	for (sample_type type : types)
+	{
+		const uint32_t component_mask = static_cast<uint32_t>(get_component_mask(type));
+
+		for (const float* tolerance : tolerances)
+		{
+			for (const size_t* stride : strides)
+			{
+				std::vector<float> reference_errors(k_num_samples);
+				std::vector<uint8_t> reference_is_match(k_num_samples);
+				get_scalar_kernels()->compare_samples(lhs.data(), stride[0], rhs.data(), stride[1], k_num_samples, component_mask,
+					tolerance[0], tolerance[1], reference_errors.data(), reference_is_match.data());
+
+				for (size_t kernel_index = 1; kernel_index < kernels.size(); ++kernel_index)
+				{
+					std::vector<float> errors(k_num_samples);
+					std::vector<uint8_t> is_match(k_num_samples);
+					kernels[kernel_index]->compare_samples(lhs.data(), stride[0], rhs.data(), stride[1], k_num_samples, component_mask,
+						tolerance[0], tolerance[1], errors.data(), is_match.data());
+
+					// Errors must match bit for bit
+					CHECK(std::memcmp(errors.data(), reference_errors.data(), k_num_samples * sizeof(float)) == 0);
+					CHECK(is_match == reference_is_match);
+				}
+			}
+		}
+	}
+}
@@ -0,0 +1,280 @@
+////////////////////////////////////////////////////////////////////////////////
+// The MIT License (MIT)
+//
+// Copyright (c) 2022 Nicholas Frechette
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+////////////////////////////////////////////////////////////////////////////////
+
+#include "test_framework.h"
+
+#include <acl-sjson/api_v20.h>
+#include <acl-sjson/api_v21.h>
+#include <acl-sjson/hash.h>
+#include <acl-sjson/metadata.h>
+#include <acl-sjson/sjson_writer.h>
+#include <acl-sjson/track.h>
+#include <acl-sjson/track_array.h>
+#include <acl-sjson/track_description.h>
+
+#include <cstdio>
+#include <cstring>
+
+using namespace acl_sjson;
+
+namespace
+{
+	static constexpr size_t k_num_samples = 17;
+
+	// Awkward values that need every significant digit, large and tiny magnitudes
+	static float get_value(size_t sample_index, size_t component_index)
+	{
+		const float values[] = { 0.1F, -1.0F / 3.0F, 3.40282347e+38F, 1.0e25F, 1.17549435e-38F, 123456792.0F, -0.0F, 2.0F / 3.0F, 1.0e-7F };
+		const size_t num_values = sizeof(values) / sizeof(values[0]);
+		return values[(sample_index + component_index * 5) % num_values] * float(sample_index + 1);
+	}
+
+	static track_array make_transform_clip(acl_version version)
+	{
+		metadata_t metadata;
+		metadata.version = version;
+		track_array tracks("transforms", metadata);
+
+		for (uint32_t track_index = 0; track_index < 2; ++track_index)
+		{
+			track track_(sample_type::qvv, 30.0F, track_index == 0 ? "root" : "child");
+
+			track_description& desc = track_.get_description();
+			std::memset(&desc, 0, sizeof(desc));
+			desc.transform.output_index = track_index;
+			desc.transform.parent_index = track_index == 0 ? k_invalid_track_index : 0;
+			desc.transform.precision = 0.0123F;
+			desc.transform.shell_distance = 7.5F;
+			desc.transform.constant_rotation_threshold_angle = 0.00284714461F;
+			desc.transform.constant_translation_threshold = 0.001F;
+			desc.transform.constant_scale_threshold = 0.00001F;
+			desc.transform.default_value.rotation = quat{ 0.0F, 0.0F, 0.70710677F, 0.70710677F };
+			desc.transform.default_value.translation = vector4{ 1.5F, -2.25F, 0.1F, 0.0F };
+			desc.transform.default_value.scale = vector4{ 1.0F, 2.0F, 1.0F, 0.0F };
+
+			for (size_t sample_index = 0; sample_index < k_num_samples; ++sample_index)
+			{
+				sample sample_;
+				std::memset(&sample_, 0, sizeof(sample_));
+				sample_.transform.rotation = quat{ 0.5F, -0.5F, 0.5F, get_value(sample_index, track_index) };
+				sample_.transform.translation = vector4{ get_value(sample_index, 1), get_value(sample_index, 2), get_value(sample_index, 3), 0.0F };
+				sample_.transform.scale = vector4{ 1.0F, get_value(sample_index, 4), 1.0F / 3.0F, 0.0F };
+				track_.emplace_back(std::move(sample_));
+			}
+
+			tracks.emplace_back(std::move(track_));
+		}
+
+		return tracks;
+	}
+
+	static track_array make_scalar_clip(acl_version version)
+	{
+		metadata_t metadata;
+		metadata.version = version;
+		track_array tracks("scalars", metadata);
+
+		for (uint32_t track_index = 0; track_index < 2; ++track_index)
+		{
+			track track_(sample_type::float3, 60.0F, track_index == 0 ? "first" : "second");
+
+			track_description& desc = track_.get_description();
+			std::memset(&desc, 0, sizeof(desc));
+			desc.scalar.output_index = 1 - track_index;
+			desc.scalar.precision = 0.00042F;
+
+			for (size_t sample_index = 0; sample_index < k_num_samples; ++sample_index)
+			{
+				sample sample_;
+				std::memset(&sample_, 0, sizeof(sample_));
+				sample_.f3 = float3{ get_value(sample_index, track_index), get_value(sample_index, 2), get_value(sample_index, 3) };
+				track_.emplace_back(std::move(sample_));
+			}
+
+			tracks.emplace_back(std::move(track_));
+		}
+
+		return tracks;
+	}
+
+	// Writes the tracks as decimals and reads them back with the ACL version they target
+	static bool round_trip(const track_array& tracks, acl_version version, track_array& out_tracks)
+	{
+		const char* filename = "sjson_round_trip.acl.sjson";
+		if (!write_sjson_tracks(filename, tracks, version))
+			return false;
+
+		const bool is_read = version == acl_version::v02_00_00 ? acl_sjson_v20::read_tracks(filename, out_tracks) : acl_sjson_v21::read_tracks(filename, out_tracks);
+		std::remove(filename);
+		return is_read;
+	}
+
+	static bool is_bit_equal(float lhs, float rhs)
+	{
+		return std::memcmp(&lhs, &rhs, sizeof(float)) == 0;
+	}
+
+	static bool are_samples_bit_equal(const track_array& lhs, const track_array& rhs)
+	{
+		if (lhs.get_num_tracks() != rhs.get_num_tracks() || lhs.get_sample_rate() != rhs.get_sample_rate())
+			return false;
+
+		for (size_t track_index = 0; track_index < lhs.get_num_tracks(); ++track_index)
+		{
+			const track& lhs_track = lhs[track_index];
+			const track& rhs_track = rhs[track_index];
+			if (lhs_track.get_type() != rhs_track.get_type() || lhs_track.get_num_samples() != rhs_track.get_num_samples())
+				return false;
+
+			if (std::strcmp(lhs_track.get_name(), rhs_track.get_name()) != 0)
+				return false;
+
+			const size_t sample_size = get_sample_size(lhs_track.get_type());
+			for (size_t sample_index = 0; sample_index < lhs_track.get_num_samples(); ++sample_index)
+			{
+				if (std::memcmp(&lhs_track[sample_index], &rhs_track[sample_index], sample_size) != 0)
+					return false;
+			}
+		}
+
+		return true;
+	}
+
+	static bool is_identity(const qvv& transform)
+	{
+		const qvv identity = { quat{ 0.0F, 0.0F, 0.0F, 1.0F }, vector4{ 0.0F, 0.0F, 0.0F, 0.0F }, vector4{ 1.0F, 1.0F, 1.0F, 0.0F } };
+		return std::memcmp(&transform.rotation, &identity.rotation, sizeof(quat)) == 0
+			&& std::memcmp(&transform.translation, &identity.translation, sizeof(float) * 3) == 0
+			&& std::memcmp(&transform.scale, &identity.scale, sizeof(float) * 3) == 0;
+	}
+
+	static void check_transform_round_trip(acl_version version)
+	{
+		const track_array tracks = make_transform_clip(version);
+
+		track_array read_tracks;
+		CHECK(round_trip(tracks, version, read_tracks));
+		CHECK(are_samples_bit_equal(tracks, read_tracks));
+
+		for (size_t track_index = 0; track_index < read_tracks.get_num_tracks() && track_index < tracks.get_num_tracks(); ++track_index)
+		{
+			const transform_track_description& desc = tracks[track_index].get_description().transform;
+			const transform_track_description& read_desc = read_tracks[track_index].get_description().transform;
+
+			CHECK(read_desc.output_index == desc.output_index);
+			CHECK(read_desc.parent_index == desc.parent_index);
+			CHECK(is_bit_equal(read_desc.precision, desc.precision));
+			CHECK(is_bit_equal(read_desc.shell_distance, desc.shell_distance));
+
+			if (version == acl_version::v02_00_00)
+			{
+				// ACL 2.0 has no bind pose but keeps the constant thresholds
+				CHECK(is_bit_equal(read_desc.constant_rotation_threshold_angle, desc.constant_rotation_threshold_angle));
+				CHECK(is_bit_equal(read_desc.constant_translation_threshold, desc.constant_translation_threshold));
+				CHECK(is_bit_equal(read_desc.constant_scale_threshold, desc.constant_scale_threshold));
+				CHECK(is_identity(read_desc.default_value));
+			}
+			else
+			{
+				CHECK(std::memcmp(&read_desc.default_value.rotation, &desc.default_value.rotation, sizeof(quat)) == 0);
+				CHECK(std::memcmp(&read_desc.default_value.translation, &desc.default_value.translation, sizeof(float) * 3) == 0);
+				CHECK(std::memcmp(&read_desc.default_value.scale, &desc.default_value.scale, sizeof(float) * 3) == 0);
+			}
+		}
+	}
+
+	static void check_scalar_round_trip(acl_version version)
+	{
+		const track_array tracks = make_scalar_clip(version);
+
+		track_array read_tracks;
+		CHECK(round_trip(tracks, version, read_tracks));
+		CHECK(are_samples_bit_equal(tracks, read_tracks));
+
+		for (size_t track_index = 0; track_index < read_tracks.get_num_tracks() && track_index < tracks.get_num_tracks(); ++track_index)
+		{
+			const scalar_track_description& desc = tracks[track_index].get_description().scalar;
+			const scalar_track_description& read_desc = read_tracks[track_index].get_description().scalar;
+
+			CHECK(read_desc.output_index == desc.output_index);
+			CHECK(is_bit_equal(read_desc.precision, desc.precision));
+		}
+	}
+}
+
+TEST_CASE(sjson_round_trip_v20)
+{
+	check_transform_round_trip(acl_version::v02_00_00);
+	check_scalar_round_trip(acl_version::v02_00_00);
+}
+
+TEST_CASE(sjson_round_trip_v21)
+{
+	check_transform_round_trip(acl_version::v02_01_00);
+	check_scalar_round_trip(acl_version::v02_01_00);
+}
+
+TEST_CASE(hash_matches_between_sjson_and_binary)
+{
+	const acl_version versions[] = { acl_version::v02_00_00, acl_version::v02_01_00 };
+	for (acl_version version : versions)
+	{
+		// Padding is not stored in SJSON files, binary files keep whatever the writer left there
+		track_array tracks = make_transform_clip(version);
+		for (size_t track_index = 0; track_index < tracks.get_num_tracks(); ++track_index)
+		{
+			sample* samples = tracks[track_index].get_mutable_samples();
+			for (size_t sample_index = 0; sample_index < tracks[track_index].get_num_samples(); ++sample_index)
+			{
+				samples[sample_index].transform.translation.w = 3.0F;
+				samples[sample_index].transform.scale.w = -1.0F;
+			}
+		}
+
+		const char* sjson_filename = "hash_round_trip.acl.sjson";
+		const char* binary_filename = "hash_round_trip.acl";
+		const bool is_v20 = version == acl_version::v02_00_00;
+
+		CHECK(write_sjson_tracks(sjson_filename, tracks, version));
+		CHECK(is_v20 ? acl_sjson_v20::write_tracks(binary_filename, tracks) : acl_sjson_v21::write_tracks(binary_filename, tracks));
+
+		track_array sjson_tracks;
+		track_array binary_tracks;
+		CHECK(is_v20 ? acl_sjson_v20::read_tracks(sjson_filename, sjson_tracks) : acl_sjson_v21::read_tracks(sjson_filename, sjson_tracks));
+		CHECK(is_v20 ? acl_sjson_v20::read_tracks(binary_filename, binary_tracks) : acl_sjson_v21::read_tracks(binary_filename, binary_tracks));
+
+		CHECK(hash_tracks(sjson_tracks) == hash_tracks(tracks));
+		CHECK(hash_tracks(binary_tracks) == hash_tracks(tracks));
+
+		std::remove(sjson_filename);
+		std::remove(binary_filename);
+	}
+}
+
+TEST_CASE(sjson_writer_rejects_unknown_version)
+{
+	const track_array tracks = make_scalar_clip(acl_version::unknown);
+
+	CHECK(!write_sjson_tracks("sjson_round_trip.acl.sjson", tracks, acl_version::unknown));
+}
@@ -0,0 +1,104 @@
+////////////////////////////////////////////////////////////////////////////////
+// The MIT License (MIT)
+//
+// Copyright (c) 2022 Nicholas Frechette
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+////////////////////////////////////////////////////////////////////////////////
+
+#include "test_framework.h"
+
+#include <acl-sjson/sjson_writer.h>
+
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+using namespace acl_sjson;
+
+namespace
+{
+	static std::string format(float value)
+	{
+		char buffer[32];
+		const size_t length = format_shortest_float(value, buffer, sizeof(buffer));
+		return std::string(buffer, length);
+	}
+
+	static bool reads_back(float value)
+	{
+		char buffer[32];
+		if (format_shortest_float(value, buffer, sizeof(buffer)) == 0)
+			return false;
+
+		// Compare the bits, -0.0 must not match 0.0
+		const float parsed_value = std::strtof(buffer, nullptr);
+		return std::memcmp(&parsed_value, &value, sizeof(float)) == 0;
+	}
+}
+
+TEST_CASE(shortest_float_layout)
+{
+	CHECK(format(0.0F) == "0");
+	CHECK(format(-0.0F) == "-0");
+	CHECK(format(1.0F) == "1");
+	CHECK(format(30.0F) == "30");
+	CHECK(format(0.1F) == "0.1");
+	CHECK(format(-1.5F) == "-1.5");
+	CHECK(format(0.0001F) == "0.0001");
+	CHECK(format(0.00001F) == "1e-05");
+	CHECK(format(123456792.0F) == "123456790");
+	CHECK(format(1.0e9F) == "1e+09");
+	CHECK(format(1.0e25F) == "1e+25");
+	CHECK(format(3.40282347e+38F) == "3.4028235e+38");
+	CHECK(format(1.17549435e-38F) == "1.1754944e-38");
+	CHECK(format(1.4e-45F) == "1e-45");
+}
+
+TEST_CASE(shortest_float_reads_back)
+{
+	// Every binade, with mantissas spread evenly and both ends of each binade
+	for (uint32_t exponent = 0; exponent < 255; ++exponent)
+	{
+		for (uint32_t mantissa = 0; mantissa < (1U << 23); mantissa += 4099)
+		{
+			const uint32_t bits = (exponent << 23) | mantissa;
+			float value;
+			std::memcpy(&value, &bits, sizeof(float));
+
+			CHECK(reads_back(value));
+			CHECK(reads_back(-value));
+		}
+
+		const uint32_t last_bits = (exponent << 23) | ((1U << 23) - 1);
+		float last_value;
+		std::memcpy(&last_value, &last_bits, sizeof(float));
+
+		CHECK(reads_back(last_value));
+	}
+}
+
+TEST_CASE(shortest_float_rejects_non_finite)
+{
+	char buffer[32];
+	CHECK(format_shortest_float(std::strtof("inf", nullptr), buffer, sizeof(buffer)) == 0);
+	CHECK(format_shortest_float(std::strtof("nan", nullptr), buffer, sizeof(buffer)) == 0);
+	CHECK(format_shortest_float(1.5F, buffer, 3) == 0);
+}
@@ -0,0 +1,122 @@
+////////////////////////////////////////////////////////////////////////////////
+// The MIT License (MIT)
+//
+// Copyright (c) 2022 Nicholas Frechette
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+////////////////////////////////////////////////////////////////////////////////
+
+#include "test_framework.h"
+
+#include <acl-sjson/track.h>
+
+#include <cstring>
+
+using namespace acl_sjson;
+
+namespace
+{
+	static sample make_sample(float value)
+	{
+		sample sample_;
+		std::memset(&sample_, 0, sizeof(sample_));
+		sample_.f1.x = value;
+		return sample_;
+	}
+
+	static track make_constant_track(size_t num_samples)
+	{
+		track track_(sample_type::float1, 30.0F, "value");
+		for (size_t sample_index = 0; sample_index < num_samples; ++sample_index)
+			track_.emplace_back(make_sample(1.0F));
+
+		return track_;
+	}
+}
+
+TEST_CASE(track_reads_keep_collapsed_tracks)
+{
+	track track_ = make_constant_track(10);
+	CHECK(track_.is_collapsed());
+
+	// Reads through a const track do not expand it
+	const track& const_track = track_;
+	float sum = 0.0F;
+	for (size_t sample_index = 0; sample_index < const_track.get_num_samples(); ++sample_index)
+		sum += const_track[sample_index].f1.x;
+
+	CHECK(sum == 10.0F);
+	CHECK(track_.is_collapsed());
+}
+
+TEST_CASE(track_subscript_writes_in_place)
+{
+	track track_ = make_constant_track(10);
+
+	// The non-const subscript returns a reference, the track is expanded first
+	track_[4] = make_sample(2.0F);
+	track_[6].f1.x = 3.0F;
+	CHECK(!track_.is_collapsed());
+	CHECK(track_.get_num_samples() == 10);
+
+	const track& const_track = track_;
+	CHECK(const_track[3].f1.x == 1.0F);
+	CHECK(const_track[4].f1.x == 2.0F);
+	CHECK(const_track[6].f1.x == 3.0F);
+}
+
+TEST_CASE(track_writes_expand_on_change)
+{
+	track track_ = make_constant_track(10);
+
+	// Writing the repeating sample leaves the track collapsed
+	track_.set_sample(4, make_sample(1.0F));
+	CHECK(track_.is_collapsed());
+
+	track_.set_sample(4, make_sample(2.0F));
+	CHECK(!track_.is_collapsed());
+	CHECK(track_.get_num_samples() == 10);
+	CHECK(track_[3].f1.x == 1.0F);
+	CHECK(track_[4].f1.x == 2.0F);
+	CHECK(track_[5].f1.x == 1.0F);
+
+	track_.set_sample(4, make_sample(1.0F));
+	CHECK(track_.collapse());
+}
+
+TEST_CASE(track_constant_sample_replaced_in_place)
+{
+	track track_ = make_constant_track(10);
+
+	track_.set_constant_sample(make_sample(3.0F));
+	CHECK(track_.is_collapsed());
+	CHECK(track_.get_num_samples() == 10);
+
+	const track& const_track = track_;
+	CHECK(const_track[9].f1.x == 3.0F);
+
+	// Expanded tracks are collapsed
+	track_.set_sample(4, make_sample(2.0F));
+	CHECK(!track_.is_collapsed());
+
+	track_.set_constant_sample(make_sample(5.0F));
+	CHECK(track_.is_collapsed());
+	CHECK(track_.get_num_samples() == 10);
+	CHECK(const_track[4].f1.x == 5.0F);
+}
@@ -0,0 +1,134 @@
+////////////////////////////////////////////////////////////////////////////////
+// The MIT License (MIT)
+//
+// Copyright (c) 2022 Nicholas Frechette
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+////////////////////////////////////////////////////////////////////////////////
+
+#include "test_framework.h"
+
+#include <acl-sjson/metadata.h>
+#include <acl-sjson/track.h>
+#include <acl-sjson/track_array.h>
+#include <acl-sjson/track_description.h>
+
+#include <atomic>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace acl_sjson;
+
+namespace
+{
+	static track make_track(const std::string& name)
+	{
+		track track_(sample_type::float1, 30.0F, name.c_str());
+		std::memset(&track_.get_description(), 0, sizeof(track_description));
+		return track_;
+	}
+
+	static track_array make_array(uint32_t num_tracks)
+	{
+		metadata_t metadata;
+		track_array tracks("clip", metadata);
+		for (uint32_t track_index = 0; track_index < num_tracks; ++track_index)
+			tracks.emplace_back(make_track("bone" + std::to_string(track_index)));
+
+		return tracks;
+	}
+}
+
+TEST_CASE(track_array_find)
+{
+	track_array tracks = make_array(4);
+
+	// Names are matched by value, not by address
+	const std::string name = "bone2";
+	CHECK(tracks.find(name.c_str()) == 2);
+	CHECK(tracks.find("bone0") == 0);
+	CHECK(tracks.find("bone3") == 3);
+
+	// Missing names
+	CHECK(tracks.find("bone4") == k_invalid_track_index);
+	CHECK(tracks.find("") == k_invalid_track_index);
+	CHECK(tracks.find("Bone1") == k_invalid_track_index);
+
+	// Adding a track invalidates the index that was built on first use
+	tracks.emplace_back(make_track("bone4"));
+	CHECK(tracks.find("bone4") == 4);
+	CHECK(tracks.find("bone2") == 2);
+
+	// When names are duplicated, the first track wins
+	tracks.emplace_back(make_track("bone1"));
+	CHECK(tracks.find("bone1") == 1);
+
+	// Clearing the array empties the index
+	tracks.clear();
+	CHECK(tracks.find("bone0") == k_invalid_track_index);
+
+	const track_array empty_tracks;
+	CHECK(empty_tracks.find("bone0") == k_invalid_track_index);
+}
+
+TEST_CASE(track_array_find_after_move)
+{
+	track_array tracks = make_array(4);
+	CHECK(tracks.find("bone1") == 1);
+
+	track_array moved_tracks(std::move(tracks));
+	CHECK(moved_tracks.find("bone1") == 1);
+	CHECK(tracks.find("bone1") == k_invalid_track_index);
+
+	// The index of the previous content is not retained
+	track_array other_tracks = make_array(2);
+	CHECK(other_tracks.find("bone3") == k_invalid_track_index);
+
+	other_tracks = std::move(moved_tracks);
+	CHECK(other_tracks.find("bone3") == 3);
+}
+
+TEST_CASE(track_array_find_concurrently)
+{
+	const track_array tracks = make_array(256);
+
+	// Every thread races to build the index on first use
+	std::atomic<uint32_t> num_mismatches(0);
+	std::vector<std::thread> threads;
+	for (uint32_t thread_index = 0; thread_index < 4; ++thread_index)
+	{
+		threads.emplace_back([&tracks, &num_mismatches, thread_index]()
+			{
+				const uint32_t num_tracks = static_cast<uint32_t>(tracks.get_num_tracks());
+				for (uint32_t iteration = 0; iteration < num_tracks; ++iteration)
+				{
+					const uint32_t track_index = (iteration + (thread_index * 64)) % num_tracks;
+					if (tracks.find(("bone" + std::to_string(track_index)).c_str()) != track_index)
+						++num_mismatches;
+				}
+			});
+	}
+
+	for (std::thread& thread : threads)
+		thread.join();
+
+	CHECK(num_mismatches == 0);
+}
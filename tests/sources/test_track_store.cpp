@@ -0,0 +1,212 @@
+////////////////////////////////////////////////////////////////////////////////
+// The MIT License (MIT)
+//
+// Copyright (c) 2022 Nicholas Frechette
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+////////////////////////////////////////////////////////////////////////////////
+
+#include "test_framework.h"
+
+#include <acl-sjson/hash.h>
+#include <acl-sjson/metadata.h>
+#include <acl-sjson/track.h>
+#include <acl-sjson/track_array.h>
+#include <acl-sjson/track_description.h>
+#include <acl-sjson/track_store.h>
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+using namespace acl_sjson;
+
+namespace
+{
+	// A constant root and an animated child, the root is shared between clips
+	static track_array make_clip(const char* name, float child_offset)
+	{
+		metadata_t metadata;
+		track_array tracks(name, metadata);
+
+		for (uint32_t track_index = 0; track_index < 2; ++track_index)
+		{
+			track track_(sample_type::qvv, 30.0F, track_index == 0 ? "root" : "child");
+
+			track_description& desc = track_.get_description();
+			std::memset(&desc, 0, sizeof(desc));
+			desc.transform.output_index = track_index;
+			desc.transform.parent_index = track_index == 0 ? k_invalid_track_index : 0;
+			desc.transform.precision = 0.01F;
+
+			for (size_t sample_index = 0; sample_index < 8; ++sample_index)
+			{
+				sample sample_;
+				std::memset(&sample_, 0, sizeof(sample_));
+				sample_.transform.rotation.w = 1.0F;
+				sample_.transform.translation.x = track_index == 0 ? 1.0F : float(sample_index) + child_offset;
+				sample_.transform.scale = vector4{ 1.0F, 1.0F, 1.0F, 0.0F };
+				track_.emplace_back(std::move(sample_));
+			}
+
+			tracks.emplace_back(std::move(track_));
+		}
+
+		return tracks;
+	}
+
+	static std::vector<char> read_bytes(const char* filename)
+	{
+		std::ifstream file_stream(filename, std::ios_base::in | std::ios_base::binary);
+		return std::vector<char>(std::istreambuf_iterator<char>(file_stream), std::istreambuf_iterator<char>());
+	}
+
+	static void write_bytes(const char* filename, const std::vector<char>& bytes)
+	{
+		std::ofstream file_stream(filename, std::ios_base::out | std::ios_base::binary | std::ios_base::trunc);
+		file_stream.write(bytes.data(), bytes.size());
+	}
+}
+
+TEST_CASE(track_store_round_trip)
+{
+	const char* filename = "track_store_round_trip.aclp";
+
+	{
+		track_store store;
+		store.add_clip("a.acl.sjson", make_clip("a", 0.0F));
+		store.add_clip("b.acl.sjson", make_clip("b", 0.5F));
+
+		CHECK(store.get_num_unique_tracks() == 3);
+		CHECK(store.get_num_track_references() == 4);
+		CHECK(store.write(filename));
+	}
+
+	track_store store;
+	CHECK(store.read(filename));
+	CHECK(store.get_num_clips() == 2);
+	CHECK(store.get_num_unique_tracks() == 3);
+
+	for (size_t clip_index = 0; clip_index < store.get_num_clips(); ++clip_index)
+	{
+		const track_array reference = make_clip(clip_index == 0 ? "a" : "b", clip_index == 0 ? 0.0F : 0.5F);
+
+		track_array tracks;
+		CHECK(store.make_clip(clip_index, tracks));
+		CHECK(std::strcmp(store.get_clip_name(clip_index), clip_index == 0 ? "a.acl.sjson" : "b.acl.sjson") == 0);
+		CHECK(std::strcmp(tracks.get_name(), reference.get_name()) == 0);
+		CHECK(tracks.get_num_tracks() == 2);
+		CHECK(hash_tracks(tracks) == hash_tracks(reference));
+		CHECK(tracks.find("child") == 1);
+	}
+
+	std::remove(filename);
+}
+
+TEST_CASE(track_store_rejects_truncated_files)
+{
+	const char* filename = "track_store_truncated.aclp";
+	const char* truncated_filename = "track_store_truncated_copy.aclp";
+
+	{
+		track_store store;
+		store.add_clip("a.acl.sjson", make_clip("a", 0.0F));
+		CHECK(store.write(filename));
+	}
+
+	const std::vector<char> bytes = read_bytes(filename);
+	CHECK(!bytes.empty());
+
+	// Every prefix of the file is missing data, none of them must be accepted
+	for (size_t size = 0; size < bytes.size(); ++size)
+	{
+		write_bytes(truncated_filename, std::vector<char>(bytes.begin(), bytes.begin() + size));
+
+		track_store store;
+		CHECK(!store.read(truncated_filename));
+		CHECK(store.get_num_clips() == 0);
+	}
+
+	std::remove(truncated_filename);
+	std::remove(filename);
+}
+
+TEST_CASE(track_store_rejects_corrupt_counts)
+{
+	const char* filename = "track_store_corrupt.aclp";
+	const char* corrupt_filename = "track_store_corrupt_copy.aclp";
+
+	{
+		track_store store;
+		store.add_clip("a.acl.sjson", make_clip("a", 0.0F));
+		CHECK(store.write(filename));
+	}
+
+	const std::vector<char> bytes = read_bytes(filename);
+	CHECK(bytes.size() > 28);
+
+	// Tag and version are followed by the number of entries, then the first entry type and its data size
+	const size_t num_entries_offset = 8;
+	const size_t type_offset = 12;
+	const size_t data_size_offset = 24;
+	const uint32_t huge_count = 0xFFFFFFF0U;
+
+	const size_t offsets[] = { num_entries_offset, data_size_offset };
+	for (size_t offset : offsets)
+	{
+		std::vector<char> corrupt_bytes = bytes;
+		std::memcpy(corrupt_bytes.data() + offset, &huge_count, sizeof(huge_count));
+		write_bytes(corrupt_filename, corrupt_bytes);
+
+		track_store store;
+		CHECK(!store.read(corrupt_filename));
+	}
+
+	{
+		std::vector<char> corrupt_bytes = bytes;
+		const uint32_t invalid_type = 42;
+		std::memcpy(corrupt_bytes.data() + type_offset, &invalid_type, sizeof(invalid_type));
+		write_bytes(corrupt_filename, corrupt_bytes);
+
+		track_store store;
+		CHECK(!store.read(corrupt_filename));
+	}
+
+	// The clip ends with its number of tracks followed by the 'root' and 'child' references
+	{
+		const size_t num_tracks_offset = bytes.size() - (4 + 4 + 4) - (4 + 5 + 4) - 4;
+
+		uint32_t num_tracks = 0;
+		std::memcpy(&num_tracks, bytes.data() + num_tracks_offset, sizeof(num_tracks));
+		CHECK(num_tracks == 2);
+
+		std::vector<char> corrupt_bytes = bytes;
+		std::memcpy(corrupt_bytes.data() + num_tracks_offset, &huge_count, sizeof(huge_count));
+		write_bytes(corrupt_filename, corrupt_bytes);
+
+		track_store store;
+		CHECK(!store.read(corrupt_filename));
+	}
+
+	std::remove(corrupt_filename);
+	std::remove(filename);
+}
@@ -0,0 +1,296 @@
+////////////////////////////////////////////////////////////////////////////////
+// The MIT License (MIT)
+//
+// Copyright (c) 2022 Nicholas Frechette
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+////////////////////////////////////////////////////////////////////////////////
+
+#include "test_framework.h"
+
+#include <acl-sjson/metadata.h>
+#include <acl-sjson/track.h>
+#include <acl-sjson/track_array.h>
+#include <acl-sjson/track_description.h>
+#include <acl-sjson/validation.h>
+
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+using namespace acl_sjson;
+
+namespace
+{
+	// Spans more than one classification block and is not a multiple of 4
+	static constexpr size_t k_num_samples = 70;
+
+	static sample make_identity()
+	{
+		sample sample_;
+		std::memset(&sample_, 0, sizeof(sample_));
+		sample_.transform.rotation = quat{ 0.0F, 0.0F, 0.0F, 1.0F };
+		sample_.transform.scale = vector4{ 1.0F, 1.0F, 1.0F, 0.0F };
+		return sample_;
+	}
+
+	// Every sample is valid and distinct, the track is not collapsed
+	static track make_track(sample_type type, uint32_t track_index)
+	{
+		track track_(type, 30.0F, "track");
+
+		track_description& desc = track_.get_description();
+		std::memset(&desc, 0, sizeof(desc));
+		if (is_transform(type))
+			desc.transform.parent_index = k_invalid_track_index;
+		track_.set_output_index(track_index);
+
+		for (size_t sample_index = 0; sample_index < k_num_samples; ++sample_index)
+		{
+			sample sample_ = make_identity();
+			if (type == sample_type::qvv)
+				sample_.transform.translation.x = float(sample_index);
+			else
+				sample_.f3 = float3{ float(sample_index), 1.0F, -1.0F };
+
+			track_.emplace_back(std::move(sample_));
+		}
+
+		return track_;
+	}
+
+	static track_array make_array(sample_type type, uint32_t num_tracks)
+	{
+		metadata_t metadata;
+		track_array tracks("clip", metadata);
+		for (uint32_t track_index = 0; track_index < num_tracks; ++track_index)
+			tracks.emplace_back(make_track(type, track_index));
+
+		return tracks;
+	}
+
+	static float* get_values(track& track_, size_t sample_index)
+	{
+		return &track_[sample_index].f1.x;
+	}
+
+	static const validation_issue* find_issue(const clip_validation& validation, validation_issue_type type, uint32_t track_index)
+	{
+		for (const validation_issue& issue : validation.issues)
+		{
+			if (issue.type == type && issue.track_index == track_index)
+				return &issue;
+		}
+
+		return nullptr;
+	}
+}
+
+TEST_CASE(validation_accepts_valid_tracks)
+{
+	clip_validation validation;
+	validate_tracks(make_array(sample_type::qvv, 3), validation_settings(), validation);
+	CHECK(validation.issues.empty());
+	CHECK(!validation.has_errors() && validation.num_warnings == 0);
+
+	validate_tracks(make_array(sample_type::float3, 3), validation_settings(), validation);
+	CHECK(validation.issues.empty());
+}
+
+TEST_CASE(validation_reports_invalid_values)
+{
+	track_array tracks = make_array(sample_type::float3, 2);
+
+	// Only the first offending sample is retained, the others are counted
+	get_values(tracks[1], 3)[1] = std::numeric_limits<float>::quiet_NaN();
+	get_values(tracks[1], 66)[2] = -std::numeric_limits<float>::infinity();
+	get_values(tracks[1], 5)[0] = 1.0e-40F;
+	get_values(tracks[1], 7)[2] = 1.0e20F;
+	get_values(tracks[1], 8)[0] = -3.0e38F;
+
+	// The padding of a float3 is never validated
+	get_values(tracks[0], 2)[3] = std::numeric_limits<float>::quiet_NaN();
+	get_values(tracks[0], 4)[3] = 1.0e-40F;
+
+	clip_validation validation;
+	validate_tracks(tracks, validation_settings(), validation);
+	CHECK(validation.issues.size() == 3);
+	CHECK(validation.num_errors == 1 && validation.num_warnings == 2);
+	CHECK(find_issue(validation, validation_issue_type::non_finite_value, 0) == nullptr);
+
+	const validation_issue* non_finite = find_issue(validation, validation_issue_type::non_finite_value, 1);
+	CHECK(non_finite != nullptr && non_finite->sample_index == 3 && non_finite->component_index == 1 && non_finite->num_samples == 2 && std::isnan(non_finite->value));
+
+	const validation_issue* denormal = find_issue(validation, validation_issue_type::denormal_value, 1);
+	CHECK(denormal != nullptr && denormal->sample_index == 5 && denormal->component_index == 0 && denormal->num_samples == 1 && denormal->value == 1.0e-40F);
+
+	const validation_issue* overflowing = find_issue(validation, validation_issue_type::overflowing_value, 1);
+	CHECK(overflowing != nullptr && overflowing->sample_index == 7 && overflowing->component_index == 2 && overflowing->num_samples == 2 && overflowing->value == 1.0e20F);
+
+	// Sorted by track index and issue type
+	CHECK(validation.issues[0].type == validation_issue_type::non_finite_value);
+	CHECK(validation.issues[1].type == validation_issue_type::denormal_value);
+	CHECK(validation.issues[2].type == validation_issue_type::overflowing_value);
+	CHECK(get_severity(validation_issue_type::non_finite_value) == validation_severity::error);
+	CHECK(get_severity(validation_issue_type::overflowing_value) == validation_severity::warning);
+}
+
+TEST_CASE(validation_reports_invalid_transforms)
+{
+	track_array tracks = make_array(sample_type::qvv, 1);
+	track& track_ = tracks[0];
+
+	// Within the tolerance, the length is rounding noise
+	track_[1].transform.rotation.w = 1.000001F;
+	track_[2].transform.rotation.w = 2.0F;
+	track_[65].transform.rotation = quat{ 0.0F, 0.0F, 0.0F, 0.0F };
+
+	track_[3].transform.scale.y = 0.0F;
+	track_[4].transform.scale.z = -0.0F;
+	track_[6].transform.scale.z = -2.0F;
+
+	// The padding of the translation and scale is never validated
+	track_[9].transform.translation.w = std::numeric_limits<float>::quiet_NaN();
+	track_[9].transform.scale.w = -1.0F;
+
+	clip_validation validation;
+	validate_tracks(tracks, validation_settings(), validation);
+	CHECK(validation.issues.size() == 3);
+	CHECK(validation.num_errors == 1 && validation.num_warnings == 2);
+
+	const validation_issue* rotation = find_issue(validation, validation_issue_type::non_normalized_rotation, 0);
+	CHECK(rotation != nullptr && rotation->sample_index == 2 && rotation->num_samples == 2 && rotation->value == 4.0F);
+
+	// A negative zero is a zero scale, not a negative one
+	const validation_issue* zero_scale = find_issue(validation, validation_issue_type::zero_scale, 0);
+	CHECK(zero_scale != nullptr && zero_scale->sample_index == 3 && zero_scale->component_index == 9 && zero_scale->num_samples == 2);
+	CHECK(std::strcmp(get_component_name(sample_type::qvv, zero_scale->component_index), "scale.y") == 0);
+
+	const validation_issue* negative_scale = find_issue(validation, validation_issue_type::negative_scale, 0);
+	CHECK(negative_scale != nullptr && negative_scale->sample_index == 6 && negative_scale->component_index == 10 && negative_scale->num_samples == 1 && negative_scale->value == -2.0F);
+
+	// A non-finite rotation is only reported once
+	track_[1].transform.rotation.x = std::numeric_limits<float>::infinity();
+	validate_tracks(tracks, validation_settings(), validation);
+	CHECK(find_issue(validation, validation_issue_type::non_finite_value, 0)->sample_index == 1);
+	CHECK(find_issue(validation, validation_issue_type::non_normalized_rotation, 0)->num_samples == 2);
+}
+
+TEST_CASE(validation_reports_invalid_descriptions)
+{
+	track_array tracks = make_array(sample_type::qvv, 6);
+
+	// 1 -> 2 -> 3 -> 1 is a cycle, 4 is below it and is not reported
+	tracks[1].get_description().transform.parent_index = 2;
+	tracks[2].get_description().transform.parent_index = 3;
+	tracks[3].get_description().transform.parent_index = 1;
+	tracks[4].get_description().transform.parent_index = 3;
+	tracks[5].get_description().transform.parent_index = 5;
+	tracks[0].get_description().transform.parent_index = 6;
+
+	clip_validation validation;
+	validate_tracks(tracks, validation_settings(), validation);
+	CHECK(validation.num_errors == 5);
+	CHECK(find_issue(validation, validation_issue_type::invalid_parent_index, 0)->index == 6);
+	CHECK(find_issue(validation, validation_issue_type::invalid_parent_index, 5)->index == 5);
+	CHECK(find_issue(validation, validation_issue_type::parent_cycle, 1)->index == 2);
+	CHECK(find_issue(validation, validation_issue_type::parent_cycle, 2) != nullptr);
+	CHECK(find_issue(validation, validation_issue_type::parent_cycle, 3) != nullptr);
+	CHECK(find_issue(validation, validation_issue_type::parent_cycle, 4) == nullptr);
+
+	// With a stripped track, output indices must be within [0, 5)
+	track_array output_tracks = make_array(sample_type::float3, 6);
+	output_tracks[0].set_output_index(k_invalid_track_index);
+	output_tracks[1].set_output_index(5);
+	output_tracks[3].set_output_index(2);
+	output_tracks[5].set_output_index(1);
+
+	validate_tracks(output_tracks, validation_settings(), validation);
+	CHECK(validation.num_errors == 2);
+	CHECK(find_issue(validation, validation_issue_type::invalid_output_index, 1)->index == 5);
+	CHECK(find_issue(validation, validation_issue_type::duplicate_output_index, 3)->index == 2);
+	CHECK(find_issue(validation, validation_issue_type::duplicate_output_index, 2) == nullptr);
+}
+
+TEST_CASE(validation_counts_collapsed_samples)
+{
+	// A collapsed track validates its single sample but every sample has the issue
+	metadata_t metadata;
+	track_array tracks("clip", metadata);
+
+	track track_(sample_type::float3, 30.0F, "constant");
+	std::memset(&track_.get_description(), 0, sizeof(track_description));
+	sample sample_;
+	std::memset(&sample_, 0, sizeof(sample_));
+	sample_.f3 = float3{ 1.0F, std::numeric_limits<float>::infinity(), 1.0e-40F };
+	for (size_t sample_index = 0; sample_index < k_num_samples; ++sample_index)
+		track_.emplace_back(sample(sample_));
+
+	CHECK(track_.is_collapsed());
+	tracks.emplace_back(std::move(track_));
+
+	clip_validation validation;
+	validate_tracks(tracks, validation_settings(), validation);
+	CHECK(validation.issues.size() == 2);
+
+	const validation_issue* non_finite = find_issue(validation, validation_issue_type::non_finite_value, 0);
+	CHECK(non_finite != nullptr && non_finite->sample_index == 0 && non_finite->component_index == 1 && non_finite->num_samples == k_num_samples);
+
+	const validation_issue* denormal = find_issue(validation, validation_issue_type::denormal_value, 0);
+	CHECK(denormal != nullptr && denormal->sample_index == 0 && denormal->component_index == 2 && denormal->num_samples == k_num_samples);
+	CHECK(tracks[0].is_collapsed());
+}
+
+TEST_CASE(validation_stops_on_first_error)
+{
+	validation_settings settings;
+	settings.stop_on_first_error = true;
+
+	// Several tracks have errors, only one is retained
+	track_array tracks = make_array(sample_type::float3, 8);
+	for (uint32_t track_index = 0; track_index < 8; ++track_index)
+	{
+		get_values(tracks[track_index], 10)[0] = std::numeric_limits<float>::quiet_NaN();
+		get_values(tracks[track_index], 20)[0] = std::numeric_limits<float>::quiet_NaN();
+	}
+
+	clip_validation validation;
+	validate_tracks(tracks, settings, validation);
+	CHECK(validation.has_errors());
+	CHECK(validation.num_errors == 1);
+	CHECK(get_severity(validation.issues.back().type) == validation_severity::error);
+
+	// Invalid descriptions are found before any sample is validated
+	tracks[5].set_output_index(1);
+
+	validate_tracks(tracks, settings, validation);
+	CHECK(validation.num_errors == 1);
+	CHECK(validation.issues.size() == 1);
+	CHECK(validation.issues[0].type == validation_issue_type::duplicate_output_index);
+	CHECK(validation.issues[0].track_index == 5);
+
+	// Without errors, every warning is reported
+	track_array warning_tracks = make_array(sample_type::float3, 4);
+	for (uint32_t track_index = 0; track_index < 4; ++track_index)
+		get_values(warning_tracks[track_index], 1)[1] = 1.0e-40F;
+
+	validate_tracks(warning_tracks, settings, validation);
+	CHECK(!validation.has_errors());
+	CHECK(validation.num_warnings == 4);
+}